@@ -0,0 +1,23 @@
+/* /root/repo/build/x86_64-pc-linux-gnu/config.h.  Generated from config.h.in by configure.  */
+/* autoconf/config.h.in.  Generated from configure.ac by autoheader.  */
+
+/* Define to the address where bug reports for this package should be sent. */
+#define PACKAGE_BUGREPORT "oehrstroem@gmail.com"
+
+/* Define to the full name of this package. */
+#define PACKAGE_NAME "LIBXMQ"
+
+/* Define to the full name and version of this package. */
+#define PACKAGE_STRING "LIBXMQ libxmq"
+
+/* Define to the one symbol short name of this package. */
+#define PACKAGE_TARNAME "libxmq"
+
+/* Define to the home page for this package. */
+#define PACKAGE_URL "https://libxmq.org"
+
+/* Define to the version of this package. */
+#define PACKAGE_VERSION "libxmq"
+
+/* Define to 1 if the 'S_IS*' macros in <sys/stat.h> do not work properly. */
+/* #undef STAT_MACROS_BROKEN */
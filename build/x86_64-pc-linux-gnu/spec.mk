@@ -0,0 +1,68 @@
+X:=
+SPACE:=$(X) $(X)
+COMMA:=,
+HASH:=\#
+SQUOTE:='
+#'
+DQUOTE:="
+#"
+define NEWLINE
+
+
+endef
+
+CONF_NAME:=x86_64-pc-linux-gnu
+CONF_MNEMONIC:=linux64
+PLATFORM:=POSIX
+PLATFORM_CFLAGS:=-DUSE_SYSLOG
+
+PATH_SEP:=:
+
+SRC_ROOT:=/root/repo
+BUILD_ROOT:=/root/repo/build
+OUTPUT_ROOT:=/root/repo/build/x86_64-pc-linux-gnu
+PREFIX:=/usr/local
+
+ENABLE_STATIC_XMQ:=no
+
+ENABLE_ASAN:=yes
+ASAN_CFLAGS:=-O0 -ggdb -fsanitize=address,undefined -fno-omit-frame-pointer
+ASAN_LIBS:=-lgcov --coverage
+
+ZLIB_CFLAGS:=
+ZLIB_LIBS:=-lz 
+
+LIBXML2_CFLAGS:=-I/usr/include/libxml2 
+LIBXML2_LIBS:=-lxml2 
+LIBXML2_LIBNAME:=
+
+LIBXSLT_CFLAGS:=-I/usr/include/libxml2 
+LIBXSLT_LIBS:=-lxslt -lxml2 
+
+BCRYPT_DLL:=
+
+CC:=gcc
+CFLAGS_release:=-O3
+CFLAGS_debug:=-O0 -g
+CFLAGS_asan:=-O0 -g -O0 -ggdb -fsanitize=address,undefined -fno-omit-frame-pointer
+CFLAGS:=-DPLATFORM_POSIX  -DLINUX64  -Wall -Wunused-variable -Wextra -Wno-clobbered -Wno-unused-parameter -Wno-attributes -Wparentheses -Wmissing-declarations -Werror=implicit-function-declaration -Wredundant-decls -Wimplicit -Wno-unused-variable -Wno-error=deprecated-declarations -fmessage-length=0 -Wno-unused-function -Wreturn-type $(ZLIB_CFLAGS) $(LIBXML2_CFLAGS) $(LIBXSLT_CFLAGS) $(LIBYAEP_CFLAGS) $(PLATFORM_CFLAGS)
+
+CXX:=/usr/bin/g++
+CXXFLAGS_release:=-O3
+CXXFLAGS_debug:=-O0 -g
+CXXFLAGS_asan:=@CXXFLAGS_asan@
+CXXFLAGS:=-DPLATFORM_POSIX  -DLINUX64 -Wall -Wunused-variable -Wextra -Wno-clobbered -Wno-unused-parameter -Wno-attributes -Wparentheses -Wmissing-declarations -Werror=implicit-function-declaration -Wredundant-decls -Wimplicit -Wno-unused-variable -Wno-error=deprecated-declarations -fmessage-length=0 -std=c++11 -Wno-maybe-uninitialized -Wno-unused-function -Wreturn-type $(ZLIB_CFLAGS) $(LIBXML2_CFLAGS) $(LIBXSLT_CFLAGS) $(LIBYAEP_CFLAGS) $(PLATFORM_CFLAGS)
+
+LD:=/usr/bin/ld
+LDFLAGS_release:=-O3
+LDFLAGSBEGIN_release:=
+LDFLAGSEND_release:=
+LDFLAGS_debug:=-g 
+LDFLAGSBEGIN_debug:=
+LDFLAGSEND_debug:=
+LDFLAGS_asan:=-g -fsanitize=address,undefined -static-libasan 
+LDFLAGSBEGIN_asan:=-lgcov --coverage 
+LDFLAGSEND_asan:=
+LDFLAGS:=
+
+STRIP:=/usr/bin/strip
@@ -12,7 +12,7 @@ _xmq()
 
     opts="--clines --empty --html --htmq --ixml= --json --text --xml --xmq -z
           --debug --lines --log-xmq --no-merge --trace --trim= --verbose
-          --ixml-all-parses --ixml-try-to-recover
+          --ixml-all-parses --ixml-try-to-recover --compile-ixml=
           delete load no-output replace save-to statistics
           to-clines to-html to-json to-xml
           transform page browse
@@ -0,0 +1,143 @@
+#!/bin/sh
+# libxmq - Copyright 2026 Fredrik Öhrström (spdx: MIT)
+
+# Generate the two level unicode category tables from the category arrays in text.c
+# and replace the generated tables inside text.c. Run this after changing the arrays
+# or the UNICODE_CATEGORIES list.
+
+TEXT_C=$1
+
+if [ -z "$TEXT_C" ]
+then
+    echo "Usage: generate_unicode_category_tables.sh src/main/c/parts/text.c"
+    exit 1
+fi
+
+BEGIN="// GENERATED UNICODE CATEGORY TABLES BEGIN"
+END="// GENERATED UNICODE CATEGORY TABLES END"
+
+if ! grep -qF "$BEGIN" "$TEXT_C" || ! grep -qF "$END" "$TEXT_C"
+then
+    echo "Could not find the generated tables markers in $TEXT_C"
+    exit 1
+fi
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+# The category list, the enum, the page size defines and the arrays are found
+# between the COMMA define and the generated tables.
+awk -v begin="$BEGIN" '/^#define COMMA ,/ { found = 1 } $0 == begin { exit } found { print }' "$TEXT_C" > "$DIR/categories.c"
+
+cat <<EOF > "$DIR/generate.c"
+#include<stdbool.h>
+#include<stdint.h>
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+
+#include"categories.c"
+
+#define MAX_SETS 256
+
+int main()
+{
+    // Spread the code point arrays into a flat table of category masks first.
+    // A code point can be listed in more than one category array.
+    uint64_t *flat = (uint64_t*)calloc(0x110000, sizeof(uint64_t));
+#define X(cat,name,strings,explanation) \\
+    for (size_t i = 0; i < unicode_len_##cat; ++i) \\
+    { \\
+        if (unicode_##cat[i] >= 0 && unicode_##cat[i] <= 0x10ffff) flat[unicode_##cat[i]] |= ((uint64_t)1) << UNICODE_CATEGORY_##cat; \\
+    }
+UNICODE_CATEGORIES
+#undef X
+
+    // Then store each page that has any categories, with each mask replaced by its set number.
+    // Identical consecutive pages are stored once.
+    uint64_t sets[MAX_SETS];
+    size_t num_sets = 1;
+    sets[0] = 0;
+    uint16_t page_index[UNICODE_CATEGORY_NUM_PAGE_INDEXES];
+    uint8_t *pages = (uint8_t*)calloc(UNICODE_CATEGORY_NUM_PAGE_INDEXES+1, UNICODE_CATEGORY_PAGE_SIZE);
+    size_t num_pages = 1;
+    uint8_t page[UNICODE_CATEGORY_PAGE_SIZE];
+
+    for (size_t p = 0; p < UNICODE_CATEGORY_NUM_PAGE_INDEXES; ++p)
+    {
+        uint64_t *masks = flat + (p << UNICODE_CATEGORY_PAGE_BITS);
+        bool empty = true;
+        for (size_t j = 0; j < UNICODE_CATEGORY_PAGE_SIZE; ++j)
+        {
+            size_t set = 0;
+            while (set < num_sets && sets[set] != masks[j]) set++;
+            if (set == num_sets)
+            {
+                if (num_sets == MAX_SETS)
+                {
+                    fprintf(stderr, "Too many category sets.\n");
+                    return 1;
+                }
+                sets[num_sets++] = masks[j];
+            }
+            page[j] = (uint8_t)set;
+            if (set) empty = false;
+        }
+        if (empty)
+        {
+            page_index[p] = 0;
+            continue;
+        }
+        uint8_t *prev = pages + ((num_pages-1) << UNICODE_CATEGORY_PAGE_BITS);
+        if (num_pages > 1 && !memcmp(prev, page, UNICODE_CATEGORY_PAGE_SIZE))
+        {
+            page_index[p] = (uint16_t)(num_pages-1);
+            continue;
+        }
+        memcpy(pages + (num_pages << UNICODE_CATEGORY_PAGE_BITS), page, UNICODE_CATEGORY_PAGE_SIZE);
+        page_index[p] = (uint16_t)num_pages;
+        num_pages++;
+    }
+
+    printf("const uint16_t unicode_category_page_index_[UNICODE_CATEGORY_NUM_PAGE_INDEXES] = {\n");
+    for (size_t p = 0; p < UNICODE_CATEGORY_NUM_PAGE_INDEXES; ++p)
+    {
+        printf("%s%u,", (p % 32) ? "" : (p ? "\n" : ""), page_index[p]);
+    }
+    printf("\n};\n\n");
+
+    printf("const uint8_t unicode_category_pages_[%zu] = {\n", num_pages << UNICODE_CATEGORY_PAGE_BITS);
+    for (size_t i = 0; i < (num_pages << UNICODE_CATEGORY_PAGE_BITS); ++i)
+    {
+        printf("%s%u,", (i % 32) ? "" : (i ? "\n" : ""), pages[i]);
+    }
+    printf("\n};\n\n");
+
+    printf("const uint64_t unicode_category_sets_[%zu] = {\n", num_sets);
+    for (size_t i = 0; i < num_sets; ++i)
+    {
+        printf("0x%016llxULL,\n", (unsigned long long)sets[i]);
+    }
+    printf("};\n");
+
+    free(pages);
+    free(flat);
+    return 0;
+}
+EOF
+
+if ! cc -o "$DIR/generate" "$DIR/generate.c"
+then
+    echo "Could not compile the unicode category table generator."
+    exit 1
+fi
+
+"$DIR/generate" > "$DIR/tables.c" || exit 1
+
+# Replace the lines between the markers with the generated tables.
+awk -v begin="$BEGIN" -v end="$END" -v tables="$DIR/tables.c" '
+    $0 == begin { print; while ((getline line < tables) > 0) print line; skip = 1; next }
+    $0 == end { skip = 0 }
+    !skip { print }' "$TEXT_C" > "$DIR/text.c" && cp "$DIR/text.c" "$TEXT_C"
+
+echo "Generated unicode category tables in $TEXT_C"
@@ -50,7 +50,6 @@ struct HashMapIterator
 
 // FUNCTION DECLARATIONS //////////////////////////////////////////////////
 
-size_t hash_code(const char *str);
 HashMapNode* hashmap_create_node(const char *key);
 
 ///////////////////////////////////////////////////////////////////////////
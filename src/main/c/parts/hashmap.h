@@ -49,6 +49,8 @@ void hashmap_free_and_values(HashMap *map, FreeFuncPtr freefunc);
 HashMapIterator *hashmap_iterate(HashMap *map);
 bool hashmap_next_key_value(HashMapIterator *i, const char **key, void **val);
 void hashmap_free_iterator(HashMapIterator *i);
+// The string hash used by the hashmap.
+size_t hash_code(const char *str);
 
 #define HASHMAP_MODULE
 
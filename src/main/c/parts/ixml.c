@@ -96,7 +96,6 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 void add_insertion_rule(XMQParseState *state, const char *content);
 void add_not_rule_string(XMQParseState *state, const char *content);
 void add_not_rule_charset(XMQParseState *state, IXMLNonTerminal *nt);
-void add_single_char_rule(XMQParseState *state, IXMLNonTerminal *nt, int uc, char mark, char tmark);
 
 bool is_ixml_eob(XMQParseState *state);
 bool is_ixml_alias_start(XMQParseState *state);
@@ -163,6 +162,41 @@ void parse_ixml_term(XMQParseState *state);
 void parse_ixml_terminal(XMQParseState *state);
 void parse_ixml_whitespace(XMQParseState *state);
 
+/**
+    IXMLCompiledReader: Cursor into a compiled ixml grammar.
+    @i: The next byte to read.
+    @stop: Points to the byte after the compiled grammar.
+    @ok: Set to false when a read went past stop or found a bad value.
+*/
+struct IXMLCompiledReader
+{
+    const char *i;
+    const char *stop;
+    bool ok;
+};
+typedef struct IXMLCompiledReader IXMLCompiledReader;
+
+void write_compiled_int(MemBuffer *mb, int i);
+void write_compiled_string(MemBuffer *mb, const char *s);
+void write_compiled_charset(MemBuffer *mb, IXMLCharset *cs);
+int read_compiled_int(IXMLCompiledReader *r);
+char read_compiled_char(IXMLCompiledReader *r);
+char *read_compiled_string(IXMLCompiledReader *r);
+IXMLCharset *read_compiled_charset(IXMLCompiledReader *r);
+size_t find_compiled_index(void **elements, size_t size, void *element);
+
+bool mark_unicode_used(XMQParseState *state, int uc);
+int compare_unicode_intervals(const void *a, const void *b);
+void add_unicode_interval(int **intervals, size_t *num, size_t *max, int from, int to);
+void build_ixml_charset_intervals(IXMLCharset *cs);
+const char *read_ixml_charset_class_rule(XMQParseState *state,
+                                         const char ***rhs,
+                                         const char **abs_node,
+                                         int *cost,
+                                         int **transl,
+                                         char *mark,
+                                         char **marks);
+
 void skip_comment(const char **i);
 void skip_encoded(const char **i);
 void skip_mark(const char **i);
@@ -1538,6 +1572,86 @@ const char *ixml_to_yaep_read_terminal(YaepParseRun *pr,
     return NULL;
 }
 
+const char *ixml_to_yaep_read_class(YaepParseRun *pr,
+                                    YaepGrammar *g,
+                                    const int **intervals,
+                                    int *num_intervals)
+{
+    XMQParseState *state = (XMQParseState*)pr->user_data;
+
+    while (state->yaep_k_ < state->ixml_non_terminals->size)
+    {
+        IXMLNonTerminal *nt = (IXMLNonTerminal*)vector_element_at(state->ixml_non_terminals, state->yaep_k_);
+        state->yaep_k_++;
+        IXMLCharset *cs = nt->charset;
+        if (!cs) continue;
+
+        if (!cs->class_name)
+        {
+            // Generate a name like |C[L]
+            cs->class_name = (char*)malloc(strlen(nt->name)+3);
+            cs->class_name[0] = '|';
+            cs->class_name[1] = 'C';
+            strcpy(cs->class_name+2, nt->name);
+            build_ixml_charset_intervals(cs);
+        }
+        *intervals = cs->intervals;
+        *num_intervals = cs->num_intervals;
+        return cs->class_name;
+    }
+
+    return NULL;
+}
+
+const char *read_ixml_charset_class_rule(XMQParseState *state,
+                                         const char ***rhs,
+                                         const char **abs_node,
+                                         int *cost,
+                                         int **transl,
+                                         char *mark,
+                                         char **marks)
+{
+    // The classes have all been read, now step through the charsets again
+    // and generate the single rule for each charset: [L] = |C[L].
+    if (state->yaep_j_ == state->ixml_rules->size) state->yaep_k_ = 0;
+    state->yaep_j_++;
+
+    while (state->yaep_k_ < state->ixml_non_terminals->size)
+    {
+        IXMLNonTerminal *nt = (IXMLNonTerminal*)vector_element_at(state->ixml_non_terminals, state->yaep_k_);
+        state->yaep_k_++;
+        if (!nt->charset) continue;
+
+        char tmark = 0;
+        if ((nt->name[0] == '[' && nt->name[1] == '-') ||
+            (nt->name[1] == '[' && nt->name[2] == '-'))
+        {
+            tmark = '-';
+        }
+
+        if (state->yaep_tmp_rhs_) free(state->yaep_tmp_rhs_);
+        state->yaep_tmp_rhs_ = (char**)calloc(2, sizeof(char*));
+        state->yaep_tmp_rhs_[0] = nt->charset->class_name;
+        if (state->yaep_tmp_marks_) free(state->yaep_tmp_marks_);
+        state->yaep_tmp_marks_ = (char*)calloc(2, sizeof(char));
+        state->yaep_tmp_marks_[0] = tmark;
+        if (state->yaep_tmp_transl_) free(state->yaep_tmp_transl_);
+        state->yaep_tmp_transl_ = (int*)calloc(2, sizeof(int));
+        state->yaep_tmp_transl_[0] = 0;
+        state->yaep_tmp_transl_[1] = -1;
+
+        *rhs = (const char **)state->yaep_tmp_rhs_;
+        *marks = state->yaep_tmp_marks_;
+        *transl = state->yaep_tmp_transl_;
+        *abs_node = nt->name;
+        *cost = 0;
+        *mark = '-';
+        return nt->name;
+    }
+
+    return NULL;
+}
+
 const char *ixml_to_yaep_read_rule(YaepParseRun *pr,
                                    YaepGrammar *g,
                                    const char ***rhs,
@@ -1548,7 +1662,10 @@ const char *ixml_to_yaep_read_rule(YaepParseRun *pr,
                                    char **marks)
 {
     XMQParseState *state = (XMQParseState*)pr->user_data;
-    if (state->yaep_j_ >= state->ixml_rules->size) return NULL;
+    if (state->yaep_j_ >= state->ixml_rules->size)
+    {
+        return read_ixml_charset_class_rule(state, rhs, abs_node, cost, transl, mark, marks);
+    }
     IXMLRule *rule = (IXMLRule*)vector_element_at(state->ixml_rules, state->yaep_j_);
 
     // This is a valid rule.
@@ -1790,22 +1907,6 @@ void add_yaep_tmp_term_terminal(XMQParseState *state, char *name, int code)
     vector_push_back(state->ixml_tmp_terminals, t);
 }
 
-void add_single_char_rule(XMQParseState *state, IXMLNonTerminal *nt, int uc, char mark, char tmark)
-{
-    IXMLRule *rule = new_ixml_rule();
-    rule->rule_name->name = strdup(nt->name);
-    // No need to copy alias here since this rule is used for single characters for charsets.
-    rule->mark = mark;
-    vector_push_back(state->ixml_rules, rule);
-    char buffer[16];
-    snprintf(buffer, 15, "#%x", uc);
-    allocate_yaep_tmp_terminals(state);
-    add_yaep_tmp_term_terminal(state, strdup(buffer), uc);
-    state->ixml_rule = rule; // FIXME this is a bit ugly.
-    add_yaep_tmp_terminals_to_rule(state, rule, tmark);
-    free_yaep_tmp_terminals(state);
-}
-
 void add_insertion_rule(XMQParseState *state, const char *content)
 {
     // Generate a name like |+.......
@@ -1889,51 +1990,142 @@ void add_not_rule_charset(XMQParseState *state, IXMLNonTerminal *cs)
     hashmap_put(state->ixml_non_terminals_map, name, nt);
 }
 
-void scan_content_fixup_charsets(XMQParseState *state, const char *start, const char *stop)
+bool mark_unicode_used(XMQParseState *state, int uc)
 {
-    const char *i = start;
-    // We allocate a byte for every possible unicode.
-    // 17*65536 = 0x11000 = 1 MB
-    char *used = (char*)malloc(0x110000);
-    memset(used, 0, 0x110000);
+    // decode_utf8 accepts lead bytes up to f7, which can decode beyond the last page.
+    if (uc < 0 || uc > 0x10ffff) return false;
+
+    uint64_t **page = &state->used_unicode_pages[uc / XMQ_UNICODE_PAGE_SIZE];
+    if (*page == NULL)
+    {
+        *page = (uint64_t*)calloc(XMQ_UNICODE_PAGE_SIZE/64, sizeof(uint64_t));
+    }
+    int offset = uc % XMQ_UNICODE_PAGE_SIZE;
+    uint64_t bit = ((uint64_t)1) << (offset & 63);
+    uint64_t *word = *page + (offset >> 6);
+    if (*word & bit) return false;
+    *word |= bit;
+    return true;
+}
+
+int compare_unicode_intervals(const void *a, const void *b)
+{
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+void add_unicode_interval(int **intervals, size_t *num, size_t *max, int from, int to)
+{
+    if (*num == *max)
+    {
+        *max = *max ? *max*2 : 64;
+        *intervals = (int*)realloc(*intervals, *max*2*sizeof(int));
+    }
+    (*intervals)[2 * *num] = from;
+    (*intervals)[2 * *num + 1] = to;
+    (*num)++;
+}
+
+void build_ixml_charset_intervals(IXMLCharset *cs)
+{
+    int *intervals = NULL;
+    size_t num = 0;
+    size_t max = 0;
+
+    for (IXMLCharsetPart *p = cs->first; p; p = p->next)
+    {
+        if (!p->category[0])
+        {
+            add_unicode_interval(&intervals, &num, &max, p->from, p->to);
+            continue;
+        }
+        uint64_t mask = unicode_category_mask(p->category);
+        if (!mask)
+        {
+            fprintf(stderr, "Invalid unicode category: %s\n", p->category);
+            exit(1);
+        }
+        // Store each run of consecutive code points in the category as an interval.
+        int from = unicode_next_code_with_category(0, mask);
+        while (from >= 0)
+        {
+            int to = from;
+            while (to < 0x10ffff && unicode_has_category(to+1, mask)) to++;
+            add_unicode_interval(&intervals, &num, &max, from, to);
+            from = unicode_next_code_with_category(to+1, mask);
+        }
+    }
+
+    // Sort on the from code and join overlapping or adjacent intervals.
+    qsort(intervals, num, 2*sizeof(int), compare_unicode_intervals);
+    size_t n = 0;
+    for (size_t i = 0; i < num; ++i)
+    {
+        if (n > 0 && intervals[2*i] <= intervals[2*n-1]+1)
+        {
+            if (intervals[2*i+1] > intervals[2*n-1]) intervals[2*n-1] = intervals[2*i+1];
+            continue;
+        }
+        intervals[2*n] = intervals[2*i];
+        intervals[2*n+1] = intervals[2*i+1];
+        n++;
+    }
+    num = n;
 
-    if (state->used_unicodes == NULL)
+    if (cs->exclude)
     {
-        state->used_unicodes = (char*)malloc(0x110000);
-        memset(state->used_unicodes, 0, 0x110000);
+        // An excluding charset matches the gaps between the intervals.
+        int *gaps = NULL;
+        size_t num_gaps = 0;
+        size_t max_gaps = 0;
+        int from = 0;
+        for (size_t i = 0; i < num; ++i)
+        {
+            if (intervals[2*i] > from) add_unicode_interval(&gaps, &num_gaps, &max_gaps, from, intervals[2*i]-1);
+            from = intervals[2*i+1]+1;
+        }
+        if (from <= 0x10ffff) add_unicode_interval(&gaps, &num_gaps, &max_gaps, from, 0x10ffff);
+        free(intervals);
+        intervals = gaps;
+        num = num_gaps;
     }
 
-    char *already_used = state->used_unicodes;
+    cs->intervals = intervals;
+    cs->num_intervals = (int)num;
+}
+
+void scan_content_fixup_charsets(XMQParseState *state, const char *start, const char *stop)
+{
+    const char *i = start;
+
+    /* Every character in the content must be a terminal in the yaep grammar.
+       The charsets are class terminals that match any of these terminals at scan time,
+       so the charsets themselves do not change when new characters are found.
 
-    /* If we are parsing using --lines, ie each input line in the file is reparsed using the ixml grammar.
+       If we are parsing using --lines, ie each input line in the file is reparsed using the ixml grammar.
        Hej aaa!
        Hej aaa!
        Hej aab!
 
-       with the ixml grammar:
-       name = -'Hej ', [L]+, '!'.
-
-       then the first line adds "H e j a" to the charset [L].
+       then the first line adds the terminals "H e j a !" and the space.
        the second line adds nothing more.
-       the third line adds "b" to the charset [L].
+       the third line adds "b".
     */
-
     while (i < stop)
     {
         int uc = 0;
         size_t len = 0;
         bool ok = decode_utf8(i, stop, &uc, &len);
-        if (!ok)
+        if (!ok || uc < 0 || uc > 0x10ffff)
         {
             fprintf(stderr, "xmq: broken utf8\n");
             exit(1);
         }
         i += len;
 
-        if (!already_used[uc])
+        if (mark_unicode_used(state, uc))
         {
-            already_used[uc] = 1;
-            used[uc] = 1;
             char buf[16];
             snprintf(buf,16, "#%x", uc);
             IXMLTerminal *t = (IXMLTerminal*)hashmap_get(state->ixml_terminals_map, buf);
@@ -1949,122 +2141,6 @@ void scan_content_fixup_charsets(XMQParseState *state, const char *start, const
             }
         }
     }
-
-    for (size_t i = 0; i < state->ixml_non_terminals->size; ++i)
-    {
-        IXMLNonTerminal *nt = (IXMLNonTerminal*)vector_element_at(state->ixml_non_terminals, i);
-        if (nt->charset)
-        {
-            bool include = nt->name[0] != '~';
-            char tmark = 0;
-            if ((nt->name[0] == '[' && nt->name[1] == '-') ||
-                (nt->name[1] == '[' && nt->name[2] == '-'))
-            {
-                tmark = '-';
-            }
-
-            if (include)
-            {
-                // Including...
-                for (IXMLCharsetPart *p = nt->charset->first; p; p = p->next)
-                {
-                    if (!p->category[0])
-                    {
-                        // Not a category, test a range.
-                        // All characters within the range that have been used
-                        // should be tested for.
-                        for (int c = p->from; c <= p->to; ++c)
-                        {
-                            if (c >= 0 && c <= 0x10ffff && used[c])
-                            {
-                                add_single_char_rule(state, nt, c, '-', tmark);
-                            }
-                        }
-                    }
-                    else
-                    {
-                        const char **cat_part = unicode_lookup_category_parts(p->category);
-                        for (; *cat_part; ++cat_part)
-                        {
-                            int *cat = NULL;
-                            size_t cat_len = 0;
-                            bool ok = unicode_get_category_part(*cat_part, &cat, &cat_len);
-                            if (!ok)
-                            {
-                                fprintf(stderr, "Invalid unicode category: %s\n", *cat_part);
-                                exit(1);
-                            }
-                            // All characters in the category that have been used
-                            // should be tested for.
-                            for (size_t i = 0; i < cat_len; ++i)
-                            {
-                                int c = cat[i];
-                                if (c >= 0 && c <= 0x10ffff && used[c])
-                                {
-                                    add_single_char_rule(state, nt, c, '-', tmark);
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-            else
-            {
-                // Excluding....
-                // Scan all actually used characters in the input content.
-                for (int c = 0; c <= 0x10ffff; ++c)
-                {
-                    if (!used[c]) continue;
-                    bool should_add = true;
-                    for (IXMLCharsetPart *p = nt->charset->first; p; p = p->next)
-                    {
-                        if (p->category[0])
-                        {
-                            const char **cat_part = unicode_lookup_category_parts(p->category);
-                            for (; *cat_part; ++cat_part)
-                            {
-                                int *cat = NULL;
-                                size_t cat_len = 0;
-                                bool ok = unicode_get_category_part(*cat_part, &cat, &cat_len);
-                                if (!ok)
-                                {
-                                    fprintf(stderr, "Invalid unicode category: %s\n", *cat_part);
-                                    exit(1);
-                                }
-                                // Is the used character in the category set?
-                                if (category_has_code(c, cat, cat_len))
-                                {
-                                    // Yes it is.
-                                    // Do not add the used character! We do not want to match against
-                                    // it since it is excluded.
-                                    should_add = false;
-                                    break;
-                                }
-                            }
-                        }
-                        else
-                        {
-                            // Is the used character in the range?
-                            if (c >= p->from && c <= p->to)
-                            {
-                                // Yes it is.
-                                // Do not add the used character! We do not want to match against
-                                // it since it is excluded.
-                                should_add= false;
-                                break;
-                            }
-                        }
-                    }
-                    if (should_add)
-                    {
-                        add_single_char_rule(state, nt, c, '-', tmark);
-                    }
-                }
-            }
-        }
-    }
-
-    free(used);
 }
 
 void add_yaep_tmp_terminals_to_rule(XMQParseState *state, IXMLRule *rule, char mark)
@@ -2211,6 +2287,11 @@ void new_ixml_charset_part(IXMLCharset *cs, int from, int to, const char *catego
 
 void free_ixml_charset(IXMLCharset *cs)
 {
+    if (cs->class_name) free(cs->class_name);
+    cs->class_name = NULL;
+    if (cs->intervals) free(cs->intervals);
+    cs->intervals = NULL;
+
     IXMLCharsetPart *i = cs->first;
     while (i)
     {
@@ -2506,6 +2587,338 @@ void ixml_print_grammar(XMQParseState *state)
     }
 }
 
+// A compiled ixml grammar starts with this magic, followed by a format version.
+// All ints are stored as four bytes little endian, independent of the host.
+#define IXML_COMPILED_MAGIC "XMQIXMLC"
+#define IXML_COMPILED_MAGIC_LEN 8
+#define IXML_COMPILED_VERSION 2
+// A NULL string (no alias) is stored with this length.
+#define IXML_COMPILED_NULL -1
+
+bool is_ixml_compiled_grammar(const char *start, const char *stop)
+{
+    if (!stop) return false;
+    if ((size_t)(stop-start) < IXML_COMPILED_MAGIC_LEN) return false;
+    return !memcmp(start, IXML_COMPILED_MAGIC, IXML_COMPILED_MAGIC_LEN);
+}
+
+void write_compiled_int(MemBuffer *mb, int i)
+{
+    uint32_t u = (uint32_t)i;
+    for (int b = 0; b < 4; ++b) membuffer_append_char(mb, (char)((u >> (8*b)) & 0xff));
+}
+
+void write_compiled_string(MemBuffer *mb, const char *s)
+{
+    if (!s)
+    {
+        write_compiled_int(mb, IXML_COMPILED_NULL);
+        return;
+    }
+    size_t len = strlen(s);
+    write_compiled_int(mb, (int)len);
+    membuffer_append_region(mb, s, s+len);
+}
+
+void write_compiled_charset(MemBuffer *mb, IXMLCharset *cs)
+{
+    membuffer_append_char(mb, cs ? 1 : 0);
+    if (!cs) return;
+
+    membuffer_append_char(mb, cs->exclude ? 1 : 0);
+    int num_parts = 0;
+    for (IXMLCharsetPart *p = cs->first; p; p = p->next) num_parts++;
+    write_compiled_int(mb, num_parts);
+    for (IXMLCharsetPart *p = cs->first; p; p = p->next)
+    {
+        write_compiled_int(mb, p->from);
+        write_compiled_int(mb, p->to);
+        membuffer_append_char(mb, p->category[0]);
+        membuffer_append_char(mb, p->category[1]);
+    }
+}
+
+size_t find_compiled_index(void **elements, size_t size, void *element)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (elements[i] == element) return i;
+    }
+    assert(false);
+    return 0;
+}
+
+void ixml_write_compiled_grammar(XMQParseState *state, MemBuffer *mb)
+{
+    membuffer_append_region(mb, IXML_COMPILED_MAGIC, IXML_COMPILED_MAGIC+IXML_COMPILED_MAGIC_LEN);
+    write_compiled_int(mb, IXML_COMPILED_VERSION);
+    membuffer_append_char(mb, state->ixml_costs_enabled ? 1 : 0);
+    membuffer_append_char(mb, state->ixml_controlled_ambiguity_enabled ? 1 : 0);
+
+    // The terminals are stored in the iteration order of the terminals map.
+    // Inserting them in the same order recreates an identical map and
+    // the yaep grammar is then fed the terminals in the same order as well.
+    size_t num_terminals = hashmap_size(state->ixml_terminals_map);
+    void **terminals = (void**)calloc(num_terminals+1, sizeof(void*));
+    HashMapIterator *it = hashmap_iterate(state->ixml_terminals_map);
+    const char *key;
+    void *val;
+    size_t n = 0;
+    while (hashmap_next_key_value(it, &key, &val)) terminals[n++] = val;
+    hashmap_free_iterator(it);
+
+    // The terminal name is always #hex of the code and is not stored.
+    write_compiled_int(mb, (int)num_terminals);
+    for (size_t i = 0; i < num_terminals; ++i)
+    {
+        IXMLTerminal *t = (IXMLTerminal*)terminals[i];
+        write_compiled_int(mb, t->code);
+    }
+
+    // The non-terminals vector has an entry for each reference to a rule, only
+    // the first one with each name is stored and the references use that one.
+    Vector *nts = state->ixml_non_terminals;
+    HashMap *unique_map = hashmap_create(256);
+    void **unique = (void**)calloc(nts->size+1, sizeof(void*));
+    size_t num_unique = 0;
+    for (size_t i = 0; i < nts->size; ++i)
+    {
+        IXMLNonTerminal *nt = (IXMLNonTerminal*)vector_element_at(nts, i);
+        if (hashmap_get(unique_map, nt->name)) continue;
+        hashmap_put(unique_map, nt->name, nt);
+        unique[num_unique++] = nt;
+    }
+
+    write_compiled_int(mb, (int)num_unique);
+    for (size_t i = 0; i < num_unique; ++i)
+    {
+        IXMLNonTerminal *nt = (IXMLNonTerminal*)unique[i];
+        write_compiled_string(mb, nt->name);
+        write_compiled_string(mb, nt->alias);
+        write_compiled_charset(mb, nt->charset);
+    }
+
+    // The rhs terms refer to the terminals and non-terminals by index.
+    write_compiled_int(mb, (int)state->ixml_rules->size);
+    for (size_t i = 0; i < state->ixml_rules->size; ++i)
+    {
+        IXMLRule *rule = (IXMLRule*)vector_element_at(state->ixml_rules, i);
+        write_compiled_string(mb, rule->rule_name->name);
+        write_compiled_string(mb, rule->rule_name->alias);
+        membuffer_append_char(mb, rule->mark);
+        write_compiled_int(mb, rule->cost);
+        membuffer_append_char(mb, rule->expected_ambiguity ? 1 : 0);
+        write_compiled_int(mb, (int)rule->rhs_terms->size);
+        for (size_t j = 0; j < rule->rhs_terms->size; ++j)
+        {
+            IXMLTerm *term = (IXMLTerm*)vector_element_at(rule->rhs_terms, j);
+            membuffer_append_char(mb, (char)term->type);
+            membuffer_append_char(mb, term->mark);
+            size_t index = 0;
+            if (term->type == IXML_TERMINAL) index = find_compiled_index(terminals, num_terminals, term->t);
+            else index = find_compiled_index(unique, num_unique, hashmap_get(unique_map, term->nt->name));
+            write_compiled_int(mb, (int)index);
+        }
+    }
+
+    hashmap_free(unique_map);
+    free(unique);
+    free(terminals);
+}
+
+int read_compiled_int(IXMLCompiledReader *r)
+{
+    if (!r->ok || r->stop - r->i < 4)
+    {
+        r->ok = false;
+        return 0;
+    }
+    uint32_t u = 0;
+    for (int b = 0; b < 4; ++b) u |= ((uint32_t)(unsigned char)r->i[b]) << (8*b);
+    r->i += 4;
+    return (int)u;
+}
+
+char read_compiled_char(IXMLCompiledReader *r)
+{
+    if (!r->ok || r->i >= r->stop)
+    {
+        r->ok = false;
+        return 0;
+    }
+    return *(r->i)++;
+}
+
+char *read_compiled_string(IXMLCompiledReader *r)
+{
+    int len = read_compiled_int(r);
+    if (!r->ok || len == IXML_COMPILED_NULL) return NULL;
+    if (len < 0 || r->stop - r->i < len)
+    {
+        r->ok = false;
+        return NULL;
+    }
+    char *s = strndup(r->i, len);
+    r->i += len;
+    return s;
+}
+
+IXMLCharset *read_compiled_charset(IXMLCompiledReader *r)
+{
+    if (!read_compiled_char(r)) return NULL;
+
+    IXMLCharset *cs = new_ixml_charset(read_compiled_char(r) != 0);
+    int num_parts = read_compiled_int(r);
+    for (int i = 0; r->ok && i < num_parts; ++i)
+    {
+        char category[3];
+        int from = read_compiled_int(r);
+        int to = read_compiled_int(r);
+        category[0] = read_compiled_char(r);
+        category[1] = read_compiled_char(r);
+        category[2] = 0;
+        if (!r->ok) break;
+        if (category[0])
+        {
+            if (!unicode_category_mask(category)) r->ok = false;
+        }
+        else if (from < 0 || to > 0x10ffff || from > to)
+        {
+            r->ok = false;
+        }
+        if (!r->ok) break;
+        new_ixml_charset_part(cs, from, to, category);
+    }
+    return cs;
+}
+
+bool ixml_read_compiled_grammar(YaepParseRun *pr,
+                                YaepGrammar *g,
+                                XMQParseState *state,
+                                const char *start,
+                                const char *stop)
+{
+    pr->user_data = state;
+    pr->grammar = g;
+    state->ixml_rules = vector_create();
+    state->ixml_terminals_map = hashmap_create(256);
+    state->ixml_non_terminals_map = hashmap_create(256);
+    state->ixml_non_terminals = vector_create();
+    state->ixml_rule_stack = stack_create();
+    state->error_nr = XMQ_OK;
+
+    IXMLCompiledReader r = {};
+    r.i = start;
+    r.stop = stop;
+    r.ok = is_ixml_compiled_grammar(start, stop);
+    if (r.ok) r.i += IXML_COMPILED_MAGIC_LEN;
+    if (read_compiled_int(&r) != IXML_COMPILED_VERSION) r.ok = false;
+
+    state->ixml_costs_enabled = read_compiled_char(&r) != 0;
+    state->ixml_controlled_ambiguity_enabled = read_compiled_char(&r) != 0;
+
+    // Each terminal is stored as a four byte code.
+    int num_terminals = read_compiled_int(&r);
+    IXMLTerminal **terminals = NULL;
+    if (r.ok && num_terminals >= 0 && num_terminals <= (r.stop-r.i)/4) terminals = (IXMLTerminal**)calloc(num_terminals+1, sizeof(IXMLTerminal*));
+    else r.ok = false;
+
+    for (int i = 0; r.ok && i < num_terminals; ++i)
+    {
+        int code = read_compiled_int(&r);
+        if (!r.ok || code < 0 || code > 0x10ffff)
+        {
+            r.ok = false;
+            break;
+        }
+        char buf[16];
+        snprintf(buf, 16, "#%x", code);
+        if (hashmap_get(state->ixml_terminals_map, buf))
+        {
+            // The map would silently replace the terminal.
+            r.ok = false;
+            break;
+        }
+        IXMLTerminal *t = new_ixml_terminal();
+        t->code = code;
+        t->name = strdup(buf);
+        add_yaep_terminal(state, t);
+        terminals[i] = t;
+    }
+
+    int num_non_terminals = read_compiled_int(&r);
+    for (int i = 0; r.ok && i < num_non_terminals; ++i)
+    {
+        char *name = read_compiled_string(&r);
+        char *alias = read_compiled_string(&r);
+        IXMLCharset *cs = read_compiled_charset(&r);
+        IXMLNonTerminal *nt = new_ixml_nonterminal();
+        nt->name = name;
+        nt->alias = alias;
+        nt->charset = cs;
+        // The map would silently replace a non-terminal with the same name.
+        // A charset non-terminal is named from its charset, e.g. [L] or ~[-"a"].
+        if (!r.ok || !name || hashmap_get(state->ixml_non_terminals_map, name) ||
+            (cs && name[0] != '[' && (name[0] != '~' || name[1] != '[')))
+        {
+            free_ixml_nonterminal(nt);
+            r.ok = false;
+            break;
+        }
+        add_yaep_nonterminal(state, nt);
+    }
+
+    int num_rules = read_compiled_int(&r);
+    for (int i = 0; r.ok && i < num_rules; ++i)
+    {
+        IXMLRule *rule = new_ixml_rule();
+        vector_push_back(state->ixml_rules, rule);
+        rule->rule_name->name = read_compiled_string(&r);
+        rule->rule_name->alias = read_compiled_string(&r);
+        rule->mark = read_compiled_char(&r);
+        rule->cost = read_compiled_int(&r);
+        rule->expected_ambiguity = read_compiled_char(&r) != 0;
+        // Yaep rejects a negative cost.
+        if (!rule->rule_name->name || rule->cost < 0) r.ok = false;
+
+        int num_terms = read_compiled_int(&r);
+        state->ixml_rule = rule;
+        for (int j = 0; r.ok && j < num_terms; ++j)
+        {
+            IXMLTermType type = (IXMLTermType)read_compiled_char(&r);
+            char mark = read_compiled_char(&r);
+            int index = read_compiled_int(&r);
+            if (!r.ok) break;
+            if (type == IXML_TERMINAL && index >= 0 && index < num_terminals)
+            {
+                add_yaep_term_to_rule(state, mark, terminals[index], NULL);
+            }
+            else if (type == IXML_NON_TERMINAL && index >= 0 && (size_t)index < state->ixml_non_terminals->size)
+            {
+                add_yaep_term_to_rule(state, mark, NULL, (IXMLNonTerminal*)vector_element_at(state->ixml_non_terminals, index));
+            }
+            else
+            {
+                r.ok = false;
+            }
+        }
+    }
+    state->ixml_rule = NULL;
+
+    if (r.ok && r.i != r.stop) r.ok = false;
+
+    free(terminals);
+
+    if (!r.ok)
+    {
+        state->error_nr = XMQ_ERROR_IXML_SYNTAX_ERROR;
+        state->generated_error_msg = strdup("xmq: broken compiled ixml grammar");
+        return false;
+    }
+
+    return true;
+}
+
 #else
 
 
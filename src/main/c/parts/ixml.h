@@ -27,6 +27,7 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #ifndef BUILDING_DIST_XMQ
 
 #include"xmq.h"
+#include"membuffer.h"
 
 #endif
 
@@ -51,6 +52,15 @@ bool ixml_build_yaep_grammar(YaepParseRun *pr,
                              const char *content_start, // Needed to minimize charset rule sizes.
                              const char *content_stop);
 
+// A compiled grammar is the parsed ixml grammar stored in a compact binary format.
+bool is_ixml_compiled_grammar(const char *start, const char *stop);
+void ixml_write_compiled_grammar(XMQParseState *state, MemBuffer *mb);
+bool ixml_read_compiled_grammar(YaepParseRun *pr,
+                                YaepGrammar *g,
+                                XMQParseState *state,
+                                const char *start,
+                                const char *stop);
+
 IXMLTerminal *new_ixml_terminal();
 IXMLNonTerminal *new_ixml_nonterminal();
 void free_ixml_rule(IXMLRule *r);
@@ -59,6 +69,10 @@ void free_ixml_nonterminal(IXMLNonTerminal *nt);
 const char *ixml_to_yaep_read_terminal(YaepParseRun *pr,
                                        YaepGrammar *g,
                                        int *code);
+const char *ixml_to_yaep_read_class(YaepParseRun *pr,
+                                    YaepGrammar *g,
+                                    const int **intervals,
+                                    int *num_intervals);
 const char *ixml_to_yaep_read_rule(YaepParseRun *pr,
                                    YaepGrammar *g,
                                    const char ***rhs,
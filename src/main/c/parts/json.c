@@ -13,6 +13,7 @@
 #include"text.h"
 #include"utf8.h"
 #include"xml.h"
+#include"xmq_printer.h"
 
 #include<assert.h>
 #include<string.h>
@@ -22,12 +23,16 @@
 
 #ifdef JSON_MODULE
 
+bool build_json_index(XMQParseState *state, const char *start, const char *stop);
+size_t count_json_chars(const char *i, const char *stop);
+const char *json_index_string_end(XMQParseState *state, const char *quote);
 void eat_json_boolean(XMQParseState *state);
 void eat_json_null(XMQParseState *state);
 void eat_json_number(XMQParseState *state);
+char *eat_json_key(XMQParseState *state, const char **key_start, const char **key_stop);
 void eat_json_quote(XMQParseState *state, char **content_start, char **content_stop);
+void eat_json_whitespace(XMQParseState *state);
 
-void fixup_json(XMQDoc *doq, xmlNode *node);
 
 void parse_json(XMQParseState *state, const char *key_start, const char *key_stop);
 void parse_json_array(XMQParseState *state, const char *key_start, const char *key_stop);
@@ -40,6 +45,7 @@ void parse_json_quote(XMQParseState *state, const char *key_start, const char *k
 bool has_number_ended(char c);
 bool has_attr_other_than_AS_(xmlNode *node);
 const char *is_jnumber(const char *start, const char *stop);
+const char *scan_jnumber(const char *i, const char *stop);
 bool is_json_boolean(XMQParseState *state);
 bool is_json_null(XMQParseState *state);
 bool is_json_number(XMQParseState *state);
@@ -65,9 +71,28 @@ void json_check_comma(XMQPrintState *ps);
 void json_print_comma(XMQPrintState *ps);
 bool json_is_number(const char *start);
 bool json_is_keyword(const char *start);
+bool json_is_literal_node(XMQPrintState *ps, xmlNode *node);
 void json_print_leaf_node(XMQPrintState *ps, xmlNode *container, xmlNode *node, size_t total, size_t used);
+size_t json_push_key_table(XMQJsonKeyTables *kt, size_t num_keys);
+size_t json_key_slot(XMQJsonKeyTables *kt, size_t base, const char *name);
+void json_print_object_run(XMQPrintState *ps, void *data, xmlNode *from, xmlNode *stop, size_t from_index, size_t align, xmlNode *restart_find_at_node);
+void json_print_array_run(XMQPrintState *ps, void *data, xmlNode *from, xmlNode *stop, size_t from_index, size_t align, xmlNode *restart_find_at_node);
 
 void trim_index_suffix(const char *key_start, const char **stop);
+size_t hash_json_key(const char *start, const char *stop);
+XMQJsonKey *lookup_json_key(XMQJsonKeyCache *kc, const char *start, const char *stop);
+bool json_key_name(XMQParseState *state, const char *key_start, const char **key_stop, const char **colon);
+
+void transcode_json(XMQParseState *state, XMQPrintState *ps, const char *key_start, const char *key_stop);
+void transcode_json_array(XMQParseState *state, XMQPrintState *ps, const char *key_start, const char *key_stop);
+void transcode_json_literal(XMQParseState *state, XMQPrintState *ps, const char *key_start, const char *key_stop);
+void transcode_json_object(XMQParseState *state, XMQPrintState *ps, const char *key_start, const char *key_stop);
+void transcode_json_quote(XMQParseState *state, XMQPrintState *ps, const char *key_start, const char *key_stop);
+void transcode_json_name(XMQParseState *state, XMQPrintState *ps, const char *key_start, const char *key_stop, bool string_type, bool array_type);
+void transcode_json_value(XMQPrintState *ps, const char *start, const char *stop, Level level);
+void transcode_json_needs_dom(XMQParseState *state);
+char *transcode_json_hold(XMQParseState *state, char *s);
+void transcode_json_release(XMQParseState *state, char *s);
 
 char equals[] = "=";
 char underline[] = "_";
@@ -88,19 +113,315 @@ bool is_json_quote_start(char c)
     return c == '"';
 }
 
+#define JSON_ONES  0x0101010101010101ULL
+#define JSON_HIGHS 0x8080808080808080ULL
+
+/**
+    find_json_quote_special:
+    @i: Start scanning here.
+    @stop: Stop scanning here.
+    @col: Incremented with the number of characters skipped.
+
+    Returns the first double quote, backslash or control character in the string content,
+    or stop if there is none. Scans eight bytes at a time, since long strings without
+    escapes are common in json.
+*/
+const char *find_json_quote_special(const char *i, const char *stop, size_t *col)
+{
+    size_t num_chars = 0;
+
+    while (i+8 <= stop)
+    {
+        uint64_t w;
+        memcpy(&w, i, 8);
+        uint64_t q = w ^ (JSON_ONES * '"');
+        uint64_t b = w ^ (JSON_ONES * '\\');
+        // A byte is flagged if it is zero after the xor, ie a quote or backslash, or below 0x20.
+        uint64_t special = ((q - JSON_ONES) & ~q) | ((b - JSON_ONES) & ~b) | ((w - JSON_ONES * 0x20) & ~w);
+        if (special & JSON_HIGHS) break;
+
+        // Utf8 continuation bytes 10xxxxxx do not change the column.
+        uint64_t cont = (w & ~(w << 1) & JSON_HIGHS) >> 7;
+        num_chars += 8 - (size_t)((cont * JSON_ONES) >> 56);
+        i += 8;
+    }
+
+    while (i < stop)
+    {
+        char c = *i;
+        if (c == '"' || c == '\\' || (unsigned char)c < 0x20) break;
+        if ((c & 0xc0) != 0x80) num_chars++;
+        i++;
+    }
+
+    *col += num_chars;
+    return i;
+}
+
+/**
+    count_json_chars:
+    @i: Start counting here.
+    @stop: Stop counting here.
+
+    Returns the number of utf8 characters between i and stop, ie the change in column.
+*/
+size_t count_json_chars(const char *i, const char *stop)
+{
+    size_t num_chars = 0;
+
+    while (i+8 <= stop)
+    {
+        uint64_t w;
+        memcpy(&w, i, 8);
+        uint64_t cont = (w & ~(w << 1) & JSON_HIGHS) >> 7;
+        num_chars += 8 - (size_t)((cont * JSON_ONES) >> 56);
+        i += 8;
+    }
+
+    for (; i < stop; ++i)
+    {
+        if ((*i & 0xc0) != 0x80) num_chars++;
+    }
+
+    return num_chars;
+}
+
+#define JSON_INDEX_MAX_SIZE 0xffffffffULL
+
+// Non-zero if any of the eight bytes in w equals c.
+#define JSON_WORD_HAS(w, c) ((((w) ^ (JSON_ONES * (c))) - JSON_ONES) & ~((w) ^ (JSON_ONES * (c))) & JSON_HIGHS)
+
+/**
+    build_json_index:
+    @state: The parse state, the offsets are stored in state->json_index.
+    @start: Start of the json buffer.
+    @stop: Points to byte after the json buffer.
+
+    Stage one of the json parser, used when the XMQ_FLAG_JSON_INDEX flag is given.
+    Records the offset of every structural character { } [ ] : , every string start and end,
+    every backslash and control character inside strings, every other token start and every
+    newline between tokens. The parse functions then jump over the whitespace between tokens
+    and over strings without escapes using the index, instead of examining them byte by byte.
+    Long strings and whitespace runs are skipped eight bytes at a time.
+    Returns false if the buffer is too large to be indexed.
+*/
+bool build_json_index(XMQParseState *state, const char *start, const char *stop)
+{
+    state->json_index_size = 0;
+    state->json_index_pos = 0;
+
+    size_t len = stop-start;
+    if ((unsigned long long)len >= JSON_INDEX_MAX_SIZE) return false;
+
+    bool in_string = false;
+    bool escaped = false;
+    // True when the previous byte outside of a string ended a token, ie a structural char or whitespace.
+    bool after_separator = true;
+    size_t n = 0;
+
+    const char *i = start;
+    while (i < stop)
+    {
+        if (i+8 <= stop && !escaped)
+        {
+            uint64_t w;
+            memcpy(&w, i, 8);
+            if (in_string)
+            {
+                // Skip string content without quotes, escapes or control characters.
+                if (!JSON_WORD_HAS(w, '"') && !JSON_WORD_HAS(w, '\\') && !((w - JSON_ONES * 0x20) & ~w & JSON_HIGHS))
+                {
+                    i += 8;
+                    continue;
+                }
+            }
+            else if (after_separator)
+            {
+                // Skip indentation, ie spaces and tabs.
+                uint64_t s = w ^ (JSON_ONES * ' ');
+                uint64_t t = w ^ (JSON_ONES * '\t');
+                // A byte that is neither space nor tab has non-zero bits in both s and t.
+                uint64_t other = ((s | ((s & ~JSON_HIGHS) + ~JSON_HIGHS)) & (t | ((t & ~JSON_HIGHS) + ~JSON_HIGHS))) & JSON_HIGHS;
+                if (!other)
+                {
+                    i += 8;
+                    continue;
+                }
+            }
+        }
+
+        // Make room for at least eight more offsets.
+        if (n+8 > state->json_index_capacity)
+        {
+            size_t cap = state->json_index_capacity ? state->json_index_capacity*2 : 1024;
+            state->json_index = (uint32_t*)realloc(state->json_index, cap*sizeof(uint32_t));
+            state->json_index_capacity = cap;
+        }
+
+        const char *end = i+8 < stop ? i+8 : stop;
+        for (; i < end; ++i)
+        {
+            char c = *i;
+            if (in_string)
+            {
+                if (escaped) escaped = false;
+                else if (c == '\\')
+                {
+                    escaped = true;
+                    state->json_index[n++] = (uint32_t)(i-start);
+                }
+                else if (c == '"')
+                {
+                    in_string = false;
+                    after_separator = true;
+                    state->json_index[n++] = (uint32_t)(i-start);
+                }
+                else if ((unsigned char)c < 0x20) state->json_index[n++] = (uint32_t)(i-start);
+                continue;
+            }
+            switch (c)
+            {
+            case '"':
+                in_string = true;
+                state->json_index[n++] = (uint32_t)(i-start);
+                break;
+            case '{': case '}': case '[': case ']': case ':': case ',': case '\n':
+                state->json_index[n++] = (uint32_t)(i-start);
+                after_separator = true;
+                break;
+            case ' ': case '\t': case '\r':
+                after_separator = true;
+                break;
+            default:
+                if (after_separator) state->json_index[n++] = (uint32_t)(i-start);
+                after_separator = false;
+            }
+        }
+    }
+    state->json_index_size = n;
+    return true;
+}
+
+/**
+    eat_json_whitespace:
+    @state: The parse state.
+
+    Skip whitespace between json tokens. When the json index is available the whitespace
+    ends at the next recorded offset and only the recorded newlines update the line.
+*/
+void eat_json_whitespace(XMQParseState *state)
+{
+    const char *i = state->i;
+    const char *stop = state->buffer_stop;
+
+    if (!state->json_index || i >= stop || (*i != ' ' && *i != '\t' && *i != '\r' && *i != '\n'))
+    {
+        eat_xml_whitespace(state, NULL, NULL);
+        return;
+    }
+
+    const char *start = state->buffer_start;
+    const uint32_t *index = state->json_index;
+    size_t size = state->json_index_size;
+    size_t pos = state->json_index_pos;
+    size_t offset = i-start;
+    size_t col = state->col;
+
+    while (pos < size && index[pos] < offset) pos++;
+
+    // The bytes up to the next recorded offset are spaces, tabs and carriage returns,
+    // except the recorded newlines.
+    while (pos < size && start[index[pos]] == '\n')
+    {
+        state->line++;
+        col = 1;
+        offset = index[pos]+1;
+        pos++;
+    }
+    const char *next = pos < size ? start+index[pos] : stop;
+    col += next-(start+offset);
+
+    state->i = next;
+    state->col = col;
+    state->json_index_pos = pos;
+
+    if (next < stop && (*next & 0x80))
+    {
+        // Perhaps non-ascii whitespace, which is permitted between tokens.
+        eat_xml_whitespace(state, NULL, NULL);
+    }
+}
+
+/**
+    json_index_string_end:
+    @state: The parse state.
+    @quote: The opening double quote of a string.
+
+    Returns the closing double quote if the json index shows that the string has no escapes
+    or control characters, and moves the index past the string. Otherwise returns NULL and
+    the string has to be scanned.
+*/
+const char *json_index_string_end(XMQParseState *state, const char *quote)
+{
+    if (!state->json_index) return NULL;
+
+    const char *start = state->buffer_start;
+    const uint32_t *index = state->json_index;
+    size_t size = state->json_index_size;
+    size_t pos = state->json_index_pos;
+    size_t offset = quote-start;
+
+    while (pos < size && index[pos] < offset) pos++;
+    state->json_index_pos = pos;
+
+    if (pos+1 >= size || index[pos] != offset || start[index[pos+1]] != '"') return NULL;
+
+    state->json_index_pos = pos+2;
+    return start+index[pos+1];
+}
+
 void eat_json_quote(XMQParseState *state, char **content_start, char **content_stop)
 {
     const char *start = state->i;
     const char *stop = state->buffer_stop;
 
-    MemBuffer *buf = new_membuffer();
-
     const char *i = start;
     size_t line = state->line;
     size_t col = state->col;
 
     increment('"', 1, &i, &line, &col);
 
+    const char *plain = i;
+    const char *end = json_index_string_end(state, start);
+    if (end)
+    {
+        col += count_json_chars(i, end);
+        i = end;
+    }
+    else
+    {
+        i = find_json_quote_special(i, stop, &col);
+    }
+
+    if (i < stop && *i == '"')
+    {
+        // No escapes, copy the content as is.
+        size_t len = i-plain;
+        char *quote = (char*)malloc(len+1);
+        memcpy(quote, plain, len);
+        quote[len] = 0;
+        increment('"', 1, &i, &line, &col);
+        state->i = i;
+        state->line = line;
+        state->col = col;
+        *content_start = quote;
+        *content_stop = quote+len;
+        return;
+    }
+
+    MemBuffer *buf = new_membuffer();
+    membuffer_append_region(buf, plain, i);
+
     while (i < stop)
     {
         char c = *i;
@@ -126,43 +447,43 @@ void eat_json_quote(XMQParseState *state, char **content_start, char **content_s
                 case '/': c = '/'; break; // Silly, but actually used sometimes in json....
                 }
                 membuffer_append_char(buf, c);
-                continue;
             }
-            else if (c == 'u')
+            else if (c == 'u' && i+4 < stop &&
+                     // Woot? Json can only escape unicode up to 0xffff ? What about 10000 up to 10ffff?
+                     is_hex(*(i+1)) && is_hex(*(i+2)) && is_hex(*(i+3)) && is_hex(*(i+4)))
             {
-                increment(c, 1, &i, &line, &col);
-                c = *i;
-                if (i+3 < stop)
+                unsigned char c1 = hex_value(*(i+1));
+                unsigned char c2 = hex_value(*(i+2));
+                unsigned char c3 = hex_value(*(i+3));
+                unsigned char c4 = hex_value(*(i+4));
+                i += 5;
+                col += 5;
+
+                int uc = (c1<<12)|(c2<<8)|(c3<<4)|c4;
+                UTF8Char utf8;
+                size_t n = encode_utf8(uc, &utf8);
+
+                for (size_t j = 0; j < n; ++j)
                 {
-                    // Woot? Json can only escape unicode up to 0xffff ? What about 10000 up to 10ffff?
-                    if (is_hex(*(i+0)) && is_hex(*(i+1)) && is_hex(*(i+2)) && is_hex(*(i+3)))
-                    {
-                        unsigned char c1 = hex_value(*(i+0));
-                        unsigned char c2 = hex_value(*(i+1));
-                        unsigned char c3 = hex_value(*(i+2));
-                        unsigned char c4 = hex_value(*(i+3));
-                        increment(c, 1, &i, &line, &col);
-                        increment(c, 1, &i, &line, &col);
-                        increment(c, 1, &i, &line, &col);
-                        increment(c, 1, &i, &line, &col);
-
-                        int uc = (c1<<12)|(c2<<8)|(c3<<4)|c4;
-                        UTF8Char utf8;
-                        size_t n = encode_utf8(uc, &utf8);
-
-                        for (size_t j = 0; j < n; ++j)
-                        {
-                            membuffer_append_char(buf, utf8.bytes[j]);
-                        }
-                        continue;
-                    }
+                    membuffer_append_char(buf, utf8.bytes[j]);
                 }
             }
-            state->error_nr = XMQ_ERROR_JSON_INVALID_ESCAPE;
-            longjmp(state->error_handler, 1);
+            else
+            {
+                state->error_nr = XMQ_ERROR_JSON_INVALID_ESCAPE;
+                longjmp(state->error_handler, 1);
+            }
+        }
+        else
+        {
+            // A control character, ie a raw newline or tab, keep it as is.
+            membuffer_append_char(buf, c);
+            increment(c, 1, &i, &line, &col);
         }
-        membuffer_append_char(buf, c);
-        increment(c, 1, &i, &line, &col);
+
+        plain = i;
+        i = find_json_quote_special(i, stop, &col);
+        membuffer_append_region(buf, plain, i);
     }
     // Add a zero termination to the string which is not used except for
     // guaranteeing that there is at least one allocated byte for empty strings.
@@ -201,6 +522,161 @@ void trim_index_suffix(const char *key_start, const char **stop)
     }
 }
 
+// Number of slots in the key cache. The table is kept at most half full,
+// so at most JSON_KEY_CACHE_MAX_KEYS distinct keys are cached per parse state,
+// the key set of json records is small. Later keys are checked every time.
+#define JSON_KEY_CACHE_SIZE 1024
+#define JSON_KEY_CACHE_MAX_KEYS (JSON_KEY_CACHE_SIZE/2)
+
+size_t hash_json_key(const char *start, const char *stop)
+{
+    size_t hash = 0;
+    for (const char *i = start; i < stop; ++i)
+    {
+        hash = (unsigned char)*i + (hash << 6) + (hash << 16) - hash; // sdbm, like hash_code.
+    }
+    return hash;
+}
+
+/**
+    lookup_json_key:
+    @kc: The key cache.
+    @start: Start of the raw key bytes.
+    @stop: Points to byte after the raw key.
+
+    Find the key in the cache or add it, trimming the index suffix and checking
+    the element name only once per distinct key. Returns NULL when the cache is full.
+*/
+XMQJsonKey *lookup_json_key(XMQJsonKeyCache *kc, const char *start, const char *stop)
+{
+    if (!kc->slots)
+    {
+        kc->slots = (XMQJsonKey*)calloc(JSON_KEY_CACHE_SIZE, sizeof(XMQJsonKey));
+        kc->size = JSON_KEY_CACHE_SIZE;
+        kc->used = 0;
+    }
+
+    size_t len = stop-start;
+    size_t hash = hash_json_key(start, stop);
+    size_t mask = kc->size-1;
+    size_t pos = hash & mask;
+
+    for (;;)
+    {
+        XMQJsonKey *key = kc->slots + pos;
+        if (key->raw == NULL) break;
+        if (key->hash == hash && key->raw_len == len && !memcmp(key->raw, start, len)) return key;
+        pos = (pos + 1) & mask;
+    }
+
+    // Keep the table at most half full, later keys are not cached.
+    if (kc->used >= JSON_KEY_CACHE_MAX_KEYS) return NULL;
+
+    XMQJsonKey *key = kc->slots + pos;
+    key->raw = (char*)malloc(len+1);
+    memcpy(key->raw, start, len);
+    key->raw[len] = 0;
+    key->raw_len = len;
+    key->hash = hash;
+
+    const char *name_stop = key->raw+len;
+    trim_index_suffix(key->raw, &name_stop);
+    key->name_len = name_stop-key->raw;
+
+    const char *colon = NULL;
+    key->safe = key->name_len > 0 && is_xmq_element_name(key->raw, name_stop, &colon);
+    key->colon = (key->safe && colon) ? (size_t)(colon-key->raw) : 0;
+    kc->used++;
+
+    return key;
+}
+
+void free_json_key_cache(XMQJsonKeyCache *kc)
+{
+    if (!kc->slots) return;
+    for (size_t i = 0; i < kc->size; ++i) free(kc->slots[i].raw);
+    free(kc->slots);
+    kc->slots = NULL;
+    kc->size = 0;
+    kc->used = 0;
+}
+
+/**
+    json_key_name:
+    @state: The parse state.
+    @key_start: The json key or NULL.
+    @key_stop: Points to after the key, the [n] index suffix is trimmed off.
+    @colon: Set to the namespace colon or NULL.
+
+    Returns true if the key, without index suffix, is a valid element name.
+    A key found by eat_json_key in the key cache is resolved without looking at its bytes again.
+*/
+bool json_key_name(XMQParseState *state, const char *key_start, const char **key_stop, const char **colon)
+{
+    *colon = NULL;
+
+    XMQJsonKey *key = state->json_key;
+    if (key && key_start == key->raw)
+    {
+        *key_stop = key_start+key->name_len;
+        if (key->colon) *colon = key_start+key->colon;
+        return key->safe;
+    }
+
+    trim_index_suffix(key_start, key_stop);
+    if (!key_start || key_start == *key_stop) return false;
+    return is_xmq_element_name(key_start, *key_stop, colon);
+}
+
+/**
+    eat_json_key:
+    @state: The parse state, state->i points to the quote starting the key.
+    @key_start: Set to the start of the key.
+    @key_stop: Set to the end of the key.
+
+    Eat the key of an object member. A key without escapes is looked up in the key cache
+    and points into the cache, or into the json buffer when the cache is full.
+    A key with escapes is decoded into a new buffer which is returned and must be freed
+    by the caller, otherwise NULL is returned.
+*/
+char *eat_json_key(XMQParseState *state, const char **key_start, const char **key_stop)
+{
+    const char *start = state->i+1;
+    size_t col = state->col+1;
+    const char *stop = json_index_string_end(state, state->i);
+    if (stop) col += count_json_chars(start, stop);
+    else stop = find_json_quote_special(start, state->buffer_stop, &col);
+
+    state->json_key = NULL;
+
+    if (stop >= state->buffer_stop || *stop != '"')
+    {
+        char *content_start = NULL;
+        char *content_stop = NULL;
+        eat_json_quote(state, &content_start, &content_stop);
+        *key_start = content_start;
+        *key_stop = content_stop;
+        return content_start;
+    }
+
+    state->i = stop+1;
+    state->col = col+1;
+
+    XMQJsonKey *key = lookup_json_key(&state->json_keys, start, stop);
+    if (key)
+    {
+        state->json_key = key;
+        *key_start = key->raw;
+        *key_stop = key->raw+key->raw_len;
+    }
+    else
+    {
+        *key_start = start;
+        *key_stop = stop;
+    }
+    return NULL;
+}
+
 void set_node_namespace(XMQParseState *state, xmlNodePtr node, const char *node_name)
 {
     if (state->element_namespace)
@@ -245,7 +721,8 @@ void parse_json_quote(XMQParseState *state, const char *key_start, const char *k
     eat_json_quote(state, &content_start, &content_stop);
     size_t content_len = content_stop-content_start;
 
-    trim_index_suffix(key_start, &key_stop);
+    const char *colon = NULL;
+    bool safe_key = json_key_name(state, key_start, &key_stop, &colon);
 
     if (key_start && *key_start == '|' && key_stop == key_start+1)
     {
@@ -335,7 +812,6 @@ void parse_json_quote(XMQParseState *state, const char *key_start, const char *k
 
     const char *unsafe_key_start = NULL;
     const char *unsafe_key_stop = NULL;
-    const char *colon = NULL;
 
     if (!key_start || key_start == key_stop)
     {
@@ -343,7 +819,7 @@ void parse_json_quote(XMQParseState *state, const char *key_start, const char *k
         key_start = underline;
         key_stop = underline+1;
     }
-    else if (!is_xmq_element_name(key_start, key_stop, &colon))
+    else if (!safe_key)
     {
         unsafe_key_start = key_start;
         unsafe_key_stop = key_stop;
@@ -452,8 +928,7 @@ void parse_json_null(XMQParseState *state, const char *key_start, const char *ke
     const char *unsafe_key_start = NULL;
     const char *unsafe_key_stop = NULL;
     const char *colon = NULL;
-
-    trim_index_suffix(key_start, &key_stop);
+    bool safe_key = json_key_name(state, key_start, &key_stop, &colon);
 
     if (key_start && *key_start == '_' && key_stop > key_start+1)
     {
@@ -470,7 +945,7 @@ void parse_json_null(XMQParseState *state, const char *key_start, const char *ke
         key_start = underline;
         key_stop = underline+1;
     }
-    else if (!is_xmq_element_name(key_start, key_stop, &colon))
+    else if (!safe_key)
     {
         unsafe_key_start = key_start;
         unsafe_key_stop = key_stop;
@@ -495,7 +970,9 @@ void parse_json_null(XMQParseState *state, const char *key_start, const char *ke
         DO_CALLBACK_SIM(apar_right, state, state->line, state->col, rightpar, rightpar+1, rightpar+1);
     }
 
+    state->json_literal = true;
     DO_CALLBACK(element_value_text, state, start_line, start_col, start, stop, stop);
+    state->json_literal = false;
 }
 
 bool has_number_ended(char c)
@@ -503,74 +980,83 @@ bool has_number_ended(char c)
     return c == ' ' || c == '\n' || c == ',' || c == '}' || c == ']';
 }
 
-const char *is_jnumber(const char *start, const char *stop)
-{
-    if (stop == NULL) stop = start+strlen(start);
-    if (start == stop) return NULL;
+// Character classes and states for the json number grammar
+// -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+enum { JC_OTHER, JC_ZERO, JC_DIGIT, JC_MINUS, JC_PLUS, JC_DOT, JC_E, JC_NUM_CLASSES };
+enum { JN_FAIL, JN_START, JN_MINUS, JN_ZERO, JN_INT, JN_DOT, JN_FRAC, JN_E, JN_E_SIGN, JN_EXP, JN_NUM_STATES };
 
-    bool found_e = false;
-    bool found_e_sign = false;
-    bool leading_zero = false;
-    bool last_is_digit = false;
-    bool found_dot = false;
+// 1 is 0, 2 is 1-9, 3 is -, 4 is +, 5 is . and 6 is e E
+static const unsigned char json_number_classes[256] =
+{
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,4,0,3,5,0,
+    1,2,2,2,2,2,2,2,2,2,0,0,0,0,0,0,
+    0,0,0,0,0,6,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,6,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+};
+
+static const unsigned char json_number_transitions[JN_NUM_STATES][JC_NUM_CLASSES] =
+{
+    // OTHER  ZERO     DIGIT    MINUS      PLUS       DOT      E
+    { JN_FAIL, JN_FAIL, JN_FAIL, JN_FAIL,   JN_FAIL,   JN_FAIL, JN_FAIL }, // JN_FAIL
+    { JN_FAIL, JN_ZERO, JN_INT,  JN_MINUS,  JN_FAIL,   JN_FAIL, JN_FAIL }, // JN_START
+    { JN_FAIL, JN_ZERO, JN_INT,  JN_FAIL,   JN_FAIL,   JN_FAIL, JN_FAIL }, // JN_MINUS
+    { JN_FAIL, JN_FAIL, JN_FAIL, JN_FAIL,   JN_FAIL,   JN_DOT,  JN_E },    // JN_ZERO
+    { JN_FAIL, JN_INT,  JN_INT,  JN_FAIL,   JN_FAIL,   JN_DOT,  JN_E },    // JN_INT
+    { JN_FAIL, JN_FRAC, JN_FRAC, JN_FAIL,   JN_FAIL,   JN_FAIL, JN_FAIL }, // JN_DOT
+    { JN_FAIL, JN_FRAC, JN_FRAC, JN_FAIL,   JN_FAIL,   JN_FAIL, JN_E },    // JN_FRAC
+    { JN_FAIL, JN_EXP,  JN_EXP,  JN_E_SIGN, JN_E_SIGN, JN_FAIL, JN_FAIL }, // JN_E
+    { JN_FAIL, JN_EXP,  JN_EXP,  JN_FAIL,   JN_FAIL,   JN_FAIL, JN_FAIL }, // JN_E_SIGN
+    { JN_FAIL, JN_EXP,  JN_EXP,  JN_FAIL,   JN_FAIL,   JN_FAIL, JN_FAIL }, // JN_EXP
+};
+
+static const bool json_number_accepting[JN_NUM_STATES] =
+{
+    false, false, false, true, true, false, true, false, false, true
+};
+
+/**
+    scan_jnumber:
+    @i: Start of the number.
+    @stop: Stop scanning here, or NULL to scan a zero terminated string.
+
+    Run the json number grammar as far as possible.
+    Returns a pointer after the longest valid number or NULL if there is none.
+*/
+const char *scan_jnumber(const char *i, const char *stop)
+{
+    int state = JN_START;
 
-    const char *i;
-    for (i = start; i < stop; ++i)
+    // A zero byte is JC_OTHER which always fails, which ends zero terminated strings.
+    while (i != stop)
     {
-        char c = *i;
-
-        last_is_digit = false;
-        bool current_is_not_digit = (c < '0' || c > '9');
-
-        if (i == start)
-        {
-            if (current_is_not_digit && c != '-' ) return NULL;
-            if (c == '0') leading_zero = true;
-            if (c != '-') last_is_digit = true;
-            continue;
-        }
-
-        if (leading_zero)
-        {
-            leading_zero = false;
-            if (has_number_ended(c)) return i;
-            if (c != '.') return NULL;
-            found_dot = true;
-        }
-        else if (c == '.')
-        {
-            if (found_dot) return NULL;
-            found_dot = true;
-        }
-        else if (c == 'e' || c == 'E')
-        {
-            if (found_e) return NULL;
-            found_e = true;
-        }
-        else if (found_e && !found_e_sign)
-        {
-            if (has_number_ended(c)) return i;
-            if (current_is_not_digit && c != '-' && c != '+') return NULL;
-            if (c == '+' || c == '-')
-            {
-                found_e_sign = true;
-            }
-            else
-            {
-                last_is_digit = true;
-            }
-        }
-        else
-        {
-            found_e_sign = false;
-            if (has_number_ended(c)) return i;
-            if (current_is_not_digit) return NULL;
-            last_is_digit = true;
-        }
+        int next = json_number_transitions[state][json_number_classes[(unsigned char)*i]];
+        if (next == JN_FAIL) break;
+        state = next;
+        i++;
     }
 
-    if (last_is_digit == false) return NULL;
+    return json_number_accepting[state] ? i : NULL;
+}
+
+const char *is_jnumber(const char *start, const char *stop)
+{
+    if (stop == NULL) stop = start+strlen(start);
 
+    const char *i = scan_jnumber(start, stop);
+    if (i == NULL) return NULL;
+    if (i < stop && !has_number_ended(*i)) return NULL;
     return i;
 }
 
@@ -624,8 +1110,7 @@ void parse_json_boolean(XMQParseState *state, const char *key_start, const char
     const char *unsafe_key_start = NULL;
     const char *unsafe_key_stop = NULL;
     const char *colon = NULL;
-
-    trim_index_suffix(key_start, &key_stop);
+    bool safe_key = json_key_name(state, key_start, &key_stop, &colon);
 
     if (!key_start || key_start == key_stop)
     {
@@ -633,7 +1118,7 @@ void parse_json_boolean(XMQParseState *state, const char *key_start, const char
         key_start = underline;
         key_stop = underline+1;
     }
-    else if (!is_xmq_element_name(key_start, key_stop, &colon))
+    else if (!safe_key)
     {
         unsafe_key_start = key_start;
         unsafe_key_stop = key_stop;
@@ -658,12 +1143,16 @@ void parse_json_boolean(XMQParseState *state, const char *key_start, const char
         DO_CALLBACK_SIM(apar_right, state, state->line, state->col, rightpar, rightpar+1, rightpar+1);
     }
 
+    state->json_literal = true;
     DO_CALLBACK(element_value_text, state, start_line, start_col, start, stop, stop);
+    state->json_literal = false;
 }
 
 bool is_json_number(XMQParseState *state)
 {
-    return NULL != is_jnumber(state->i, state->buffer_stop);
+    // Only check the first character, eat_json_number validates the whole number.
+    char c = *(state->i);
+    return c == '-' || (c >= '0' && c <= '9');
 }
 
 void eat_json_number(XMQParseState *state)
@@ -675,7 +1164,11 @@ void eat_json_number(XMQParseState *state)
     size_t col = state->col;
 
     const char *end = is_jnumber(i, stop);
-    assert(end); // Must not call eat_json_number without check for a number before...
+    if (!end)
+    {
+        state->error_nr = XMQ_ERROR_JSON_INVALID_CHAR;
+        longjmp(state->error_handler, 1);
+    }
     increment('?', end-start, &i, &line, &col);
 
     state->i = i;
@@ -695,8 +1188,7 @@ void parse_json_number(XMQParseState *state, const char *key_start, const char *
     const char *unsafe_key_start = NULL;
     const char *unsafe_key_stop = NULL;
     const char *colon = NULL;
-
-    trim_index_suffix(key_start, &key_stop);
+    bool safe_key = json_key_name(state, key_start, &key_stop, &colon);
 
     if (!key_start || key_start == key_stop)
     {
@@ -704,7 +1196,7 @@ void parse_json_number(XMQParseState *state, const char *key_start, const char *
         key_start = underline;
         key_stop = underline+1;
     }
-    else if (!is_xmq_element_name(key_start, key_stop, &colon))
+    else if (!safe_key)
     {
         unsafe_key_start = key_start;
         unsafe_key_stop = key_stop;
@@ -729,10 +1221,48 @@ void parse_json_number(XMQParseState *state, const char *key_start, const char *
         DO_CALLBACK_SIM(apar_right, state, state->line, state->col, rightpar, rightpar+1, rightpar+1);
     }
 
+    state->json_literal = true;
     DO_CALLBACK(element_value_text, state, start_line, start_col, start, stop, stop);
+    state->json_literal = false;
+}
+
+/**
+    json_record_is_complete:
+    @start: Start of the json record.
+    @stop: Points to byte after the record.
+
+    Check that every string is terminated and that every opened object or array
+    is closed before stop. A json lines record must fit on a single line,
+    a record continued on the next line is incomplete.
+*/
+bool json_record_is_complete(const char *start, const char *stop)
+{
+    size_t depth = 0;
+    bool in_string = false;
+
+    for (const char *i = start; i < stop; ++i)
+    {
+        char c = *i;
+        if (in_string)
+        {
+            if (c == '\\') i++;
+            else if (c == '"') in_string = false;
+            continue;
+        }
+        if (c == '"') in_string = true;
+        else if (c == '{' || c == '[') depth++;
+        else if ((c == '}' || c == ']') && depth > 0) depth--;
+    }
+
+    return !in_string && depth == 0;
 }
 
 bool xmq_tokenize_buffer_json(XMQParseState *state, const char *start, const char *stop)
+{
+    return xmq_tokenize_json_record(state, start, stop, 1);
+}
+
+bool xmq_tokenize_json_record(XMQParseState *state, const char *start, const char *stop, size_t line)
 {
     if (state->magic_cookie != MAGIC_COOKIE)
     {
@@ -744,12 +1274,19 @@ bool xmq_tokenize_buffer_json(XMQParseState *state, const char *start, const cha
     state->buffer_start = start;
     state->buffer_stop = stop;
     state->i = start;
-    state->line = 1;
+    state->line = line;
     state->col = 1;
     state->error_nr = XMQ_OK;
 
     if (state->parse->init) state->parse->init(state);
 
+    if (state->json_use_index && !build_json_index(state, start, stop))
+    {
+        free(state->json_index);
+        state->json_index = NULL;
+        state->json_index_capacity = 0;
+    }
+
     if (!setjmp(state->error_handler))
     {
         parse_json(state, NULL, NULL);
@@ -774,13 +1311,15 @@ void parse_json_array(XMQParseState *state, const char *key_start, const char *k
 {
     char c = *state->i;
     assert(c == '[');
+    const char *body_start = state->i;
+    size_t body_start_line = state->line;
+    size_t body_start_col = state->col;
     increment(c, 1, &state->i, &state->line, &state->col);
 
     const char *unsafe_key_start = NULL;
     const char *unsafe_key_stop = NULL;
     const char *colon = NULL;
-
-    trim_index_suffix(key_start, &key_stop);
+    bool safe_key = json_key_name(state, key_start, &key_stop, &colon);
 
     if (!key_start || key_start == key_stop)
     {
@@ -788,7 +1327,7 @@ void parse_json_array(XMQParseState *state, const char *key_start, const char *k
         key_start = underline;
         key_stop = underline+1;
     }
-    else if (!is_xmq_element_name(key_start, key_stop, &colon))
+    else if (!safe_key)
     {
         unsafe_key_start = key_start;
         unsafe_key_stop = key_stop;
@@ -819,7 +1358,7 @@ void parse_json_array(XMQParseState *state, const char *key_start, const char *k
 
     while (state->i < stop && c == ',')
     {
-        eat_xml_whitespace(state, NULL, NULL);
+        eat_json_whitespace(state);
         c = *(state->i);
         if (c == ']') break;
 
@@ -828,7 +1367,20 @@ void parse_json_array(XMQParseState *state, const char *key_start, const char *k
         if (c == ',') increment(c, 1, &state->i, &state->line, &state->col);
     }
 
-    assert(c == ']');
+    if (state->i >= stop)
+    {
+        // Point the error at the unclosed bracket.
+        state->last_body_start = body_start;
+        state->last_body_start_line = body_start_line;
+        state->last_body_start_col = body_start_col;
+        state->error_nr = XMQ_ERROR_BODY_NOT_CLOSED;
+        longjmp(state->error_handler, 1);
+    }
+    if (c != ']')
+    {
+        state->error_nr = XMQ_ERROR_JSON_INVALID_CHAR;
+        longjmp(state->error_handler, 1);
+    }
     increment(c, 1, &state->i, &state->line, &state->col);
 
     DO_CALLBACK_SIM(brace_right, state, state->line, state->col, rightbrace, rightbrace+1, rightbrace+1);
@@ -836,7 +1388,7 @@ void parse_json_array(XMQParseState *state, const char *key_start, const char *k
 
 void parse_json(XMQParseState *state, const char *key_start, const char *key_stop)
 {
-    eat_xml_whitespace(state, NULL, NULL);
+    eat_json_whitespace(state);
 
     char c = *(state->i);
 
@@ -851,7 +1403,7 @@ void parse_json(XMQParseState *state, const char *key_start, const char *key_sto
         state->error_nr = XMQ_ERROR_JSON_INVALID_CHAR;
         longjmp(state->error_handler, 1);
     }
-    eat_xml_whitespace(state, NULL, NULL);
+    eat_json_whitespace(state);
 }
 
 typedef struct
@@ -860,202 +1412,670 @@ typedef struct
     size_t used;
 } Counter;
 
-void json_print_object_nodes(XMQPrintState *ps, xmlNode *container, xmlNode *from, xmlNode *to)
-{
-    xmlNode *i = from;
+/**
+    JsonObjectRun:
+    @container: The object containing the siblings.
+    @counters: The total and used number of each sibling's key, indexed by sibling position.
+
+    Passed to json_print_object_run when printing an object's members in parallel.
+*/
+typedef struct
+{
+    xmlNode *container;
+    Counter *counters;
+} JsonObjectRun;
+
+size_t json_push_key_table(XMQJsonKeyTables *kt, size_t num_keys)
+{
+    // Keep the table at most half full.
+    size_t capacity = 8;
+    while (capacity < 2*num_keys) capacity *= 2;
+
+    if (kt->top + capacity > kt->size)
+    {
+        size_t size = kt->size ? kt->size : 256;
+        while (size < kt->top + capacity) size *= 2;
+        kt->slots = (XMQJsonKeyCount*)realloc(kt->slots, size * sizeof(XMQJsonKeyCount));
+        kt->size = size;
+    }
+
+    size_t base = kt->top;
+    memset(kt->slots + base, 0, capacity * sizeof(XMQJsonKeyCount));
+    kt->top += capacity;
+    return base;
+}
+
+size_t json_key_slot(XMQJsonKeyTables *kt, size_t base, const char *name)
+{
+    XMQJsonKeyCount *table = kt->slots + base;
+    size_t mask = kt->top - base - 1;
+    size_t pos = hash_code(name) & mask;
+
+    for (;;)
+    {
+        XMQJsonKeyCount *k = table + pos;
+        if (k->name == NULL)
+        {
+            k->name = name;
+            return pos;
+        }
+        if (k->name == name || !strcmp(k->name, name)) return pos;
+        pos = (pos + 1) & mask;
+    }
+}
+
+void json_print_object_nodes(XMQPrintState *ps, xmlNode *container, xmlNode *from, xmlNode *to)
+{
+    xmlNode *stop = to ? xml_next_sibling(to) : NULL;
+    size_t num_nodes = 0;
+
+    for (xmlNode *i = from; i != stop; i = xml_next_sibling(i)) num_nodes++;
+
+    if (num_nodes == 1)
+    {
+        // A single key cannot be repeated.
+        json_print_node(ps, container, from, 1, 0);
+        return;
+    }
+
+    // Count the keys in a table pushed on the scratch tables of this print.
+    // A nested object pushes its table above this one and the slots may
+    // move when they grow, so the table is always accessed through its base.
+    XMQJsonKeyTables *kt = &ps->json_keys;
+    size_t base = json_push_key_table(kt, num_nodes);
+
+    for (xmlNode *i = from; i != stop; i = xml_next_sibling(i))
+    {
+        const char *name = (const char*)i->name;
+        if (name && strcmp(name, "_")) // We have a name and it is NOT a single _
+        {
+            kt->slots[base + json_key_slot(kt, base, name)].total++;
+        }
+    }
+
+    if (ps->output_settings->print_threads > 1 && num_nodes >= XMQ_PARALLEL_PRINT_MIN_NODES)
+    {
+        // Resolve the key counters of each sibling up front, so that any run of siblings can be printed independently.
+        JsonObjectRun run;
+        run.container = container;
+        run.counters = (Counter*)malloc(num_nodes * sizeof(Counter));
+        Counter *rc = run.counters;
+        for (xmlNode *i = from; i != stop; i = xml_next_sibling(i), rc++)
+        {
+            const char *name = (const char*)i->name;
+            if (name && strcmp(name, "_"))
+            {
+                XMQJsonKeyCount *k = kt->slots + base + json_key_slot(kt, base, name);
+                rc->total = k->total;
+                rc->used = k->used++;
+            }
+            else
+            {
+                rc->total = 1;
+                rc->used = 0;
+            }
+        }
+        if (!print_nodes_parallel(ps, from, stop, false, false, json_print_object_run, &run))
+        {
+            json_print_object_run(ps, &run, from, stop, 0, 0, NULL);
+        }
+        free(run.counters);
+        kt->top = base;
+        return;
+    }
+
+    for (xmlNode *i = from; i != stop; i = xml_next_sibling(i))
+    {
+        const char *name = (const char*)i->name;
+        if (name && strcmp(name, "_"))
+        {
+            size_t slot = base + json_key_slot(kt, base, name);
+            size_t total = kt->slots[slot].total;
+            size_t used = kt->slots[slot].used;
+            json_print_node(ps, container, i, total, used);
+            kt->slots[slot].used++;
+        }
+        else
+        {
+            json_print_node(ps, container, i, 1, 0);
+        }
+    }
+
+    kt->top = base;
+}
+
+void json_print_object_run(XMQPrintState *ps,
+                           void *data,
+                           xmlNode *from,
+                           xmlNode *stop,
+                           size_t from_index,
+                           size_t align,
+                           xmlNode *restart_find_at_node)
+{
+    JsonObjectRun *run = (JsonObjectRun*)data;
+    Counter *c = run->counters + from_index;
+
+    for (xmlNode *i = from; i != stop; i = xml_next_sibling(i), c++)
+    {
+        json_print_node(ps, run->container, i, c->total, c->used);
+    }
+}
+
+void json_print_array_nodes(XMQPrintState *ps, xmlNode *container, xmlNode *from, xmlNode *to)
+{
+    if (print_nodes_parallel(ps, from, NULL, false, false, json_print_array_run, NULL)) return;
+
+    json_print_array_run(ps, NULL, from, NULL, 0, 0, NULL);
+}
+
+void json_print_array_run(XMQPrintState *ps,
+                          void *data,
+                          xmlNode *from,
+                          xmlNode *stop,
+                          size_t from_index,
+                          size_t align,
+                          xmlNode *restart_find_at_node)
+{
+    xmlNode *i = from;
+    while (i != stop)
+    {
+        json_check_comma(ps);
+        bool force_string = xml_get_attribute(i, "S");
+        if (force_string || json_is_literal_node(ps, i))
+        {
+            json_print_value(ps, xml_first_child(i), xml_last_child(i), LEVEL_ELEMENT_VALUE, force_string);
+        }
+        else
+        {
+            json_print_node(ps, NULL, i, 1, 0);
+        }
+        i = xml_next_sibling(i);
+    }
+}
+
+/**
+    json_print_lines:
+    @from: First root node to print.
+    @to: Last root node to print.
+
+    Print json lines, ie one compact record per line. A root array is split
+    into its members, so that a json array and json lines can be converted
+    back and forth. Anything else becomes a single record.
+*/
+void json_print_lines(XMQPrintState *ps, xmlNode *from, xmlNode *to)
+{
+    XMQOutputSettings *output_settings = ps->output_settings;
+    XMQWrite write = output_settings->content.write;
+    void *writer_state = output_settings->content.writer_state;
+
+    if (from == to &&
+        ps->pre_nodes->size == 0 &&
+        ps->post_nodes->size == 0 &&
+        is_element_node(from) &&
+        !strcmp(xml_element_name(from), "_") &&
+        xml_get_attribute(from, "A") &&
+        !has_attr_other_than_AS_(from))
+    {
+        for (xmlNode *i = xml_first_child(from); i; i = xml_next_sibling(i))
+        {
+            ps->last_char = 0;
+            json_print_array_run(ps, NULL, i, xml_next_sibling(i), 0, 0, NULL);
+            write(writer_state, "\n", NULL);
+        }
+        return;
+    }
+
+    json_print_object_nodes(ps, NULL, from, to);
+    write(writer_state, "\n", NULL);
+}
+
+bool has_attr_other_than_AS_(xmlNode *node)
+{
+    xmlAttr *a = xml_first_attribute(node);
+
+    while (a)
+    {
+        if (strcmp((const char*)a->name, "A") &&
+            strcmp((const char*)a->name, "S") &&
+            strcmp((const char*)a->name, "_")) return true;
+        a = a->next;
+    }
+
+    return false;
+}
+
+void json_print_node(XMQPrintState *ps, xmlNode *container, xmlNode *node, size_t total, size_t used)
+{
+    // This is a comment translated into "//":"Comment text"
+    if (is_comment_node(node))
+    {
+        json_print_comment_node(ps, node, false, total, used);
+        return;
+    }
+
+    // Standalone quote must be quoted: 'word' 'some words'
+    if (is_content_node(node))
+    {
+        json_print_standalone_quote(ps, container, node, total, used);
+        return;
+    }
+
+    // This is an entity reference node. &something;
+    if (is_entity_node(node))
+    {
+        json_print_entity_node(ps, node);
+        return;
+    }
+
+    // This is a node with no children, but the only such valid json nodes are
+    // the empty object _ ---> {} or _(A) ---> [].
+    if (is_leaf_node(node) && container)
+    {
+        return json_print_leaf_node(ps, container, node, total, used);
+    }
+
+    // This is a key = value or key = 'value value' or key = ( 'value' &#10; )
+    // Also! If the node has attributes, then we cannot print as key value in json.
+    // It has to be an object.
+    if (is_key_value_node(node) &&
+        (!has_attributes(node) ||
+         !has_attr_other_than_AS_(node)))
+    {
+        bool force_string = xml_get_attribute(node, "S");
+        return json_print_key_node(ps, container, node, total, used, force_string);
+    }
+
+    // The node is marked foo(A) { } translate this into: "foo":[ ]
+    if (xml_get_attribute(node, "A"))
+    {
+        const char *name = xml_element_name(node);
+        bool is_underline = (name[0] == '_' && name[1] == 0);
+        bool has_attr = has_attr_other_than_AS_(node);
+        if (!is_underline && !container)
+        {
+            // The xmq "alfa(A) { _=hello _=there }" translates into
+            // the json ["hello","there"] and there is no sensible
+            // way of storing the alfa element name. Fixable?
+            PRINT_WARNING("xmq: Warning! The element name \"%s\" is lost when converted to an unnamed json array!\n", name);
+        }
+        if (has_attr)
+        {
+            // The xmq "_(A beta=123) { _=hello _=there }" translates into
+            // the json ["hello","there"] and there is no sensible
+            // way of storing the beta attribute. Fixable?
+            PRINT_WARNING("xmq: Warning! The element \"%s\" loses its attributes when converted to a json array!\n", name);
+        }
+        return json_print_array_with_children(ps, container, node);
+    }
+
+    // All other nodes are printed
+    json_print_element_with_children(ps, container, node, total, used);
+}
+
+void parse_json_object(XMQParseState *state, const char *key_start, const char *key_stop)
+{
+    char c = *state->i;
+    assert(c == '{');
+    const char *body_start = state->i;
+    size_t body_start_line = state->line;
+    size_t body_start_col = state->col;
+    increment(c, 1, &state->i, &state->line, &state->col);
+
+    const char *unsafe_key_start = NULL;
+    const char *unsafe_key_stop = NULL;
+    const char *colon = NULL;
+    bool safe_key = json_key_name(state, key_start, &key_stop, &colon);
+
+    if (!key_start || key_start == key_stop)
+    {
+        // No key and the empty key translates into a _
+        key_start = underline;
+        key_stop = underline+1;
+    }
+    else if (!safe_key)
+    {
+        unsafe_key_start = key_start;
+        unsafe_key_stop = key_stop;
+        key_start = underline;
+        key_stop = underline+1;
+    }
+
+    if (!unsafe_key_start && colon)
+    {
+        DO_CALLBACK_SIM(element_ns, state, state->line, state->col, key_start, colon, colon);
+        key_start = colon+1;
+    }
+    DO_CALLBACK_SIM(element_key, state, state->line, state->col, colon?colon+1:key_start, key_stop, key_stop);
+    if (unsafe_key_start)
+    {
+        DO_CALLBACK_SIM(apar_left, state, state->line, state->col, leftpar, leftpar+1, leftpar+1);
+        DO_CALLBACK_SIM(attr_key, state, state->line, state->col, underline, underline+1, underline+1);
+        DO_CALLBACK_SIM(attr_value_quote, state, state->line, state->col, unsafe_key_start, unsafe_key_stop, unsafe_key_stop);
+        DO_CALLBACK_SIM(apar_right, state, state->line, state->col, rightpar, rightpar+1, rightpar+1);
+    }
+
+    DO_CALLBACK_SIM(brace_left, state, state->line, state->col, leftbrace, leftbrace+1, leftbrace+1);
+
+    const char *stop = state->buffer_stop;
+
+    c = ',';
+
+    while (state->i < stop && c == ',')
+    {
+        eat_json_whitespace(state);
+        c = *(state->i);
+        if (c == '}') break;
+
+        if (!is_json_quote_start(c))
+        {
+            state->error_nr = XMQ_ERROR_JSON_INVALID_CHAR;
+            longjmp(state->error_handler, 1);
+        }
+
+        // Find the key string, ie speed in { "speed":123 }
+        const char *new_key_start = NULL;
+        const char *new_key_stop = NULL;
+        char *decoded_key = eat_json_key(state, &new_key_start, &new_key_stop);
+
+        eat_json_whitespace(state);
+        c = *(state->i);
+
+        if (c == ':')
+        {
+            increment(c, 1, &state->i, &state->line, &state->col);
+        }
+        else
+        {
+            state->error_nr = XMQ_ERROR_JSON_INVALID_CHAR;
+            longjmp(state->error_handler, 1);
+        }
+
+        parse_json(state, new_key_start, new_key_stop);
+        free(decoded_key);
+
+        c = *state->i;
+        if (c == ',') increment(c, 1, &state->i, &state->line, &state->col);
+    }
+
+    if (state->i >= stop)
+    {
+        // Point the error at the unclosed bracket.
+        state->last_body_start = body_start;
+        state->last_body_start_line = body_start_line;
+        state->last_body_start_col = body_start_col;
+        state->error_nr = XMQ_ERROR_BODY_NOT_CLOSED;
+        longjmp(state->error_handler, 1);
+    }
+    if (c != '}')
+    {
+        state->error_nr = XMQ_ERROR_JSON_INVALID_CHAR;
+        longjmp(state->error_handler, 1);
+    }
+    increment(c, 1, &state->i, &state->line, &state->col);
+
+    DO_CALLBACK_SIM(brace_right, state, state->line, state->col, rightbrace, rightbrace+1, rightbrace+1);
+}
+
+/**
+    xmq_transcode_json_to_xmq:
+    @state: Parse state used for scanning the json.
+    @ps: Print state for the compact xmq output.
+    @start: Start of json buffer.
+    @stop: Points to byte after the json buffer.
+
+    Print compact xmq directly from the json tokens without building a dom.
+    The output is identical to parsing into a dom and printing it with the compact printer.
+    Returns false if the json is invalid or uses a key that needs the dom
+    to be restructured (attributes, namespaces, comments, element renames),
+    the caller should then use the dom path.
+*/
+bool xmq_transcode_json_to_xmq(XMQParseState *state, XMQPrintState *ps, const char *start, const char *stop)
+{
+    state->buffer_start = start;
+    state->buffer_stop = stop;
+    state->i = start;
+    state->line = 1;
+    state->col = 1;
+    state->error_nr = XMQ_OK;
+    state->json_transcode_strings = stack_create();
+
+    bool ok = true;
+    if (!setjmp(state->error_handler))
+    {
+        transcode_json(state, ps, NULL, NULL);
+        if (state->i < state->buffer_stop)
+        {
+            state->error_nr = XMQ_ERROR_UNEXPECTED_CLOSING_BRACE;
+            longjmp(state->error_handler, 1);
+        }
+    }
+    else
+    {
+        // Free the strings held by the transcode functions that were jumped out of.
+        while (state->json_transcode_strings->size > 0) free(stack_pop(state->json_transcode_strings));
+        ok = false;
+    }
+
+    stack_free(state->json_transcode_strings);
+    state->json_transcode_strings = NULL;
+
+    return ok;
+}
+
+void transcode_json(XMQParseState *state, XMQPrintState *ps, const char *key_start, const char *key_stop)
+{
+    eat_xml_whitespace(state, NULL, NULL);
+
+    if (state->i >= state->buffer_stop)
+    {
+        state->error_nr = XMQ_ERROR_JSON_INVALID_CHAR;
+        longjmp(state->error_handler, 1);
+    }
+
+    char c = *(state->i);
+
+    if (is_json_quote_start(c)) transcode_json_quote(state, ps, key_start, key_stop);
+    else if (c == '{') transcode_json_object(state, ps, key_start, key_stop);
+    else if (c == '[') transcode_json_array(state, ps, key_start, key_stop);
+    else transcode_json_literal(state, ps, key_start, key_stop);
+
+    eat_xml_whitespace(state, NULL, NULL);
+}
+
+void transcode_json_needs_dom(XMQParseState *state)
+{
+    state->error_nr = XMQ_ERROR_CANNOT_HANDLE_JSON;
+    longjmp(state->error_handler, 1);
+}
+
+/**
+    transcode_json_hold:
+    @state: The parse state.
+    @s: A malloced string or NULL.
+
+    Remember the string until it is released, so that it can be freed if a longjmp
+    leaves the function holding it. The strings are released in reverse order.
+*/
+char *transcode_json_hold(XMQParseState *state, char *s)
+{
+    if (s) stack_push(state->json_transcode_strings, s);
+    return s;
+}
+
+void transcode_json_release(XMQParseState *state, char *s)
+{
+    if (!s) return;
+    void *top = stack_pop(state->json_transcode_strings);
+    assert(top == s);
+    free(top);
+}
+
+/**
+    transcode_json_name:
+    @key_start: The json key or NULL.
+    @key_stop: Points to after the key.
+    @string_type: Add the S attribute, the value is a string that looks like a number or keyword.
+    @array_type: Add the A attribute, the value is an array.
+
+    Print the element name and attributes exactly as parse_json_* would create them.
+    Keys that are stored as attributes or namespaces are handed over to the dom path.
+*/
+void transcode_json_name(XMQParseState *state, XMQPrintState *ps, const char *key_start, const char *key_stop, bool string_type, bool array_type)
+{
+    XMQWrite write = ps->output_settings->content.write;
+    void *writer_state = ps->output_settings->content.writer_state;
+
+    const char *unsafe_key_start = NULL;
+    const char *unsafe_key_stop = NULL;
+    const char *colon = NULL;
+
+    if (!key_start || key_start == key_stop)
+    {
+        key_start = underline;
+        key_stop = underline+1;
+    }
+    else if (!is_xmq_element_name(key_start, key_stop, &colon))
+    {
+        unsafe_key_start = key_start;
+        unsafe_key_stop = key_stop;
+        key_start = underline;
+        key_stop = underline+1;
+    }
+    else if (colon)
+    {
+        transcode_json_needs_dom(state);
+    }
+
+    if (need_separation_before_element_name(ps)) write(writer_state, " ", NULL);
+    compact_print_text(ps, key_start, key_stop);
 
-    HashMap* map = hashmap_create(100);
+    if (!unsafe_key_start && !string_type && !array_type) return;
 
-    while (i)
+    write(writer_state, "(", NULL);
+    ps->last_char = '(';
+    if (unsafe_key_start)
     {
-        const char *name = (const char*)i->name;
-        if (name && strcmp(name, "_")) // We have a name and it is NOT a single _
-        {
-            Counter *c = (Counter*)hashmap_get(map, name);
-            if (!c)
-            {
-                c = (Counter*)malloc(sizeof(Counter));
-                memset(c, 0, sizeof(Counter));
-                hashmap_put(map, name, c);
-            }
-            c->total++;
-        }
-        if (i == to) break;
-        i = xml_next_sibling(i);
+        compact_print_text(ps, underline, underline+1);
+        write(writer_state, "=", NULL);
+        ps->last_char = '=';
+        transcode_json_value(ps, unsafe_key_start, unsafe_key_stop, LEVEL_ATTR_VALUE);
     }
-
-    i = from;
-    while (i)
+    if (string_type || array_type)
     {
-        const char *name = (const char*)i->name;
-        if (name && strcmp(name, "_"))
-        {
-            Counter *c = (Counter*)hashmap_get(map, (const char*)i->name);
-            json_print_node(ps, container, i, c->total, c->used);
-            c->used++;
-        }
-        else
-        {
-            json_print_node(ps, container, i, 1, 0);
-        }
-        if (i == to) break;
-        i = xml_next_sibling(i);
+        if (need_separation_before_attribute_key(ps)) write(writer_state, " ", NULL);
+        compact_print_text(ps, string_type ? string : array, NULL);
     }
-
-    hashmap_free_and_values(map, free);
+    write(writer_state, ")", NULL);
+    ps->last_char = ')';
 }
 
-void json_print_array_nodes(XMQPrintState *ps, xmlNode *container, xmlNode *from, xmlNode *to)
+void transcode_json_value(XMQPrintState *ps, const char *start, const char *stop, Level level)
 {
-    xmlNode *i = from;
-    while (i)
+    if (is_compact_text_value(ps, start, stop))
     {
-        json_check_comma(ps);
-        bool force_string = xml_get_attribute(i, "S");
-        bool is_number = xml_element_content(i) && json_is_number(xml_element_content(i));
-        bool is_keyword = xml_element_content(i) && json_is_keyword(xml_element_content(i));
-
-        if (force_string || is_number || is_keyword)
-        {
-            json_print_value(ps, xml_first_child(i), xml_last_child(i), LEVEL_ELEMENT_VALUE, force_string);
-        }
-        else
-        {
-            json_print_node(ps, NULL, i, 1, 0);
-        }
-        i = xml_next_sibling(i);
+        compact_print_text(ps, start, stop);
+        return;
     }
+    print_value(ps, NULL, start, stop, level, false);
 }
 
-bool has_attr_other_than_AS_(xmlNode *node)
+void transcode_json_quote(XMQParseState *state, XMQPrintState *ps, const char *key_start, const char *key_stop)
 {
-    xmlAttr *a = xml_first_attribute(node);
+    char *content_start = NULL;
+    char *content_stop = NULL;
 
-    while (a)
-    {
-        if (strcmp((const char*)a->name, "A") &&
-            strcmp((const char*)a->name, "S") &&
-            strcmp((const char*)a->name, "_")) return true;
-        a = a->next;
-    }
+    eat_json_quote(state, &content_start, &content_stop);
+    transcode_json_hold(state, content_start);
+    size_t content_len = content_stop-content_start;
 
-    return false;
-}
+    trim_index_suffix(key_start, &key_stop);
 
-void json_print_node(XMQPrintState *ps, xmlNode *container, xmlNode *node, size_t total, size_t used)
-{
-    // This is a comment translated into "//":"Comment text"
-    if (is_comment_node(node))
+    if (key_start && key_start < key_stop &&
+        (*key_start == '_' || *key_start == '!' || *key_start == '|' ||
+         (key_stop == key_start+2 && *key_start == '/' && *(key_start+1) == '/')))
     {
-        json_print_comment_node(ps, node, false, total, used);
-        return;
+        // Attributes, element renames, doctype, text and comment nodes.
+        transcode_json_needs_dom(state);
     }
 
-    // Standalone quote must be quoted: 'word' 'some words'
-    if (is_content_node(node))
+    if (memchr(content_start, 0, content_len))
     {
-        json_print_standalone_quote(ps, container, node, total, used);
-        return;
+        // The dom stores zero terminated strings.
+        transcode_json_needs_dom(state);
     }
 
-    // This is an entity reference node. &something;
-    if (is_entity_node(node))
-    {
-        json_print_entity_node(ps, node);
-        return;
-    }
+    bool need_string_type =
+        content_len > 0 && (
+            (content_len == 4 && !strncmp(content_start, "true", 4)) ||
+            (content_len == 5 && !strncmp(content_start, "false", 5)) ||
+            (content_len == 4 && !strncmp(content_start, "null", 4)) ||
+            content_stop == is_jnumber(content_start, content_stop));
 
-    // This is a node with no children, but the only such valid json nodes are
-    // the empty object _ ---> {} or _(A) ---> [].
-    if (is_leaf_node(node) && container)
-    {
-        return json_print_leaf_node(ps, container, node, total, used);
-    }
+    transcode_json_name(state, ps, key_start, key_stop, need_string_type, false);
 
-    // This is a key = value or key = 'value value' or key = ( 'value' &#10; )
-    // Also! If the node has attributes, then we cannot print as key value in json.
-    // It has to be an object.
-    if (is_key_value_node(node) &&
-        (!has_attributes(node) ||
-         !has_attr_other_than_AS_(node)))
+    ps->output_settings->content.write(ps->output_settings->content.writer_state, "=", NULL);
+    ps->last_char = '=';
+    transcode_json_value(ps, content_start, content_stop, LEVEL_ELEMENT_VALUE);
+
+    transcode_json_release(state, content_start);
+}
+
+void transcode_json_literal(XMQParseState *state, XMQPrintState *ps, const char *key_start, const char *key_stop)
+{
+    const char *start = state->i;
+
+    bool is_null = is_json_null(state);
+    if (is_json_boolean(state)) eat_json_boolean(state);
+    else if (is_null) eat_json_null(state);
+    else if (is_json_number(state)) eat_json_number(state);
+    else
     {
-        bool force_string = xml_get_attribute(node, "S");
-        return json_print_key_node(ps, container, node, total, used, force_string);
+        state->error_nr = XMQ_ERROR_JSON_INVALID_CHAR;
+        longjmp(state->error_handler, 1);
     }
+    const char *stop = state->i;
 
-    // The node is marked foo(A) { } translate this into: "foo":[ ]
-    if (xml_get_attribute(node, "A"))
+    trim_index_suffix(key_start, &key_stop);
+
+    if (is_null && key_start && *key_start == '_' && key_stop > key_start+1)
     {
-        const char *name = xml_element_name(node);
-        bool is_underline = (name[0] == '_' && name[1] == 0);
-        bool has_attr = has_attr_other_than_AS_(node);
-        if (!is_underline && !container)
-        {
-            // The xmq "alfa(A) { _=hello _=there }" translates into
-            // the json ["hello","there"] and there is no sensible
-            // way of storing the alfa element name. Fixable?
-            PRINT_WARNING("xmq: Warning! The element name \"%s\" is lost when converted to an unnamed json array!\n", name);
-        }
-        if (has_attr)
-        {
-            // The xmq "_(A beta=123) { _=hello _=there }" translates into
-            // the json ["hello","there"] and there is no sensible
-            // way of storing the beta attribute. Fixable?
-            PRINT_WARNING("xmq: Warning! The element \"%s\" loses its attributes when converted to a json array!\n", name);
-        }
-        return json_print_array_with_children(ps, container, node);
+        // An attribute without value.
+        transcode_json_needs_dom(state);
     }
 
-    // All other nodes are printed
-    json_print_element_with_children(ps, container, node, total, used);
+    transcode_json_name(state, ps, key_start, key_stop, false, false);
+
+    ps->output_settings->content.write(ps->output_settings->content.writer_state, "=", NULL);
+    ps->last_char = '=';
+    transcode_json_value(ps, start, stop, LEVEL_ELEMENT_VALUE);
 }
 
-void parse_json_object(XMQParseState *state, const char *key_start, const char *key_stop)
+void transcode_json_object(XMQParseState *state, XMQPrintState *ps, const char *key_start, const char *key_stop)
 {
+    XMQWrite write = ps->output_settings->content.write;
+    void *writer_state = ps->output_settings->content.writer_state;
+
     char c = *state->i;
     assert(c == '{');
     increment(c, 1, &state->i, &state->line, &state->col);
 
-    const char *unsafe_key_start = NULL;
-    const char *unsafe_key_stop = NULL;
-    const char *colon = NULL;
-
     trim_index_suffix(key_start, &key_stop);
+    transcode_json_name(state, ps, key_start, key_stop, false, false);
 
-    if (!key_start || key_start == key_stop)
-    {
-        // No key and the empty key translates into a _
-        key_start = underline;
-        key_stop = underline+1;
-    }
-    else if (!is_xmq_element_name(key_start, key_stop, &colon))
-    {
-        unsafe_key_start = key_start;
-        unsafe_key_stop = key_stop;
-        key_start = underline;
-        key_stop = underline+1;
-    }
-
-    if (!unsafe_key_start && colon)
-    {
-        DO_CALLBACK_SIM(element_ns, state, state->line, state->col, key_start, colon, colon);
-        key_start = colon+1;
-    }
-    DO_CALLBACK_SIM(element_key, state, state->line, state->col, colon?colon+1:key_start, key_stop, key_stop);
-    if (unsafe_key_start)
+    eat_xml_whitespace(state, NULL, NULL);
+    if (state->i < state->buffer_stop && *state->i == '}')
     {
-        DO_CALLBACK_SIM(apar_left, state, state->line, state->col, leftpar, leftpar+1, leftpar+1);
-        DO_CALLBACK_SIM(attr_key, state, state->line, state->col, underline, underline+1, underline+1);
-        DO_CALLBACK_SIM(attr_value_quote, state, state->line, state->col, unsafe_key_start, unsafe_key_stop, unsafe_key_stop);
-        DO_CALLBACK_SIM(apar_right, state, state->line, state->col, rightpar, rightpar+1, rightpar+1);
+        // An empty object is a leaf node.
+        increment('}', 1, &state->i, &state->line, &state->col);
+        return;
     }
 
-    DO_CALLBACK_SIM(brace_left, state, state->line, state->col, leftbrace, leftbrace+1, leftbrace+1);
+    write(writer_state, "{", NULL);
+    ps->last_char = '{';
 
     const char *stop = state->buffer_stop;
 
     c = ',';
-
     while (state->i < stop && c == ',')
     {
         eat_xml_whitespace(state, NULL, NULL);
@@ -1068,36 +2088,83 @@ void parse_json_object(XMQParseState *state, const char *key_start, const char *
             longjmp(state->error_handler, 1);
         }
 
-        // Find the key string, ie speed in { "speed":123 }
-        char *new_key_start = NULL;
-        char *new_key_stop = NULL;
-        eat_json_quote(state, &new_key_start, &new_key_stop);
+        const char *new_key_start = NULL;
+        const char *new_key_stop = NULL;
+        char *decoded_key = transcode_json_hold(state, eat_json_key(state, &new_key_start, &new_key_stop));
 
         eat_xml_whitespace(state, NULL, NULL);
         c = *(state->i);
-
-        if (c == ':')
-        {
-            increment(c, 1, &state->i, &state->line, &state->col);
-        }
-        else
+        if (c != ':')
         {
             state->error_nr = XMQ_ERROR_JSON_INVALID_CHAR;
             longjmp(state->error_handler, 1);
         }
+        increment(c, 1, &state->i, &state->line, &state->col);
 
-        parse_json(state, new_key_start, new_key_stop);
-        free(new_key_start);
+        transcode_json(state, ps, new_key_start, new_key_stop);
+        transcode_json_release(state, decoded_key);
 
         c = *state->i;
         if (c == ',') increment(c, 1, &state->i, &state->line, &state->col);
     }
-    while (c == ',');
 
-    assert(c == '}');
+    if (c != '}')
+    {
+        state->error_nr = XMQ_ERROR_JSON_INVALID_CHAR;
+        longjmp(state->error_handler, 1);
+    }
     increment(c, 1, &state->i, &state->line, &state->col);
 
-    DO_CALLBACK_SIM(brace_right, state, state->line, state->col, rightbrace, rightbrace+1, rightbrace+1);
+    write(writer_state, "}", NULL);
+    ps->last_char = '}';
+}
+
+void transcode_json_array(XMQParseState *state, XMQPrintState *ps, const char *key_start, const char *key_stop)
+{
+    XMQWrite write = ps->output_settings->content.write;
+    void *writer_state = ps->output_settings->content.writer_state;
+
+    char c = *state->i;
+    assert(c == '[');
+    increment(c, 1, &state->i, &state->line, &state->col);
+
+    trim_index_suffix(key_start, &key_stop);
+    transcode_json_name(state, ps, key_start, key_stop, false, true);
+
+    eat_xml_whitespace(state, NULL, NULL);
+    if (state->i < state->buffer_stop && *state->i == ']')
+    {
+        // An empty array is a leaf node.
+        increment(']', 1, &state->i, &state->line, &state->col);
+        return;
+    }
+
+    write(writer_state, "{", NULL);
+    ps->last_char = '{';
+
+    const char *stop = state->buffer_stop;
+
+    c = ',';
+    while (state->i < stop && c == ',')
+    {
+        eat_xml_whitespace(state, NULL, NULL);
+        c = *(state->i);
+        if (c == ']') break;
+
+        transcode_json(state, ps, NULL, NULL);
+        c = *state->i;
+        if (c == ',') increment(c, 1, &state->i, &state->line, &state->col);
+    }
+
+    if (c != ']')
+    {
+        state->error_nr = XMQ_ERROR_JSON_INVALID_CHAR;
+        longjmp(state->error_handler, 1);
+    }
+    increment(c, 1, &state->i, &state->line, &state->col);
+
+    write(writer_state, "}", NULL);
+    ps->last_char = '}';
 }
 
 XMQStatus json_print_value(XMQPrintState *ps, xmlNode *from, xmlNode *to, Level level, bool force_string)
@@ -1111,8 +2178,7 @@ XMQStatus json_print_value(XMQPrintState *ps, xmlNode *from, xmlNode *to, Level
 
     if (!xml_next_sibling(node) &&
         !force_string &&
-        (json_is_number(xml_element_content(node))
-         || json_is_keyword(xml_element_content(node))))
+        json_is_literal_node(ps, node))
     {
         // This is a number or a keyword. E.g. 123 true false null
         write(writer_state, content, NULL);
@@ -1563,18 +2629,34 @@ XMQStatus json_print_standalone_quote(XMQPrintState *ps, xmlNodePtr container, x
 
 bool json_is_number(const char *start)
 {
-    const char *stop = start+strlen(start);
-    return stop == is_jnumber(start, stop);
+    const char *i = scan_jnumber(start, NULL);
+    return i != NULL && *i == 0;
 }
 
 bool json_is_keyword(const char *start)
 {
-    if (!strcmp(start, "true")) return true;
-    if (!strcmp(start, "false")) return true;
-    if (!strcmp(start, "null")) return true;
+    switch (*start)
+    {
+    case 't': return !strcmp(start, "true");
+    case 'f': return !strcmp(start, "false");
+    case 'n': return !strcmp(start, "null");
+    }
     return false;
 }
 
+bool json_is_literal_node(XMQPrintState *ps, xmlNode *node)
+{
+    const char *content = xml_element_content(node);
+    if (!content) return false;
+
+    // The json parser stores the short text of numbers, booleans and null inline in the text node.
+    // Any change to the text replaces it with a malloced copy.
+    if (ps->doq && ps->doq->json_literals_ && node->content == (xmlChar*)&node->properties) return true;
+
+    // Not parsed from json or edited, recognize the literal from the text content.
+    return json_is_keyword(content) || json_is_number(content);
+}
+
 void json_print_leaf_node(XMQPrintState *ps,
                           xmlNode *container,
                           xmlNode *node,
@@ -1620,50 +2702,42 @@ void json_print_leaf_node(XMQPrintState *ps,
     }
 }
 
-void fixup_json(XMQDoc *doq, xmlNode *node)
+/**
+    fixup_json_visit:
+    @walk: The fixup traversal.
+    @node: The visited node.
+
+    Replace the mixed text and entity children of an element with a single text node,
+    since json can only store a single string value.
+*/
+bool fixup_json_visit(XMQFixupWalk *walk, xmlNode **node)
 {
-    if (is_element_node(node))
+    xmlNode *n = *node;
+    if (is_element_node(n))
     {
-        char *new_content = xml_collapse_text(node);
+        char *new_content = xml_collapse_text(n);
         if (new_content)
         {
-            xmlNodePtr new_child = xmlNewDocText(doq->docptr_.xml, (const xmlChar*)new_content);
-            xmlNode *i = node->children;
+            xmlNodePtr new_child = xmlNewDocText(walk->doq->docptr_.xml, (const xmlChar*)new_content);
+            xmlNode *i = n->children;
             while (i) {
                 xmlNode *next = i->next;
                 xmlUnlinkNode(i);
                 xmlFreeNode(i);
                 i = next;
             }
-            assert(node);
             assert(new_child);
-            xmlAddChild(node, new_child);
+            xmlAddChild(n, new_child);
             free(new_content);
-            return;
+            return false;
         }
     }
-
-    xmlNode *i = xml_first_child(node);
-    while (i)
-    {
-        xmlNode *next = xml_next_sibling(i); // i might be freed in trim.
-        fixup_json(doq, i);
-        i = next;
-    }
+    return true;
 }
 
 void xmq_fixup_json_before_writeout(XMQDoc *doq)
 {
-    if (doq == NULL || doq->docptr_.xml == NULL) return;
-    xmlNodePtr i = doq->docptr_.xml->children;
-    if (!doq || !i) return;
-
-    while (i)
-    {
-        xmlNode *next = xml_next_sibling(i); // i might be freed in fixup_json.
-        fixup_json(doq, i);
-        i = next;
-    }
+    xmq_fixup_doc(doq, XMQ_FIXUP_JSON, 0);
 }
 
 void collect_leading_ending_comments_doctype(XMQPrintState *ps, xmlNodePtr *first, xmlNodePtr *last)
@@ -1714,7 +2788,13 @@ void xmq_fixup_json_before_writeout(XMQDoc *doq)
 }
 
 // Empty function when XMQ_NO_JSON is defined.
-bool xmq_parse_buffer_json(XMQDoc *doq, const char *start, const char *stop)
+bool fixup_json_visit(XMQFixupWalk *walk, xmlNode **node)
+{
+    return false;
+}
+
+// Empty function when XMQ_NO_JSON is defined.
+bool xmq_parse_buffer_json(XMQDoc *doq, const char *start, const char *stop, const char *implicit_root, int flags)
 {
     return false;
 }
@@ -1732,4 +2812,32 @@ void json_print_array_nodes(XMQPrintState *ps, xmlNode *container, xmlNode *from
 {
 }
 
+void json_print_lines(XMQPrintState *ps, xmlNode *from, xmlNode *to)
+{
+}
+
+bool xmq_tokenize_json_record(XMQParseState *state, const char *start, const char *stop, size_t line)
+{
+    return false;
+}
+
+bool json_record_is_complete(const char *start, const char *stop)
+{
+    return false;
+}
+
+bool xmq_transcode_json_to_xmq(XMQParseState *state, XMQPrintState *ps, const char *start, const char *stop)
+{
+    return false;
+}
+
+const char *find_json_quote_special(const char *i, const char *stop, size_t *col)
+{
+    return stop;
+}
+
+void free_json_key_cache(XMQJsonKeyCache *kc)
+{
+}
+
 #endif // JSON_MODULE
@@ -30,12 +30,25 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 struct XMQPrintState;
 typedef struct XMQPrintState XMQPrintState;
 
-bool xmq_parse_buffer_json(XMQDoc *doq, const char *start, const char *stop, const char *implicit_root);
+struct XMQJsonKeyCache;
+typedef struct XMQJsonKeyCache XMQJsonKeyCache;
+
+struct XMQFixupWalk;
+typedef struct XMQFixupWalk XMQFixupWalk;
+
+bool xmq_parse_buffer_json(XMQDoc *doq, const char *start, const char *stop, const char *implicit_root, int flags);
 void xmq_fixup_json_before_writeout(XMQDoc *doq);
+bool fixup_json_visit(XMQFixupWalk *walk, xmlNode **node);
 void json_print_object_nodes(XMQPrintState *ps, xmlNode *container, xmlNode *from, xmlNode *to);
 void collect_leading_ending_comments_doctype(XMQPrintState *ps, xmlNodePtr *first, xmlNodePtr *last);
 void json_print_array_nodes(XMQPrintState *ps, xmlNode *container, xmlNode *from, xmlNode *to);
+void json_print_lines(XMQPrintState *ps, xmlNode *from, xmlNode *to);
+bool xmq_transcode_json_to_xmq(XMQParseState *state, XMQPrintState *ps, const char *start, const char *stop);
 bool xmq_tokenize_buffer_json(XMQParseState *state, const char *start, const char *stop);
+bool xmq_tokenize_json_record(XMQParseState *state, const char *start, const char *stop, size_t line);
+bool json_record_is_complete(const char *start, const char *stop);
+const char *find_json_quote_special(const char *i, const char *stop, size_t *col);
+void free_json_key_cache(XMQJsonKeyCache *kc);
 
 #define JSON_MODULE
 
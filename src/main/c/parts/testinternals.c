@@ -17,6 +17,7 @@
     X(test_quicksort) \
     X(test_stack) \
     X(test_binary_search) \
+    X(test_unicode_categories) \
     X(test_colors) \
     X(test_objstack) \
     X(test_theme) \
@@ -139,6 +140,39 @@ void test_stack()
     stack_free(stack);
 }
 
+void test_unicode_categories()
+{
+    uint64_t lu = unicode_category_mask("Lu");
+    uint64_t l = unicode_category_mask("L");
+    uint64_t zs = unicode_category_mask("Zs");
+
+    if (lu == 0 || zs == 0 || (l & lu) != lu) { all_ok_ = false; printf("ERROR: unexpected category masks.\n"); }
+    if (unicode_category_mask("Qq") != 0) { all_ok_ = false; printf("ERROR: expected no mask for Qq.\n"); }
+    if (!unicode_has_category('A', lu)) { all_ok_ = false; printf("ERROR: expected A in Lu.\n"); }
+    if (unicode_has_category('a', lu)) { all_ok_ = false; printf("ERROR: expected a not in Lu.\n"); }
+    if (!unicode_has_category('a', l)) { all_ok_ = false; printf("ERROR: expected a in L.\n"); }
+    if (!unicode_has_category(0x3000, zs)) { all_ok_ = false; printf("ERROR: expected 0x3000 in Zs.\n"); }
+    if (unicode_next_code_with_category(0x21, zs) != 0xa0) { all_ok_ = false; printf("ERROR: expected next Zs after 0x21 to be 0xa0.\n"); }
+    if (unicode_next_code_with_category(0x110000, l) != -1) { all_ok_ = false; printf("ERROR: expected no code after 0x10ffff.\n"); }
+
+    // The table must agree with the category arrays.
+    int *cat = NULL;
+    size_t cat_len = 0;
+    if (unicode_get_category_part("Lo", &cat, &cat_len))
+    {
+        uint64_t lo = unicode_category_mask("Lo");
+        for (size_t i = 0; i < cat_len; ++i)
+        {
+            if (!unicode_has_category(cat[i], lo))
+            {
+                all_ok_ = false;
+                printf("ERROR: expected %x in Lo.\n", cat[i]);
+                break;
+            }
+        }
+    }
+}
+
 void test_colors()
 {
     XMQColorDef def;
@@ -7,6 +7,7 @@
 #include<stdlib.h>
 #include<assert.h>
 #include<string.h>
+#include<stdint.h>
 
 #endif
 
@@ -782,6 +783,27 @@ UNICODE_CATEGORIES
 UNICODE_CATEGORIES
 #undef X
 
+// Each category is numbered from 1 in the order of UNICODE_CATEGORIES, 0 means no category.
+// Only the single categories (Lu, Ll...) have code points, the combined categories (L, LC...)
+// are masks of their parts.
+enum UnicodeCategoryIndex
+{
+    UNICODE_CATEGORY_NONE,
+#define X(cat,name,strings,explanation) UNICODE_CATEGORY_##cat,
+UNICODE_CATEGORIES
+#undef X
+    UNICODE_NUM_CATEGORIES
+};
+
+// The two level category table. The page index maps the upper bits of a code point
+// to a page of UNICODE_CATEGORY_PAGE_SIZE set numbers. A set number selects the mask
+// of categories the code point belongs to. Page 0 and set 0 are all zeros and are
+// shared by all code points without any category. The tables are generated from the
+// category arrays below by scripts/generate_unicode_category_tables.sh.
+#define UNICODE_CATEGORY_PAGE_BITS 8
+#define UNICODE_CATEGORY_PAGE_SIZE (1 << UNICODE_CATEGORY_PAGE_BITS)
+#define UNICODE_CATEGORY_NUM_PAGE_INDEXES (0x110000 >> UNICODE_CATEGORY_PAGE_BITS)
+
 int unicode_Ll[] = {0x0061,0x0062,0x0063,0x0064,0x0065,0x0066,0x0067,0x0068,0x0069,0x006A,0x006B,0x006C,0x006D,0x006E,0x006F,0x0070,0x0071,0x0072,0x0073,0x0074,0x0075,0x0076,0x0077,0x0078,0x0079,0x007A,0x00B5,0x00DF,0x00E0,0x00E1,0x00E2,0x00E3,0x00E4,0x00E5,0x00E6,0x00E7,0x00E8,0x00E9,0x00EA,0x00EB,0x00EC,0x00ED,0x00EE,0x00EF,0x00F0,0x00F1,0x00F2,0x00F3,0x00F4,0x00F5,0x00F6,0x00F8,0x00F9,0x00FA,0x00FB,0x00FC,0x00FD,0x00FE,0x00FF,0x0101,0x0103,0x0105,0x0107,0x0109,0x010B,0x010D,0x010F,0x0111,0x0113,0x0115,0x0117,0x0119,0x011B,0x011D,0x011F,0x0121,0x0123,0x0125,0x0127,0x0129,0x012B,0x012D,0x012F,0x0131,0x0133,0x0135,0x0137,0x0138,0x013A,0x013C,0x013E,0x0140,0x0142,0x0144,0x0146,0x0148,0x0149,0x014B,0x014D,0x014F,0x0151,0x0153,0x0155,0x0157,0x0159,0x015B,0x015D,0x015F,0x0161,0x0163,0x0165,0x0167,0x0169,0x016B,0x016D,0x016F,0x0171,0x0173,0x0175,0x0177,0x017A,0x017C,0x017E,0x017F,0x0180,0x0183,0x0185,0x0188,0x018C,0x018D,0x0192,0x0195,0x0199,0x019A,0x019B,0x019E,0x01A1,0x01A3,0x01A5,0x01A8,0x01AA,0x01AB,0x01AD,0x01B0,0x01B4,0x01B6,0x01B9,0x01BA,0x01BD,0x01BE,0x01BF,0x01C6,0x01C9,0x01CC,0x01CE,0x01D0,0x01D2,0x01D4,0x01D6,0x01D8,0x01DA,0x01DC,0x01DD,0x01DF,0x01E1,0x01E3,0x01E5,0x01E7,0x01E9,0x01EB,0x01ED,0x01EF,0x01F0,0x01F3,0x01F5,0x01F9,0x01FB,0x01FD,0x01FF,0x0201,0x0203,0x0205,0x0207,0x0209,0x020B,0x020D,0x020F,0x0211,0x0213,0x0215,0x0217,0x0219,0x021B,0x021D,0x021F,0x0221,0x0223,0x0225,0x0227,0x0229,0x022B,0x022D,0x022F,0x0231,0x0233,0x0234,0x0235,0x0236,0x0237,0x0238,0x0239,0x023C,0x023F,0x0240,0x0242,0x0247,0x0249,0x024B,0x024D,0x024F,0x0250,0x0251,0x0252,0x0253,0x0254,0x0255,0x0256,0x0257,0x0258,0x0259,0x025A,0x025B,0x025C,0x025D,0x025E,0x025F,0x0260,0x0261,0x0262,0x0263,0x0264,0x0265,0x0266,0x0267,0x0268,0x0269,0x026A,0x026B,0x026C,0x026D,0x026E,0x026F,0x0270,0x0271,0x0272,0x0273,0x0274,0x0275,0x0276,0x0277,0x0278,0x0279,0x027A,0x027B,0x027C,0x027D,0x027E,0x027F,0x0280,0x0281,0x0282,0x0283,0x0284,0x0285,0x0286,0x0287,0x0288,0x0289,0x028A,0x028B,0x028C,0x028D,0x028E,0x028F,0x0290,0x0291,0x0292,0x0293,0x0295,0x0296,0x0297,0x0298,0x0299,0x029A,0x029B,0x029C,0x029D,0x029E,0x029F,0x02A0,0x02A1,0x02A2,0x02A3,0x02A4,0x02A5,0x02A6,0x02A7,0x02A8,0x02A9,0x02AA,0x02AB,0x02AC,0x02AD,0x02AE,0x02AF,0x0371,0x0373,0x0377,0x037B,0x037C,0x037D,0x0390,0x03AC,0x03AD,0x03AE,0x03AF,0x03B0,0x03B1,0x03B2,0x03B3,0x03B4,0x03B5,0x03B6,0x03B7,0x03B8,0x03B9,0x03BA,0x03BB,0x03BC,0x03BD,0x03BE,0x03BF,0x03C0,0x03C1,0x03C2,0x03C3,0x03C4,0x03C5,0x03C6,0x03C7,0x03C8,0x03C9,0x03CA,0x03CB,0x03CC,0x03CD,0x03CE,0x03D0,0x03D1,0x03D5,0x03D6,0x03D7,0x03D9,0x03DB,0x03DD,0x03DF,0x03E1,0x03E3,0x03E5,0x03E7,0x03E9,0x03EB,0x03ED,0x03EF,0x03F0,0x03F1,0x03F2,0x03F3,0x03F5,0x03F8,0x03FB,0x03FC,0x0430,0x0431,0x0432,0x0433,0x0434,0x0435,0x0436,0x0437,0x0438,0x0439,0x043A,0x043B,0x043C,0x043D,0x043E,0x043F,0x0440,0x0441,0x0442,0x0443,0x0444,0x0445,0x0446,0x0447,0x0448,0x0449,0x044A,0x044B,0x044C,0x044D,0x044E,0x044F,0x0450,0x0451,0x0452,0x0453,0x0454,0x0455,0x0456,0x0457,0x0458,0x0459,0x045A,0x045B,0x045C,0x045D,0x045E,0x045F,0x0461,0x0463,0x0465,0x0467,0x0469,0x046B,0x046D,0x046F,0x0471,0x0473,0x0475,0x0477,0x0479,0x047B,0x047D,0x047F,0x0481,0x048B,0x048D,0x048F,0x0491,0x0493,0x0495,0x0497,0x0499,0x049B,0x049D,0x049F,0x04A1,0x04A3,0x04A5,0x04A7,0x04A9,0x04AB,0x04AD,0x04AF,0x04B1,0x04B3,0x04B5,0x04B7,0x04B9,0x04BB,0x04BD,0x04BF,0x04C2,0x04C4,0x04C6,0x04C8,0x04CA,0x04CC,0x04CE,0x04CF,0x04D1,0x04D3,0x04D5,0x04D7,0x04D9,0x04DB,0x04DD,0x04DF,0x04E1,0x04E3,0x04E5,0x04E7,0x04E9,0x04EB,0x04ED,0x04EF,0x04F1,0x04F3,0x04F5,0x04F7,0x04F9,0x04FB,0x04FD,0x04FF,0x0501,0x0503,0x0505,0x0507,0x0509,0x050B,0x050D,0x050F,0x0511,0x0513,0x0515,0x0517,0x0519,0x051B,0x051D,0x051F,0x0521,0x0523,0x0525,0x0527,0x0529,0x052B,0x052D,0x052F,0x0560,0x0561,0x0562,0x0563,0x0564,0x0565,0x0566,0x0567,0x0568,0x0569,0x056A,0x056B,0x056C,0x056D,0x056E,0x056F,0x0570,0x0571,0x0572,0x0573,0x0574,0x0575,0x0576,0x0577,0x0578,0x0579,0x057A,0x057B,0x057C,0x057D,0x057E,0x057F,0x0580,0x0581,0x0582,0x0583,0x0584,0x0585,0x0586,0x0587,0x0588,0x1042,0x1042,0x1042,0x1042,0x1042,0x1042,0x1042,0x1042,0x1043,0x1043,0x1043,0x1043,0x1043,0x1043,0x1043,0x1043,0x1043,0x1043,0x1043,0x1043,0x1043,0x1043,0x1043,0x1043,0x1044,0x1044,0x1044,0x1044,0x1044,0x1044,0x1044,0x1044,0x1044,0x1044,0x1044,0x1044,0x1044,0x1044,0x1044,0x1044,0x104D,0x104D,0x104D,0x104D,0x104D,0x104D,0x104D,0x104D,0x104E,0x104E,0x104E,0x104E,0x104E,0x104E,0x104E,0x104E,0x104E,0x104E,0x104E,0x104E,0x104E,0x104E,0x104E,0x104E,0x104F,0x104F,0x104F,0x104F,0x104F,0x104F,0x104F,0x104F,0x104F,0x104F,0x104F,0x104F,0x1059,0x1059,0x1059,0x1059,0x1059,0x1059,0x1059,0x1059,0x1059,0x105A,0x105A,0x105A,0x105A,0x105A,0x105A,0x105A,0x105A,0x105A,0x105A,0x105A,0x105A,0x105A,0x105A,0x105A,0x105B,0x105B,0x105B,0x105B,0x105B,0x105B,0x105B,0x105B,0x105B,0x105B,0x105B,0x10CC,0x10CC,0x10CC,0x10CC,0x10CC,0x10CC,0x10CC,0x10CC,0x10CC,0x10CC,0x10CC,0x10CC,0x10CC,0x10CC,0x10CC,0x10CC,0x10CD,0x10CD,0x10CD,0x10CD,0x10CD,0x10CD,0x10CD,0x10CD,0x10CD,0x10CD,0x10CD,0x10CD,0x10CD,0x10CD,0x10CD,0x10CD,0x10CE,0x10CE,0x10CE,0x10CE,0x10CE,0x10CE,0x10CE,0x10CE,0x10CE,0x10CE,0x10CE,0x10CE,0x10CE,0x10CE,0x10CE,0x10CE,0x10CF,0x10CF,0x10CF,0x10D0,0x10D1,0x10D2,0x10D3,0x10D4,0x10D5,0x10D6,0x10D7,0x10D7,0x10D7,0x10D7,0x10D7,0x10D7,0x10D7,0x10D7,0x10D7,0x10D7,0x10D7,0x10D7,0x10D7,0x10D7,0x10D7,0x10D7,0x10D7,0x10D8,0x10D8,0x10D8,0x10D8,0x10D8,0x10D8,0x10D8,0x10D9,0x10DA,0x10DB,0x10DC,0x10DD,0x10DE,0x10DF,0x10E0,0x10E1,0x10E2,0x10E3,0x10E4,0x10E5,0x10E6,0x10E7,0x10E8,0x10E9,0x10EA,0x10EB,0x10EC,0x10ED,0x10EE,0x10EF,0x10F0,0x10F1,0x10F2,0x10F3,0x10F4,0x10F5,0x10F6,0x10F7,0x10F8,0x10F9,0x10FA,0x10FD,0x10FE,0x10FF,0x118C,0x118C,0x118C,0x118C,0x118C,0x118C,0x118C,0x118C,0x118C,0x118C,0x118C,0x118C,0x118C,0x118C,0x118C,0x118C,0x118D,0x118D,0x118D,0x118D,0x118D,0x118D,0x118D,0x118D,0x118D,0x118D,0x118D,0x118D,0x118D,0x118D,0x118D,0x118D,0x13F8,0x13F9,0x13FA,0x13FB,0x13FC,0x13FD,0x16E6,0x16E6,0x16E6,0x16E6,0x16E6,0x16E6,0x16E6,0x16E6,0x16E6,0x16E6,0x16E6,0x16E6,0x16E6,0x16E6,0x16E6,0x16E6,0x16E7,0x16E7,0x16E7,0x16E7,0x16E7,0x16E7,0x16E7,0x16E7,0x16E7,0x16E7,0x16E7,0x16E7,0x16E7,0x16E7,0x16E7,0x16E7,0x1C80,0x1C81,0x1C82,0x1C83,0x1C84,0x1C85,0x1C86,0x1C87,0x1C88,0x1C8A,0x1D00,0x1D01,0x1D02,0x1D03,0x1D04,0x1D05,0x1D06,0x1D07,0x1D08,0x1D09,0x1D0A,0x1D0B,0x1D0C,0x1D0D,0x1D0E,0x1D0F,0x1D10,0x1D11,0x1D12,0x1D13,0x1D14,0x1D15,0x1D16,0x1D17,0x1D18,0x1D19,0x1D1A,0x1D1B,0x1D1C,0x1D1D,0x1D1E,0x1D1F,0x1D20,0x1D21,0x1D22,0x1D23,0x1D24,0x1D25,0x1D26,0x1D27,0x1D28,0x1D29,0x1D2A,0x1D2B,0x1D41,0x1D41,0x1D41,0x1D41,0x1D41,0x1D41,0x1D42,0x1D42,0x1D42,0x1D42,0x1D42,0x1D42,0x1D42,0x1D42,0x1D42,0x1D42,0x1D42,0x1D42,0x1D42,0x1D42,0x1D42,0x1D42,0x1D43,0x1D43,0x1D43,0x1D43,0x1D44,0x1D44,0x1D45,0x1D45,0x1D45,0x1D45,0x1D45,0x1D45,0x1D45,0x1D45,0x1D45,0x1D45,0x1D45,0x1D45,0x1D45,0x1D45,0x1D45,0x1D46,0x1D46,0x1D46,0x1D46,0x1D46,0x1D46,0x1D46,0x1D46,0x1D48,0x1D48,0x1D48,0x1D48,0x1D48,0x1D48,0x1D48,0x1D48,0x1D48,0x1D48,0x1D48,0x1D48,0x1D48,0x1D48,0x1D49,0x1D49,0x1D49,0x1D49,0x1D49,0x1D49,0x1D49,0x1D49,0x1D49,0x1D49,0x1D49,0x1D49,0x1D4B,0x1D4B,0x1D4B,0x1D4B,0x1D4B,0x1D4B,0x1D4B,0x1D4B,0x1D4C,0x1D4C,0x1D4C,0x1D4C,0x1D4C,0x1D4C,0x1D4C,0x1D4C,0x1D4C,0x1D4C,0x1D4C,0x1D4C,0x1D4C,0x1D4C,0x1D4C,0x1D4E,0x1D4E,0x1D4E,0x1D4E,0x1D4E,0x1D4E,0x1D4F,0x1D4F,0x1D4F,0x1D4F,0x1D4F,0x1D4F,0x1D4F,0x1D4F,0x1D4F,0x1D4F,0x1D4F,0x1D4F,0x1D4F,0x1D4F,0x1D4F,0x1D4F,0x1D50,0x1D50,0x1D50,0x1D50,0x1D51,0x1D51,0x1D52,0x1D52,0x1D52,0x1D52,0x1D52,0x1D52,0x1D52,0x1D52,0x1D52,0x1D52,0x1D52,0x1D52,0x1D52,0x1D52,0x1D52,0x1D52,0x1D53,0x1D53,0x1D53,0x1D53,0x1D53,0x1D53,0x1D53,0x1D53,0x1D55,0x1D55,0x1D55,0x1D55,0x1D55,0x1D55,0x1D55,0x1D55,0x1D55,0x1D55,0x1D55,0x1D55,0x1D55,0x1D55,0x1D56,0x1D56,0x1D56,0x1D56,0x1D56,0x1D56,0x1D56,0x1D56,0x1D56,0x1D56,0x1D56,0x1D56,0x1D58,0x1D58,0x1D58,0x1D58,0x1D58,0x1D58,0x1D58,0x1D58,0x1D58,0x1D58,0x1D59,0x1D59,0x1D59,0x1D59,0x1D59,0x1D59,0x1D59,0x1D59,0x1D59,0x1D59,0x1D59,0x1D59,0x1D59,0x1D59,0x1D59,0x1D59,0x1D5B,0x1D5B,0x1D5B,0x1D5B,0x1D5B,0x1D5B,0x1D5C,0x1D5C,0x1D5C,0x1D5C,0x1D5C,0x1D5C,0x1D5C,0x1D5C,0x1D5C,0x1D5C,0x1D5C,0x1D5C,0x1D5C,0x1D5C,0x1D5C,0x1D5C,0x1D5D,0x1D5D,0x1D5D,0x1D5D,0x1D5E,0x1D5E,0x1D5F,0x1D5F,0x1D5F,0x1D5F,0x1D5F,0x1D5F,0x1D5F,0x1D5F,0x1D5F,0x1D5F,0x1D5F,0x1D5F,0x1D5F,0x1D5F,0x1D5F,0x1D5F,0x1D60,0x1D60,0x1D60,0x1D60,0x1D60,0x1D60,0x1D60,0x1D60,0x1D62,0x1D62,0x1D62,0x1D62,0x1D62,0x1D62,0x1D62,0x1D62,0x1D62,0x1D62,0x1D62,0x1D62,0x1D62,0x1D62,0x1D63,0x1D63,0x1D63,0x1D63,0x1D63,0x1D63,0x1D63,0x1D63,0x1D63,0x1D63,0x1D63,0x1D63,0x1D65,0x1D65,0x1D65,0x1D65,0x1D65,0x1D65,0x1D65,0x1D65,0x1D65,0x1D65,0x1D66,0x1D66,0x1D66,0x1D66,0x1D66,0x1D66,0x1D66,0x1D66,0x1D66,0x1D66,0x1D66,0x1D66,0x1D66,0x1D66,0x1D66,0x1D66,0x1D68,0x1D68,0x1D68,0x1D68,0x1D68,0x1D68,0x1D69,0x1D69,0x1D69,0x1D69,0x1D69,0x1D69,0x1D69,0x1D69,0x1D69,0x1D69,0x1D69,0x1D69,0x1D69,0x1D69,0x1D69,0x1D69,0x1D6A,0x1D6A,0x1D6A,0x1D6A,0x1D6A,0x1D6A,0x1D6B,0x1D6C,0x1D6C,0x1D6C,0x1D6C,0x1D6C,0x1D6C,0x1D6C,0x1D6C,0x1D6C,0x1D6C,0x1D6C,0x1D6C,0x1D6C,0x1D6C,0x1D6C,0x1D6D,0x1D6D,0x1D6D,0x1D6D,0x1D6D,0x1D6D,0x1D6D,0x1D6D,0x1D6D,0x1D6D,0x1D6D,0x1D6D,0x1D6D,0x1D6D,0x1D6D,0x1D6D,0x1D6E,0x1D6E,0x1D6E,0x1D6F,0x1D6F,0x1D6F,0x1D6F,0x1D6F,0x1D70,0x1D70,0x1D70,0x1D70,0x1D70,0x1D70,0x1D70,0x1D70,0x1D70,0x1D70,0x1D70,0x1D70,0x1D70,0x1D70,0x1D70,0x1D70,0x1D70,0x1D71,0x1D71,0x1D71,0x1D71,0x1D71,0x1D71,0x1D71,0x1D71,0x1D71,0x1D71,0x1D71,0x1D71,0x1D72,0x1D73,0x1D73,0x1D73,0x1D73,0x1D73,0x1D73,0x1D73,0x1D73,0x1D73,0x1D73,0x1D73,0x1D74,0x1D74,0x1D74,0x1D74,0x1D74,0x1D74,0x1D74,0x1D74,0x1D74,0x1D74,0x1D74,0x1D74,0x1D74,0x1D74,0x1D74,0x1D74,0x1D75,0x1D75,0x1D75,0x1D75,0x1D75,0x1D75,0x1D75,0x1D76,0x1D77,0x1D77,0x1D77,0x1D77,0x1D77,0x1D77,0x1D77,0x1D77,0x1D77,0x1D77,0x1D77,0x1D77,0x1D77,0x1D77,0x1D77,0x1D77,0x1D77,0x1D78,0x1D78,0x1D78,0x1D78,0x1D78,0x1D78,0x1D78,0x1D78,0x1D78,0x1D78,0x1D78,0x1D78,0x1D78,0x1D78,0x1D78,0x1D79,0x1D7A,0x1D7A,0x1D7A,0x1D7A,0x1D7A,0x1D7A,0x1D7A,0x1D7B,0x1D7B,0x1D7B,0x1D7B,0x1D7B,0x1D7B,0x1D7B,0x1D7B,0x1D7B,0x1D7B,0x1D7B,0x1D7B,0x1D7B,0x1D7B,0x1D7B,0x1D7B,0x1D7B,0x1D7C,0x1D7C,0x1D7C,0x1D7C,0x1D7C,0x1D7C,0x1D7C,0x1D7C,0x1D7C,0x1D7C,0x1D7C,0x1D7D,0x1D7E,0x1D7F,0x1D80,0x1D81,0x1D82,0x1D83,0x1D84,0x1D85,0x1D86,0x1D87,0x1D88,0x1D89,0x1D8A,0x1D8B,0x1D8C,0x1D8D,0x1D8E,0x1D8F,0x1D90,0x1D91,0x1D92,0x1D93,0x1D94,0x1D95,0x1D96,0x1D97,0x1D98,0x1D99,0x1D9A,0x1DF0,0x1DF0,0x1DF0,0x1DF0,0x1DF0,0x1DF0,0x1DF0,0x1DF0,0x1DF0,0x1DF0,0x1DF0,0x1DF0,0x1DF0,0x1DF0,0x1DF0,0x1DF1,0x1DF1,0x1DF1,0x1DF1,0x1DF1,0x1DF1,0x1DF1,0x1DF1,0x1DF1,0x1DF1,0x1DF1,0x1DF1,0x1DF1,0x1DF1,0x1DF1,0x1DF2,0x1DF2,0x1DF2,0x1DF2,0x1DF2,0x1DF2,0x1E01,0x1E03,0x1E05,0x1E07,0x1E09,0x1E0B,0x1E0D,0x1E0F,0x1E11,0x1E13,0x1E15,0x1E17,0x1E19,0x1E1B,0x1E1D,0x1E1F,0x1E21,0x1E23,0x1E25,0x1E27,0x1E29,0x1E2B,0x1E2D,0x1E2F,0x1E31,0x1E33,0x1E35,0x1E37,0x1E39,0x1E3B,0x1E3D,0x1E3F,0x1E41,0x1E43,0x1E45,0x1E47,0x1E49,0x1E4B,0x1E4D,0x1E4F,0x1E51,0x1E53,0x1E55,0x1E57,0x1E59,0x1E5B,0x1E5D,0x1E5F,0x1E61,0x1E63,0x1E65,0x1E67,0x1E69,0x1E6B,0x1E6D,0x1E6F,0x1E71,0x1E73,0x1E75,0x1E77,0x1E79,0x1E7B,0x1E7D,0x1E7F,0x1E81,0x1E83,0x1E85,0x1E87,0x1E89,0x1E8B,0x1E8D,0x1E8F,0x1E91,0x1E92,0x1E92,0x1E92,0x1E92,0x1E92,0x1E92,0x1E92,0x1E92,0x1E92,0x1E92,0x1E92,0x1E92,0x1E92,0x1E92,0x1E93,0x1E93,0x1E93,0x1E93,0x1E93,0x1E93,0x1E93,0x1E93,0x1E93,0x1E93,0x1E93,0x1E93,0x1E93,0x1E93,0x1E93,0x1E93,0x1E93,0x1E94,0x1E94,0x1E94,0x1E94,0x1E95,0x1E96,0x1E97,0x1E98,0x1E99,0x1E9A,0x1E9B,0x1E9C,0x1E9D,0x1E9F,0x1EA1,0x1EA3,0x1EA5,0x1EA7,0x1EA9,0x1EAB,0x1EAD,0x1EAF,0x1EB1,0x1EB3,0x1EB5,0x1EB7,0x1EB9,0x1EBB,0x1EBD,0x1EBF,0x1EC1,0x1EC3,0x1EC5,0x1EC7,0x1EC9,0x1ECB,0x1ECD,0x1ECF,0x1ED1,0x1ED3,0x1ED5,0x1ED7,0x1ED9,0x1EDB,0x1EDD,0x1EDF,0x1EE1,0x1EE3,0x1EE5,0x1EE7,0x1EE9,0x1EEB,0x1EED,0x1EEF,0x1EF1,0x1EF3,0x1EF5,0x1EF7,0x1EF9,0x1EFB,0x1EFD,0x1EFF,0x1F00,0x1F01,0x1F02,0x1F03,0x1F04,0x1F05,0x1F06,0x1F07,0x1F10,0x1F11,0x1F12,0x1F13,0x1F14,0x1F15,0x1F20,0x1F21,0x1F22,0x1F23,0x1F24,0x1F25,0x1F26,0x1F27,0x1F30,0x1F31,0x1F32,0x1F33,0x1F34,0x1F35,0x1F36,0x1F37,0x1F40,0x1F41,0x1F42,0x1F43,0x1F44,0x1F45,0x1F50,0x1F51,0x1F52,0x1F53,0x1F54,0x1F55,0x1F56,0x1F57,0x1F60,0x1F61,0x1F62,0x1F63,0x1F64,0x1F65,0x1F66,0x1F67,0x1F70,0x1F71,0x1F72,0x1F73,0x1F74,0x1F75,0x1F76,0x1F77,0x1F78,0x1F79,0x1F7A,0x1F7B,0x1F7C,0x1F7D,0x1F80,0x1F81,0x1F82,0x1F83,0x1F84,0x1F85,0x1F86,0x1F87,0x1F90,0x1F91,0x1F92,0x1F93,0x1F94,0x1F95,0x1F96,0x1F97,0x1FA0,0x1FA1,0x1FA2,0x1FA3,0x1FA4,0x1FA5,0x1FA6,0x1FA7,0x1FB0,0x1FB1,0x1FB2,0x1FB3,0x1FB4,0x1FB6,0x1FB7,0x1FBE,0x1FC2,0x1FC3,0x1FC4,0x1FC6,0x1FC7,0x1FD0,0x1FD1,0x1FD2,0x1FD3,0x1FD6,0x1FD7,0x1FE0,0x1FE1,0x1FE2,0x1FE3,0x1FE4,0x1FE5,0x1FE6,0x1FE7,0x1FF2,0x1FF3,0x1FF4,0x1FF6,0x1FF7,0x210A,0x210E,0x210F,0x2113,0x212F,0x2134,0x2139,0x213C,0x213D,0x2146,0x2147,0x2148,0x2149,0x214E,0x2184,0x2C30,0x2C31,0x2C32,0x2C33,0x2C34,0x2C35,0x2C36,0x2C37,0x2C38,0x2C39,0x2C3A,0x2C3B,0x2C3C,0x2C3D,0x2C3E,0x2C3F,0x2C40,0x2C41,0x2C42,0x2C43,0x2C44,0x2C45,0x2C46,0x2C47,0x2C48,0x2C49,0x2C4A,0x2C4B,0x2C4C,0x2C4D,0x2C4E,0x2C4F,0x2C50,0x2C51,0x2C52,0x2C53,0x2C54,0x2C55,0x2C56,0x2C57,0x2C58,0x2C59,0x2C5A,0x2C5B,0x2C5C,0x2C5D,0x2C5E,0x2C5F,0x2C61,0x2C65,0x2C66,0x2C68,0x2C6A,0x2C6C,0x2C71,0x2C73,0x2C74,0x2C76,0x2C77,0x2C78,0x2C79,0x2C7A,0x2C7B,0x2C81,0x2C83,0x2C85,0x2C87,0x2C89,0x2C8B,0x2C8D,0x2C8F,0x2C91,0x2C93,0x2C95,0x2C97,0x2C99,0x2C9B,0x2C9D,0x2C9F,0x2CA1,0x2CA3,0x2CA5,0x2CA7,0x2CA9,0x2CAB,0x2CAD,0x2CAF,0x2CB1,0x2CB3,0x2CB5,0x2CB7,0x2CB9,0x2CBB,0x2CBD,0x2CBF,0x2CC1,0x2CC3,0x2CC5,0x2CC7,0x2CC9,0x2CCB,0x2CCD,0x2CCF,0x2CD1,0x2CD3,0x2CD5,0x2CD7,0x2CD9,0x2CDB,0x2CDD,0x2CDF,0x2CE1,0x2CE3,0x2CE4,0x2CEC,0x2CEE,0x2CF3,0x2D00,0x2D01,0x2D02,0x2D03,0x2D04,0x2D05,0x2D06,0x2D07,0x2D08,0x2D09,0x2D0A,0x2D0B,0x2D0C,0x2D0D,0x2D0E,0x2D0F,0x2D10,0x2D11,0x2D12,0x2D13,0x2D14,0x2D15,0x2D16,0x2D17,0x2D18,0x2D19,0x2D1A,0x2D1B,0x2D1C,0x2D1D,0x2D1E,0x2D1F,0x2D20,0x2D21,0x2D22,0x2D23,0x2D24,0x2D25,0x2D27,0x2D2D,0xA641,0xA643,0xA645,0xA647,0xA649,0xA64B,0xA64D,0xA64F,0xA651,0xA653,0xA655,0xA657,0xA659,0xA65B,0xA65D,0xA65F,0xA661,0xA663,0xA665,0xA667,0xA669,0xA66B,0xA66D,0xA681,0xA683,0xA685,0xA687,0xA689,0xA68B,0xA68D,0xA68F,0xA691,0xA693,0xA695,0xA697,0xA699,0xA69B,0xA723,0xA725,0xA727,0xA729,0xA72B,0xA72D,0xA72F,0xA730,0xA731,0xA733,0xA735,0xA737,0xA739,0xA73B,0xA73D,0xA73F,0xA741,0xA743,0xA745,0xA747,0xA749,0xA74B,0xA74D,0xA74F,0xA751,0xA753,0xA755,0xA757,0xA759,0xA75B,0xA75D,0xA75F,0xA761,0xA763,0xA765,0xA767,0xA769,0xA76B,0xA76D,0xA76F,0xA771,0xA772,0xA773,0xA774,0xA775,0xA776,0xA777,0xA778,0xA77A,0xA77C,0xA77F,0xA781,0xA783,0xA785,0xA787,0xA78C,0xA78E,0xA791,0xA793,0xA794,0xA795,0xA797,0xA799,0xA79B,0xA79D,0xA79F,0xA7A1,0xA7A3,0xA7A5,0xA7A7,0xA7A9,0xA7AF,0xA7B5,0xA7B7,0xA7B9,0xA7BB,0xA7BD,0xA7BF,0xA7C1,0xA7C3,0xA7C8,0xA7CA,0xA7CD,0xA7D1,0xA7D3,0xA7D5,0xA7D7,0xA7D9,0xA7DB,0xA7F6,0xA7FA,0xAB30,0xAB31,0xAB32,0xAB33,0xAB34,0xAB35,0xAB36,0xAB37,0xAB38,0xAB39,0xAB3A,0xAB3B,0xAB3C,0xAB3D,0xAB3E,0xAB3F,0xAB40,0xAB41,0xAB42,0xAB43,0xAB44,0xAB45,0xAB46,0xAB47,0xAB48,0xAB49,0xAB4A,0xAB4B,0xAB4C,0xAB4D,0xAB4E,0xAB4F,0xAB50,0xAB51,0xAB52,0xAB53,0xAB54,0xAB55,0xAB56,0xAB57,0xAB58,0xAB59,0xAB5A,0xAB60,0xAB61,0xAB62,0xAB63,0xAB64,0xAB65,0xAB66,0xAB67,0xAB68,0xAB70,0xAB71,0xAB72,0xAB73,0xAB74,0xAB75,0xAB76,0xAB77,0xAB78,0xAB79,0xAB7A,0xAB7B,0xAB7C,0xAB7D,0xAB7E,0xAB7F,0xAB80,0xAB81,0xAB82,0xAB83,0xAB84,0xAB85,0xAB86,0xAB87,0xAB88,0xAB89,0xAB8A,0xAB8B,0xAB8C,0xAB8D,0xAB8E,0xAB8F,0xAB90,0xAB91,0xAB92,0xAB93,0xAB94,0xAB95,0xAB96,0xAB97,0xAB98,0xAB99,0xAB9A,0xAB9B,0xAB9C,0xAB9D,0xAB9E,0xAB9F,0xABA0,0xABA1,0xABA2,0xABA3,0xABA4,0xABA5,0xABA6,0xABA7,0xABA8,0xABA9,0xABAA,0xABAB,0xABAC,0xABAD,0xABAE,0xABAF,0xABB0,0xABB1,0xABB2,0xABB3,0xABB4,0xABB5,0xABB6,0xABB7,0xABB8,0xABB9,0xABBA,0xABBB,0xABBC,0xABBD,0xABBE,0xABBF,0xFB00,0xFB01,0xFB02,0xFB03,0xFB04,0xFB05,0xFB06,0xFB13,0xFB14,0xFB15,0xFB16,0xFB17,0xFF41,0xFF42,0xFF43,0xFF44,0xFF45,0xFF46,0xFF47,0xFF48,0xFF49,0xFF4A,0xFF4B,0xFF4C,0xFF4D,0xFF4E,0xFF4F,0xFF50,0xFF51,0xFF52,0xFF53,0xFF54,0xFF55,0xFF56,0xFF57,0xFF58,0xFF59,0xFF5A};
 
 size_t unicode_len_Ll = sizeof(unicode_Ll)/sizeof(unicode_Ll[0]);
@@ -922,6 +944,907 @@ size_t unicode_len_Cn = sizeof(unicode_Cn)/sizeof(unicode_Cn[0]);
 int unicode_C[] = { -1 };
 size_t unicode_len_C = sizeof(unicode_C)/sizeof(unicode_C[0]);
 
+// GENERATED UNICODE CATEGORY TABLES BEGIN
+const uint16_t unicode_category_page_index_[UNICODE_CATEGORY_NUM_PAGE_INDEXES] = {
+1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,28,29,30,31,32,
+33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,52,53,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,54,55,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,56,
+57,58,58,58,59,60,61,62,63,64,65,66,67,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,68,0,0,0,0,0,0,0,0,
+69,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,70,71,72,73,74,75,76,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+};
+
+const uint8_t unicode_category_pages_[19712] = {
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+2,3,3,3,4,3,3,3,5,6,3,7,3,8,3,3,9,9,9,9,9,9,9,9,9,9,3,3,7,7,7,3,
+3,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,5,3,6,11,12,
+11,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,5,7,6,7,1,
+1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+2,3,4,4,4,4,14,3,11,14,15,16,7,17,14,11,14,7,18,18,11,13,3,3,11,18,15,19,18,18,18,3,
+10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,7,10,10,10,10,10,10,10,13,
+13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,7,13,13,13,13,13,13,13,13,
+10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,
+10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,13,10,13,10,13,10,13,10,
+13,10,13,10,13,10,13,10,13,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,
+10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,10,13,10,13,10,13,13,
+13,10,10,13,10,13,10,10,13,10,10,10,13,13,10,10,10,10,13,10,10,13,10,10,10,13,13,13,10,10,13,10,
+10,13,10,13,10,13,10,10,13,10,13,13,10,13,10,10,13,10,10,10,13,10,13,10,10,13,13,15,10,13,13,13,
+15,15,15,15,10,20,13,10,20,13,10,20,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,13,10,13,
+10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,13,10,20,13,10,13,10,10,10,13,10,13,10,13,10,13,
+10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,
+10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,13,13,13,13,13,13,10,10,13,10,10,13,
+13,10,13,10,10,10,10,13,10,13,10,13,10,13,10,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,
+13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,
+13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,15,13,13,13,13,13,13,13,13,13,13,13,
+13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,21,21,21,21,21,21,21,21,21,21,21,21,21,21,21,21,
+21,21,11,11,11,11,21,21,21,21,21,21,21,21,21,21,21,21,11,11,11,11,11,11,11,11,11,11,11,11,11,11,
+21,21,21,21,21,11,11,11,11,11,11,11,21,11,21,11,11,11,11,11,11,11,11,11,11,11,11,11,11,11,11,11,
+22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,
+22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,
+22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,
+22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,10,13,10,13,21,11,10,13,0,0,21,13,13,13,3,10,
+0,0,0,0,11,11,10,3,10,10,10,0,10,0,10,10,13,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,
+10,10,0,10,10,10,10,10,10,10,10,10,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,
+13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,10,13,13,10,10,10,13,13,13,10,13,10,13,10,13,10,13,
+10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,13,13,13,13,10,13,7,10,13,10,10,13,13,10,10,10,
+10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,
+10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,
+13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,
+10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,
+10,13,14,22,22,22,22,22,23,23,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,
+10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,
+10,10,13,10,13,10,13,10,13,10,13,10,13,10,13,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,
+10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,
+10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,
+10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,0,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,
+10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,0,0,21,3,3,3,3,3,3,
+13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,
+13,13,13,13,13,13,13,13,13,3,8,0,0,14,14,4,0,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,
+22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,8,22,
+3,22,22,3,22,22,3,22,0,0,0,0,0,0,0,0,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,0,0,0,0,15,15,15,15,3,3,0,0,0,0,0,0,0,0,0,0,0,
+17,17,17,17,17,17,7,7,7,3,3,4,3,3,14,14,22,22,22,22,22,22,22,22,22,22,22,3,17,3,3,3,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+21,15,15,15,15,15,15,15,15,15,15,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,
+9,9,9,9,9,9,9,9,9,9,3,3,3,3,15,15,22,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,3,15,22,22,22,22,22,22,22,17,14,22,
+22,22,22,22,22,21,21,22,22,14,22,22,22,22,15,15,9,9,9,9,9,9,9,9,9,9,15,15,15,14,14,15,
+3,3,3,3,3,3,3,3,3,3,3,3,3,3,0,17,15,22,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,
+22,22,22,22,22,22,22,22,22,22,22,0,0,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,22,22,22,22,22,22,22,22,22,22,22,15,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+9,9,9,9,9,9,9,9,9,9,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,22,22,22,22,22,22,22,22,22,21,21,14,3,3,3,21,0,0,22,4,4,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,22,22,22,22,21,22,22,22,22,22,
+22,22,22,22,21,22,22,22,21,22,22,22,22,22,0,0,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,0,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,22,22,22,0,0,3,0,
+15,15,15,15,15,15,15,15,15,15,15,0,0,0,0,0,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,11,15,15,15,15,15,15,0,17,17,0,0,0,0,0,22,22,22,22,22,22,22,22,22,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,21,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,
+22,22,17,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,
+22,22,22,24,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,22,24,22,15,24,24,
+24,22,22,22,22,22,22,22,22,24,24,24,24,22,24,24,15,22,22,22,22,22,22,22,15,15,15,15,15,15,15,15,
+15,15,22,22,3,3,9,9,9,9,9,9,9,9,9,9,3,21,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,22,24,24,0,15,15,15,15,15,15,15,15,0,0,15,15,0,0,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,0,15,15,15,15,15,15,15,0,15,0,0,0,15,15,15,15,0,0,22,15,24,24,
+24,22,22,22,22,0,0,24,24,0,0,24,24,22,15,0,0,0,0,0,0,0,0,24,0,0,0,0,15,15,0,15,
+15,15,22,22,0,0,9,9,9,9,9,9,9,9,9,9,15,15,4,4,18,18,18,18,18,18,14,4,15,3,22,0,
+0,22,22,24,0,15,15,15,15,15,15,0,0,0,0,15,15,0,0,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,0,15,15,15,15,15,15,15,0,15,15,0,15,15,0,15,15,0,0,22,0,24,24,
+24,22,22,0,0,0,0,22,22,0,0,22,22,22,0,0,0,22,0,0,0,0,0,0,0,15,15,15,15,0,15,0,
+0,0,0,0,0,0,9,9,9,9,9,9,9,9,9,9,22,22,15,15,15,22,3,0,0,0,0,0,0,0,0,0,
+0,22,22,24,0,15,15,15,15,15,15,15,15,15,0,15,15,15,0,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,0,15,15,15,15,15,15,15,0,15,15,0,15,15,15,15,15,0,0,22,15,24,24,
+24,22,22,22,22,22,0,22,22,24,0,24,24,22,0,0,15,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+15,15,22,22,0,0,9,9,9,9,9,9,9,9,9,9,3,4,0,0,0,0,0,0,0,15,22,22,22,22,22,22,
+0,22,24,24,0,15,15,15,15,15,15,15,15,0,0,15,15,0,0,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,0,15,15,15,15,15,15,15,0,15,15,0,15,15,15,15,15,0,0,22,15,24,22,
+24,22,22,22,22,0,0,24,24,0,0,24,24,22,0,0,0,0,0,0,0,22,22,24,0,0,0,0,15,15,0,15,
+15,15,22,22,0,0,9,9,9,9,9,9,9,9,9,9,14,15,18,18,18,18,18,18,0,0,0,0,0,0,0,0,
+0,0,22,15,0,15,15,15,15,15,15,0,0,0,15,15,15,0,15,15,15,15,0,0,0,15,15,0,15,0,15,15,
+0,0,0,15,15,0,0,0,15,15,15,0,0,0,15,15,15,15,15,15,15,15,15,15,15,15,0,0,0,0,24,24,
+22,24,24,0,0,0,24,24,24,0,24,24,24,22,0,0,15,0,0,0,0,0,0,24,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,9,9,9,9,9,9,9,9,9,9,18,18,18,14,14,14,14,14,14,4,14,0,0,0,0,0,
+22,24,24,24,22,15,15,15,15,15,15,15,15,0,15,15,15,0,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,0,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,0,0,22,15,22,22,
+22,24,24,24,24,0,22,22,22,0,22,22,22,22,0,0,0,0,0,0,0,22,22,0,15,15,15,0,0,15,0,0,
+15,15,22,22,0,0,9,9,9,9,9,9,9,9,9,9,0,0,0,0,0,0,0,3,18,18,18,18,18,18,18,14,
+15,22,24,24,3,15,15,15,15,15,15,15,15,0,15,15,15,0,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,0,15,15,15,15,15,15,15,15,15,15,0,15,15,15,15,15,0,0,22,15,24,22,
+24,24,24,24,24,0,22,24,24,0,24,24,22,22,0,0,0,0,0,0,0,24,24,0,0,0,0,0,0,15,15,0,
+15,15,22,22,0,0,9,9,9,9,9,9,9,9,9,9,0,15,15,24,0,0,0,0,0,0,0,0,0,0,0,0,
+22,22,24,24,15,15,15,15,15,15,15,15,15,0,15,15,15,0,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,22,22,15,24,24,
+24,22,22,22,22,0,24,24,24,0,24,24,24,22,15,14,0,0,0,0,15,15,15,24,18,18,18,18,18,18,18,15,
+15,15,22,22,0,0,9,9,9,9,9,9,9,9,9,9,18,18,18,18,18,18,18,18,18,14,15,15,15,15,15,15,
+0,22,24,24,0,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,0,0,0,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,0,15,15,15,15,15,15,15,15,15,0,15,0,0,
+15,15,15,15,15,15,15,0,0,0,22,0,0,0,0,24,24,24,22,22,22,0,22,0,24,24,24,24,24,24,24,24,
+0,0,0,0,0,0,9,9,9,9,9,9,9,9,9,9,0,0,24,24,3,0,0,0,0,0,0,0,0,0,0,0,
+0,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,22,15,15,22,22,22,22,22,22,22,0,0,0,0,4,
+15,15,15,15,15,15,21,22,22,22,22,22,22,22,22,3,9,9,9,9,9,9,9,9,9,9,3,3,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,15,15,0,15,0,15,15,15,15,15,0,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,0,15,0,15,15,15,15,15,15,15,15,15,15,22,15,15,22,22,22,22,22,22,22,22,22,15,0,0,
+15,15,15,15,15,0,21,0,22,22,22,22,22,22,22,0,9,9,9,9,9,9,9,9,9,9,0,0,15,15,15,15,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+15,14,14,14,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,14,3,14,14,14,22,22,14,14,14,14,14,14,
+9,9,9,9,9,9,9,9,9,9,18,18,18,18,18,18,18,18,18,18,14,22,14,22,14,22,5,6,5,6,24,24,
+15,15,15,15,15,15,15,15,0,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,0,0,0,0,22,22,22,22,22,22,22,22,22,22,22,22,22,22,24,
+22,22,22,22,22,3,22,22,15,15,15,15,15,22,22,22,22,22,22,22,22,22,22,22,0,22,22,22,22,22,22,22,
+22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,0,14,14,
+14,14,14,14,14,14,22,14,14,14,14,14,14,0,14,14,3,3,3,3,3,14,14,14,14,3,3,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,25,26,26,27,28,28,28,29,27,30,30,15,15,30,30,31,
+15,15,15,15,15,15,15,15,15,15,15,32,32,33,34,34,33,32,35,33,36,33,33,33,32,37,33,32,32,38,22,15,
+39,39,40,41,41,42,42,42,42,42,43,44,44,45,46,46,15,15,15,15,15,15,47,48,49,50,51,51,15,15,33,33,
+33,15,32,32,32,15,15,32,32,32,32,32,32,32,15,15,15,33,33,33,33,15,15,15,52,52,52,52,15,15,15,15,
+15,15,33,32,32,53,33,54,32,32,55,24,24,22,15,56,42,57,42,58,9,9,9,9,42,42,32,56,55,34,59,59,
+60,61,61,60,62,44,61,63,61,64,10,10,65,61,66,44,61,61,61,67,61,64,61,64,61,67,62,10,10,10,10,10,
+61,61,61,61,61,10,0,10,10,10,10,10,13,68,13,69,51,51,70,41,71,68,72,13,73,13,13,13,13,13,13,13,
+13,13,13,13,13,13,69,69,51,51,74,51,51,13,13,75,51,76,76,51,70,77,13,51,78,13,13,79,80,13,51,51,
+81,15,15,33,37,26,82,33,81,15,15,83,84,15,15,42,33,15,81,85,47,15,15,37,81,15,15,81,86,58,26,26,
+15,15,81,86,33,15,15,15,15,15,79,15,15,33,81,42,81,15,15,81,81,32,81,33,15,15,15,81,81,37,33,15,
+15,15,15,81,86,87,15,15,15,15,15,81,86,42,15,15,15,15,15,15,15,15,15,15,15,15,32,81,37,37,15,15,
+15,15,15,81,37,42,79,15,15,15,81,86,42,42,42,15,15,81,81,88,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,81,86,15,15,15,15,15,15,61,61,51,51,82,26,15,15,15,81,86,42,15,15,15,15,15,15,15,81,86,15,
+33,15,15,86,37,81,15,15,33,86,79,15,15,15,15,15,79,15,15,15,15,15,15,15,15,15,15,15,15,15,79,42,
+15,15,32,81,79,82,26,79,15,33,81,81,15,15,15,15,15,15,15,33,33,42,15,15,32,81,42,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,86,81,15,15,81,86,85,15,15,15,15,15,15,26,89,90,91,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+28,28,28,28,28,28,28,79,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,0,15,0,15,15,15,15,0,0,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,0,15,15,15,15,0,0,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,0,15,15,15,15,0,0,15,15,15,15,15,15,15,0,
+15,0,15,15,15,15,0,0,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,0,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,79,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,92,33,33,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,33,33,33,
+79,79,79,79,79,79,79,79,79,26,26,26,26,26,26,26,26,26,26,26,26,26,26,26,26,26,26,26,26,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,30,30,30,30,30,30,30,30,30,30,15,15,15,15,15,15,
+61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,
+61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,
+61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,61,15,15,51,51,51,51,51,51,15,15,
+93,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,33,81,42,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,14,3,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+94,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,95,96,15,15,15,
+15,15,15,15,15,15,58,15,15,15,15,15,42,15,15,37,15,15,15,97,98,82,26,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,52,15,99,42,15,15,15,15,15,15,15,15,
+15,15,15,15,61,61,51,51,26,25,15,3,3,3,100,100,28,15,15,15,33,32,32,32,81,101,0,0,0,0,102,24,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,22,22,22,24,0,0,0,0,0,0,0,0,0,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,22,22,24,3,3,0,0,0,0,0,0,0,0,0,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,22,22,0,0,0,0,0,0,0,0,0,0,0,0,
+15,15,15,15,15,15,15,15,15,15,15,15,15,0,15,15,15,0,22,22,0,0,0,0,0,0,0,0,0,0,0,0,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,22,22,24,22,22,22,22,22,22,22,24,24,
+24,24,24,24,24,24,22,24,24,22,22,22,22,22,22,22,22,22,22,22,3,3,3,21,3,3,3,4,15,22,0,0,
+9,9,9,9,9,9,9,9,9,9,0,0,0,0,0,0,18,18,18,18,18,18,18,18,18,18,0,0,0,0,0,0,
+3,3,3,3,3,3,8,3,3,3,3,22,22,22,17,22,9,9,9,9,9,9,9,9,9,9,0,0,0,0,0,0,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,21,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,0,0,0,0,0,0,15,
+15,15,15,15,15,33,33,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,33,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,0,0,0,0,0,0,0,0,0,0,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,0,
+22,22,22,24,24,24,24,22,22,24,24,24,0,0,0,0,24,24,22,24,24,24,24,24,24,22,22,22,0,0,0,0,
+14,0,0,0,3,3,9,9,9,9,9,9,9,9,9,9,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,0,0,15,15,15,15,15,0,0,0,0,0,0,0,0,0,0,0,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,0,0,0,0,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,0,0,0,0,0,0,9,9,9,9,9,9,9,9,9,9,18,0,0,0,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,22,22,24,24,22,0,0,3,3,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,24,22,24,22,22,22,22,22,22,22,0,
+22,24,22,24,24,22,22,22,22,22,22,22,22,24,24,24,24,24,24,22,22,22,22,22,22,22,22,22,22,0,0,22,
+9,9,9,9,9,9,9,9,9,9,0,0,0,0,0,0,9,9,9,9,9,9,9,9,9,9,0,0,0,0,0,0,
+3,3,3,3,3,3,3,21,3,3,3,3,3,3,0,0,22,22,22,22,22,22,22,22,22,22,22,22,22,22,23,22,
+22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,21,
+33,33,33,33,32,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,22,24,22,22,22,22,22,24,22,24,24,24,
+24,24,22,24,24,15,15,15,15,15,15,15,15,0,3,3,9,9,9,9,9,9,9,9,9,9,3,3,3,3,3,3,
+3,14,14,14,14,14,14,14,14,14,14,22,22,22,22,22,22,22,22,22,14,14,14,14,14,14,14,14,14,3,3,3,
+22,22,24,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,24,22,22,22,22,24,24,22,22,24,22,22,22,15,15,9,9,9,9,9,9,9,9,9,9,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,97,92,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,22,24,22,22,24,24,24,22,24,22,22,22,24,24,0,0,0,0,0,0,0,0,3,3,3,3,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,24,24,24,24,24,24,24,24,22,22,22,22,22,22,22,22,24,24,22,22,0,0,0,3,3,3,3,3,
+9,9,9,9,9,9,9,9,9,9,0,0,0,15,15,15,9,9,9,9,9,9,9,9,9,9,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,21,21,21,21,21,21,3,3,
+13,13,13,13,13,13,13,13,13,10,13,0,0,0,0,0,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,
+10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,0,0,10,10,10,
+103,103,103,103,103,103,103,103,14,14,14,14,14,14,14,9,104,104,104,103,104,104,104,104,104,104,104,104,104,104,104,104,
+104,105,104,104,104,104,104,104,104,30,30,30,15,22,15,15,33,33,33,33,22,30,30,105,104,104,30,14,14,0,0,0,
+106,106,106,106,106,106,106,106,106,106,106,106,106,106,106,106,106,106,106,106,106,106,107,108,109,106,109,106,106,106,106,13,
+106,106,106,106,109,13,13,13,13,13,13,13,110,110,110,110,111,111,111,111,111,111,110,110,21,21,21,21,21,21,21,21,
+112,113,114,113,113,114,113,112,113,113,112,113,114,112,113,114,113,113,114,113,112,113,113,112,113,114,112,113,114,113,113,114,
+113,112,113,113,112,113,114,112,113,114,113,68,115,73,68,115,13,115,68,115,73,68,115,13,116,68,115,13,117,41,41,41,
+106,106,106,106,106,106,106,106,106,106,106,106,106,106,106,106,106,106,106,106,106,106,106,106,106,106,106,111,111,111,111,111,
+101,101,101,118,101,101,118,118,119,101,101,21,21,21,21,21,21,21,21,21,21,21,21,21,21,21,21,21,21,21,21,21,
+22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,
+22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,70,75,75,22,22,22,22,22,22,22,22,22,22,22,22,22,
+49,75,49,114,112,114,112,13,49,13,10,13,10,13,10,13,61,51,61,120,121,13,10,13,10,13,10,13,10,13,10,13,
+10,13,10,13,10,13,10,13,10,51,60,13,61,51,60,122,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,
+10,13,10,13,10,13,10,13,10,13,10,13,10,51,123,41,10,13,10,13,10,13,10,13,10,13,10,13,10,51,60,124,
+10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,61,51,
+61,51,61,51,61,51,61,51,61,51,61,51,64,75,10,13,10,68,68,13,125,126,13,13,13,13,13,13,13,13,10,13,
+10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,
+10,13,10,13,10,13,10,69,62,69,127,128,10,13,10,13,62,69,127,69,10,13,10,13,10,13,10,13,10,13,10,13,
+61,51,61,51,61,51,61,51,61,51,61,51,10,13,10,73,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,
+106,106,106,106,106,106,106,106,129,129,129,129,129,129,129,129,130,106,106,106,106,106,14,14,129,129,129,10,10,10,14,14,
+106,106,106,106,106,106,106,13,10,10,10,10,10,10,10,10,106,106,106,106,106,106,106,106,129,129,129,129,129,129,129,131,
+106,106,106,106,106,106,14,14,129,129,129,129,129,129,14,14,106,106,106,106,106,106,106,106,14,129,14,129,14,129,14,129,
+106,106,106,106,106,106,106,106,129,129,129,129,129,129,129,129,106,106,106,106,106,106,106,106,106,106,106,106,106,106,14,14,
+106,106,106,106,106,106,106,106,132,132,132,132,132,20,20,20,106,106,106,106,106,106,106,106,132,132,132,132,132,132,132,132,
+106,106,106,106,106,106,106,106,132,132,132,132,132,132,132,132,106,106,106,106,106,14,106,106,129,129,129,129,132,133,106,134,
+11,11,13,13,13,0,13,13,10,10,10,10,20,11,11,11,13,13,13,13,0,0,13,13,10,10,10,10,0,11,11,11,
+13,13,13,13,13,13,13,13,10,10,10,10,10,11,11,11,0,0,13,13,13,0,13,13,10,10,10,10,20,11,11,0,
+94,2,2,2,2,2,2,2,2,2,2,17,17,17,17,17,8,8,8,8,8,8,3,3,16,19,5,16,16,19,5,16,
+3,3,3,3,3,3,3,3,135,136,17,17,17,17,17,2,3,3,3,3,3,3,3,3,3,16,19,3,3,3,3,12,
+12,3,3,3,7,5,6,3,3,3,3,3,3,3,3,3,3,3,7,3,12,3,3,3,3,3,3,3,3,3,3,2,
+17,17,17,17,17,0,17,17,17,17,17,17,17,17,17,17,18,21,0,0,18,18,18,18,18,18,7,7,7,5,6,21,
+18,18,18,18,18,18,18,18,18,18,7,7,7,5,6,0,21,21,21,21,21,21,21,21,21,21,21,21,21,0,0,0,
+4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,
+4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,22,22,22,22,22,22,22,22,22,22,22,22,22,23,23,23,
+23,22,23,23,23,22,22,22,22,22,22,22,22,22,22,22,22,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+14,14,10,14,14,14,14,10,14,14,13,10,10,10,13,13,10,10,10,13,14,10,14,14,7,10,10,10,10,10,14,14,
+14,14,14,14,10,14,10,14,10,14,10,10,10,10,14,13,10,10,10,10,13,15,15,15,15,13,14,14,13,13,10,10,
+7,7,7,7,7,10,13,13,13,13,14,7,14,14,13,14,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,
+100,100,100,100,100,100,100,100,100,100,100,100,100,100,100,100,100,100,100,100,100,100,100,100,100,100,100,100,100,100,100,100,
+100,100,100,10,13,100,100,100,100,18,14,14,0,0,0,0,7,7,7,7,7,14,14,14,14,14,7,7,14,14,14,14,
+7,14,14,7,14,14,7,14,14,14,14,14,14,14,7,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,7,7,14,14,7,14,7,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,7,7,7,7,7,7,7,7,7,7,7,7,
+7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+14,14,14,14,14,14,14,14,5,6,5,6,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+7,7,14,14,14,14,14,14,14,5,6,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,7,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,7,7,7,7,7,
+7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,7,7,7,7,
+7,7,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+14,14,14,14,14,14,14,14,14,14,14,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,
+18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,7,14,14,14,14,14,14,14,14,
+14,7,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,7,7,7,7,7,7,7,7,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,7,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,5,6,5,6,5,6,5,6,5,6,5,6,5,6,18,18,18,18,18,18,18,18,18,18,
+18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+7,7,7,7,7,5,6,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+7,7,7,7,7,7,5,6,5,6,5,6,5,6,5,6,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+7,7,7,5,6,5,6,5,6,5,6,5,6,5,6,5,6,5,6,5,6,5,6,5,6,7,7,7,7,7,7,7,
+7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,5,6,5,6,7,7,7,7,
+7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,5,6,7,7,
+7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+7,7,7,7,7,7,7,7,7,7,7,7,7,137,7,7,137,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+7,7,7,7,7,14,14,7,7,7,7,7,7,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,30,15,0,14,14,14,14,14,14,14,14,14,14,
+14,30,30,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,0,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,
+10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,
+13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,
+10,13,10,10,10,13,13,10,13,10,13,10,13,10,10,10,10,13,10,13,13,10,13,13,13,13,13,13,21,21,10,10,
+10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,
+10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,
+10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,
+10,13,10,13,13,14,14,14,14,14,30,61,13,10,13,22,22,22,10,13,0,0,0,0,0,3,3,3,3,18,3,3,
+13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,
+13,13,13,13,13,13,0,13,0,0,0,0,0,13,0,0,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,0,0,0,0,0,0,0,21,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,22,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,0,0,0,0,0,0,0,0,0,
+15,15,15,15,15,15,15,0,15,15,15,15,15,15,15,0,15,15,15,15,15,15,15,0,15,15,15,15,15,15,15,0,
+15,15,15,15,15,15,15,0,15,15,15,15,15,15,15,0,15,15,15,15,15,15,15,0,15,15,15,15,15,15,15,0,
+22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,
+3,3,16,19,16,19,3,3,3,16,19,3,16,19,3,3,3,3,3,3,3,3,3,8,3,3,8,3,16,19,3,3,
+16,19,5,6,5,6,5,6,5,6,3,3,3,3,3,21,3,3,3,3,3,3,3,3,3,3,8,8,3,3,3,3,
+8,3,5,3,3,3,3,3,3,3,3,3,3,3,3,3,14,14,3,3,3,5,6,5,6,5,6,5,6,8,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,0,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,30,30,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,30,14,14,14,14,14,14,14,14,14,14,14,14,14,14,0,0,0,0,0,0,0,0,0,0,0,0,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,
+30,30,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+94,3,3,3,14,21,15,100,5,6,5,6,5,6,5,6,5,6,14,14,5,6,5,6,5,6,5,6,8,5,6,6,
+14,100,100,100,100,100,100,100,100,100,22,22,22,22,24,24,8,21,21,21,21,21,14,14,100,100,100,21,15,3,14,14,
+0,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,0,0,22,22,11,11,21,21,15,
+8,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,3,21,21,21,15,
+0,0,0,0,0,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,0,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,0,14,14,18,18,18,18,14,14,14,14,14,14,14,14,14,14,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,0,0,0,0,0,0,0,0,0,14,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,0,
+18,18,18,18,18,18,18,18,18,18,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,30,14,14,14,14,14,
+14,14,14,14,14,14,14,14,18,18,18,18,18,18,18,18,14,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+18,18,18,18,18,18,18,18,18,18,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,18,18,18,18,18,18,18,18,18,18,18,18,18,18,18,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+15,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,15,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+15,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,21,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,0,0,0,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,
+14,14,14,14,14,14,14,0,0,0,0,0,0,0,0,0,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,21,21,21,21,21,21,3,3,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,21,3,3,3,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+9,9,9,9,9,9,9,9,9,9,15,15,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,
+10,13,10,13,10,13,10,13,10,13,10,13,10,13,15,22,23,23,23,3,22,22,22,22,22,22,22,22,22,22,3,21,
+10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,21,21,22,22,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,100,100,100,100,100,100,100,100,100,100,22,22,3,3,3,3,3,3,0,0,0,0,0,0,0,0,
+11,11,11,11,11,11,11,11,11,11,11,11,11,11,11,11,11,11,11,11,11,11,11,21,21,21,21,21,21,21,21,21,
+11,11,10,13,10,13,10,13,10,13,10,13,10,13,10,13,13,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,
+10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,
+10,13,10,13,10,13,10,13,10,13,10,13,10,13,10,13,21,13,13,13,13,13,13,13,13,10,13,10,13,10,10,13,
+10,13,10,13,10,13,10,13,21,11,11,10,13,10,13,15,10,13,10,13,13,13,10,13,10,13,10,13,10,13,10,13,
+10,13,10,13,10,13,10,13,10,13,10,10,10,10,10,13,10,10,10,10,10,13,10,13,10,13,10,13,10,13,10,13,
+10,13,10,13,10,10,10,10,13,10,13,10,10,13,0,0,10,13,0,13,0,13,10,13,10,13,10,13,10,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,21,21,21,10,13,15,21,21,13,15,15,15,15,15,
+15,15,22,15,15,15,22,15,15,15,15,22,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,24,24,22,22,24,14,14,14,14,22,0,0,0,18,18,18,18,18,18,14,14,4,14,0,0,0,0,0,0,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,3,3,3,3,0,0,0,0,0,0,0,0,
+24,24,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,24,24,24,24,24,24,24,24,24,24,24,24,
+24,24,24,24,22,22,0,0,0,0,0,0,0,0,3,3,9,9,9,9,9,9,9,9,9,9,0,0,0,0,0,0,
+22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,15,15,15,15,15,15,3,3,3,15,3,15,15,22,
+9,9,9,9,9,9,9,9,9,9,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,22,22,22,22,22,22,22,22,3,3,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,22,22,22,22,22,22,22,22,22,22,22,24,24,0,0,0,0,0,0,0,0,0,0,0,3,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,0,0,0,
+22,22,22,24,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,22,24,24,22,22,22,22,24,24,22,22,24,24,
+24,3,3,3,3,3,3,3,3,3,3,3,3,3,0,21,9,9,9,9,9,9,9,9,9,9,0,0,0,0,3,3,
+15,15,15,15,15,22,21,15,15,15,15,15,15,15,15,15,9,9,9,9,9,9,9,9,9,9,15,15,15,15,15,0,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,22,22,22,22,22,22,24,24,22,22,24,24,22,22,0,0,0,0,0,0,0,0,0,
+15,15,15,22,15,15,15,15,15,15,15,15,22,24,0,0,9,9,9,9,9,9,9,9,9,9,0,0,3,3,3,3,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,21,15,15,15,15,15,15,14,14,14,15,24,22,24,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,22,15,22,22,22,15,15,22,22,15,15,15,15,15,22,22,
+15,22,15,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,15,15,21,3,3,
+15,15,15,15,15,15,15,15,15,15,15,24,22,22,24,24,3,3,15,21,21,24,22,0,0,0,0,0,0,0,0,0,
+0,15,15,15,15,15,15,0,0,15,15,15,15,15,15,0,0,15,15,15,15,15,15,0,0,0,0,0,0,0,0,0,
+15,15,15,15,15,15,15,0,15,15,15,15,15,15,15,0,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,
+13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,11,21,21,21,21,
+13,13,13,13,13,13,13,13,13,21,11,11,0,0,0,0,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,
+13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,
+13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,24,24,22,24,24,22,24,24,3,24,22,0,0,9,9,9,9,9,9,9,9,9,9,0,0,0,0,0,0,
+15,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,15,0,0,0,0,0,0,0,0,0,0,0,0,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,0,0,0,0,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,0,0,0,0,
+17,0,17,17,17,17,17,17,0,0,0,0,0,0,0,0,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,0,0,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+13,13,13,13,13,13,13,0,0,0,0,0,0,0,0,0,0,0,0,13,13,13,13,13,0,0,0,0,0,15,22,15,
+15,15,15,15,15,15,15,15,15,7,15,15,15,15,15,15,15,15,15,15,15,15,15,0,15,15,15,15,15,0,15,0,
+15,15,0,15,15,0,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,11,11,11,11,11,11,11,11,11,11,11,11,11,11,
+11,11,11,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,6,5,
+14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,0,0,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,0,0,0,0,0,0,0,14,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,15,15,15,15,15,15,15,15,15,15,15,15,4,14,14,14,
+22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,3,3,3,3,3,3,3,5,6,3,0,0,0,0,0,0,
+22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,3,8,8,12,12,5,6,5,6,5,6,5,6,5,6,5,
+6,5,6,5,6,3,3,5,6,3,3,3,3,12,12,12,3,3,3,0,3,3,3,3,8,5,6,5,6,5,6,3,
+3,3,7,8,7,7,7,0,3,4,3,3,0,0,0,0,15,15,15,15,15,0,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,0,0,17,
+0,3,3,3,4,3,3,3,5,6,3,7,3,8,3,3,9,9,9,9,9,9,9,9,9,9,3,3,7,7,7,3,
+3,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,5,3,6,11,12,
+11,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,5,7,6,7,5,
+6,3,5,6,3,3,15,15,15,15,15,15,15,15,15,15,21,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,21,21,
+15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,0,
+0,0,15,15,15,15,15,15,0,0,15,15,15,15,15,15,0,0,15,15,15,15,15,15,0,0,15,15,15,0,0,0,
+4,4,7,11,14,4,4,0,14,7,7,7,7,14,14,0,0,0,0,0,0,0,0,0,0,17,17,17,14,14,0,0,
+};
+
+const uint64_t unicode_category_sets_[138] = {
+0x0000000000000000ULL,
+0x0000000200000000ULL,
+0x0000000020000000ULL,
+0x0000000000400000ULL,
+0x0000000002000000ULL,
+0x0000000000040000ULL,
+0x0000000000080000ULL,
+0x0000000001000000ULL,
+0x0000000000020000ULL,
+0x0000000000001000ULL,
+0x0000000000000002ULL,
+0x0000000004000000ULL,
+0x0000000000010000ULL,
+0x0000000000000004ULL,
+0x0000000008000000ULL,
+0x0000000000000040ULL,
+0x0000000000100000ULL,
+0x0000000400000000ULL,
+0x0000000000004000ULL,
+0x0000000000200000ULL,
+0x0000000000000008ULL,
+0x0000000000000020ULL,
+0x0000000000000100ULL,
+0x0000000000000400ULL,
+0x0000000000000200ULL,
+0x0000000000404040ULL,
+0x0000000000004040ULL,
+0x0000000008004040ULL,
+0x0000000000002040ULL,
+0x0000000008006040ULL,
+0x0000000008000040ULL,
+0x0000000008000140ULL,
+0x0000000000000240ULL,
+0x0000000000000140ULL,
+0x0000000000004100ULL,
+0x0000000000004140ULL,
+0x0000000000002140ULL,
+0x0000000000400140ULL,
+0x0000000000402100ULL,
+0x0000000000001002ULL,
+0x0000000000001006ULL,
+0x0000000000001004ULL,
+0x0000000000001040ULL,
+0x0000000000401000ULL,
+0x0000000000400002ULL,
+0x0000000000400006ULL,
+0x0000000000400004ULL,
+0x0000000000400240ULL,
+0x0000000000000202ULL,
+0x0000000000000102ULL,
+0x0000000000000106ULL,
+0x0000000000000044ULL,
+0x0000000000000060ULL,
+0x0000000000404140ULL,
+0x0000000008004240ULL,
+0x0000000000004200ULL,
+0x0000000000004240ULL,
+0x0000000000405040ULL,
+0x0000000000401040ULL,
+0x0000000008004000ULL,
+0x0000000000000142ULL,
+0x0000000000000042ULL,
+0x0000000000004002ULL,
+0x0000000000404042ULL,
+0x0000000000004042ULL,
+0x0000000008000042ULL,
+0x0000000000004142ULL,
+0x0000000000400042ULL,
+0x0000000000000006ULL,
+0x0000000000004004ULL,
+0x0000000000000144ULL,
+0x0000000000001064ULL,
+0x0000000000020126ULL,
+0x0000000001000004ULL,
+0x0000000000020144ULL,
+0x0000000000000104ULL,
+0x0000000000004044ULL,
+0x0000000000404104ULL,
+0x0000000000400144ULL,
+0x0000000000400040ULL,
+0x0000000000004060ULL,
+0x0000000000000340ULL,
+0x0000000000005040ULL,
+0x0000000400400340ULL,
+0x0000000400400140ULL,
+0x0000000000001140ULL,
+0x0000000000400340ULL,
+0x0000000000401140ULL,
+0x0000000008405040ULL,
+0x000000000a004040ULL,
+0x000000000a000040ULL,
+0x0000000008400040ULL,
+0x0000000400000040ULL,
+0x0000000000020040ULL,
+0x0000000020000040ULL,
+0x0000000000040040ULL,
+0x0000000000080040ULL,
+0x0000000008400140ULL,
+0x0000000008400060ULL,
+0x0000000000400060ULL,
+0x0000000000002000ULL,
+0x0000000000000120ULL,
+0x0000000000400120ULL,
+0x0000000008400000ULL,
+0x0000000008000100ULL,
+0x0000000008000200ULL,
+0x0000000008000004ULL,
+0x0000000008000304ULL,
+0x0000000400000304ULL,
+0x0000000008000104ULL,
+0x0000000000004020ULL,
+0x0000000008000020ULL,
+0x0000000000000022ULL,
+0x0000000000000026ULL,
+0x0000000000000024ULL,
+0x0000000001000006ULL,
+0x0000000001000024ULL,
+0x0000000001001006ULL,
+0x0000000008000120ULL,
+0x0000000008400120ULL,
+0x0000000000000124ULL,
+0x0000000008001042ULL,
+0x0000000002001004ULL,
+0x0000000000000162ULL,
+0x0000000000401044ULL,
+0x0000000000000126ULL,
+0x0000000000401004ULL,
+0x0000000008004002ULL,
+0x0000000002004004ULL,
+0x0000000008000002ULL,
+0x0000000008004004ULL,
+0x000000000c000002ULL,
+0x0000000008000008ULL,
+0x000000000c000000ULL,
+0x0000000004001000ULL,
+0x0000000040000000ULL,
+0x0000000080000000ULL,
+0x0000000001000040ULL,
+};
+// GENERATED UNICODE CATEGORY TABLES END
+
 const char **unicode_lookup_category_parts(const char *category)
 {
 #define X(cat,name,strings,explanation) \
@@ -945,6 +1868,53 @@ UNICODE_CATEGORIES
     return false;
 }
 
+uint64_t unicode_categories_of(int code)
+{
+    if (code < 0 || code > 0x10ffff) return 0;
+
+    size_t page = unicode_category_page_index_[code >> UNICODE_CATEGORY_PAGE_BITS];
+    return unicode_category_sets_[unicode_category_pages_[(page << UNICODE_CATEGORY_PAGE_BITS) | (code & (UNICODE_CATEGORY_PAGE_SIZE-1))]];
+}
+
+uint64_t unicode_category_mask(const char *category)
+{
+    const char **parts = unicode_lookup_category_parts(category);
+    if (!parts) return 0;
+
+    uint64_t mask = 0;
+    for (; *parts; ++parts)
+    {
+#define X(cat,name,strings,explanation) \
+        if (!strcmp(*parts, #cat)) mask |= ((uint64_t)1) << UNICODE_CATEGORY_##cat;
+UNICODE_CATEGORIES
+#undef X
+    }
+    return mask;
+}
+
+bool unicode_has_category(int code, uint64_t mask)
+{
+    return (unicode_categories_of(code) & mask) != 0;
+}
+
+int unicode_next_code_with_category(int code, uint64_t mask)
+{
+    if (code < 0) code = 0;
+
+    while (code <= 0x10ffff)
+    {
+        // Skip the pages without any category quickly.
+        if (unicode_category_page_index_[code >> UNICODE_CATEGORY_PAGE_BITS] == 0)
+        {
+            code = ((code >> UNICODE_CATEGORY_PAGE_BITS) + 1) << UNICODE_CATEGORY_PAGE_BITS;
+            continue;
+        }
+        if (unicode_has_category(code, mask)) return code;
+        code++;
+    }
+    return -1;
+}
+
 bool category_has_code(int code, int *cat, size_t cat_len)
 {
     if (cat_len == 0) return false;
@@ -1007,11 +1977,15 @@ unsigned char hex_value(char c)
 
 bool is_unicode_whitespace(const char *start, const char *stop)
 {
-    size_t n = count_whitespace(start, stop);
-
     // Single char whitespace is ' ' '\t' '\n' '\r'
     // First unicode whitespace is 160 nbsp require two or more chars.
-    return n > 1;
+    if (stop - start < 2 || (*start & 0x80) == 0) return false;
+
+    int uc = 0;
+    size_t len = 0;
+    if (!decode_utf8(start, stop, &uc, &len)) return false;
+
+    return unicode_has_category(uc, ((uint64_t)1) << UNICODE_CATEGORY_Zs);
 }
 
 bool ends_with(const char *start, const char *stop, const char *pattern)
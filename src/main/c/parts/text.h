@@ -26,6 +26,7 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include"xmq.h"
 #include<stdbool.h>
+#include<stdint.h>
 #include<stdlib.h>
 
 /**
@@ -84,6 +85,20 @@ bool unicode_get_category_part(const char *part, int **out_cat, size_t *out_cat_
 
 bool category_has_code(int code, int *cat, size_t cat_len);
 
+// Return the mask of the categories the code point belongs to using the two level category table,
+// or 0 if the code point has no category.
+uint64_t unicode_categories_of(int code);
+
+// Return a bitmask with a bit for each category part of the given name, 0 if no such category.
+// For input "L" the bits for Lu Ll Lt Lm Lo are set.
+uint64_t unicode_category_mask(const char *category);
+
+// Test if the code point belongs to any of the categories in the mask.
+bool unicode_has_category(int code, uint64_t mask);
+
+// Return the first code point at or after code that belongs to the mask, -1 if there is none.
+int unicode_next_code_with_category(int code, uint64_t mask);
+
 bool ends_with(const char *start, const char *stop, const char *pattern);
 
 #define TEXT_MODULE
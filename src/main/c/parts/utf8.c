@@ -9,6 +9,68 @@
 
 #ifdef UTF8_MODULE
 
+/**
+   find_plain_utf8_run:
+   @ps: The print state.
+   @start: First byte to scan.
+   @stop: Points to byte after last byte. If NULL then stop at the terminating zero.
+   @u_len: Incremented with the number of characters in the run.
+
+   Find a run of bytes that can be written as is, ie that needs no escaping for the
+   render format, no replacement of space/tab and no coloring of unicode whitespace.
+   Such bytes are all 7-bit ascii except the few escaped ones and all utf8 sequences
+   except those starting with a lead byte of a Zs space: 0xc2 (nbsp), 0xe1 (ogham space mark),
+   0xe2 (the quads and spaces) and 0xe3 (ideographic space).
+   The characters are counted exactly as print_utf8_internal would count them, ie
+   per byte if stop is NULL. Returns a pointer to the first byte that needs the per
+   character path, or stop.
+*/
+const char *find_plain_utf8_run(XMQPrintState *ps, const char *start, const char *stop, size_t *u_len)
+{
+    XMQOutputSettings *os = ps->output_settings;
+
+    // Bit n set in the mask means that ascii char n needs the per character path.
+    uint64_t lo = 1; // Always stop at the zero byte.
+    uint64_t hi = 0;
+    if (!os->explicit_space || strcmp(os->explicit_space, " ")) lo |= 1ull << ' ';
+    if (!os->explicit_tab || strcmp(os->explicit_tab, "\t")) lo |= 1ull << '\t';
+    if (os->render_to == XMQ_RENDER_HTML)
+    {
+        lo |= (1ull << '&') | (1ull << '<') | (1ull << '>');
+    }
+    else if (os->render_to == XMQ_RENDER_TEX)
+    {
+        lo |= (1ull << '&') | (1ull << '#') | (1ull << '\'');
+        hi |= (1ull << ('\\'-64)) | (1ull << ('{'-64)) | (1ull << ('}'-64)) | (1ull << ('_'-64));
+    }
+
+    size_t u = 0;
+    const char *i = start;
+    while (!stop || i < stop)
+    {
+        unsigned char c = *i;
+        if (c < 64)
+        {
+            if ((lo >> c) & 1) break;
+        }
+        else if (c < 128)
+        {
+            if ((hi >> (c-64)) & 1) break;
+        }
+        else if (stop && (c == 0xc2 || (c >= 0xe1 && c <= 0xe3)))
+        {
+            // Potential unicode whitespace.
+            break;
+        }
+        // Without a stop every byte is counted as a character.
+        if (!stop || (c & 0xc0) != 0x80 || i == start) u++;
+        i++;
+    }
+
+    *u_len += u;
+    return i;
+}
+
 size_t print_utf8_char(XMQPrintState *ps, const char *start, const char *stop)
 {
     XMQOutputSettings *os = ps->output_settings;
@@ -57,6 +119,43 @@ size_t print_utf8_char(XMQPrintState *ps, const char *start, const char *stop)
     return j-start;
 }
 
+/**
+   print_utf8_chars:
+   @ps: The print state.
+   @start: First utf8 char to print.
+   @stop: Points to byte after the last char.
+
+   Prints the same as calling print_utf8_char repeatedly from start to stop,
+   but writes the runs of plain chars using a single write.
+   Returns the number of bytes printed, ie stop-start.
+*/
+size_t print_utf8_chars(XMQPrintState *ps, const char *start, const char *stop)
+{
+    XMQOutputSettings *os = ps->output_settings;
+    XMQWrite write = os->content.write;
+    void *writer_state = os->content.writer_state;
+
+    const char *i = start;
+    while (i < stop)
+    {
+        size_t u_len = 0;
+        const char *j = find_plain_utf8_run(ps, i, stop, &u_len);
+        if (j > i)
+        {
+            write(writer_state, i, j);
+            ps->current_indent += u_len;
+            // Remember the first byte of the last char, as print_utf8_char does.
+            const char *last = j-1;
+            while (last > i && (*last & 0xc0) == 0x80) last--;
+            ps->last_char = *last;
+            i = j;
+            continue;
+        }
+        i += print_utf8_char(ps, i, stop);
+    }
+    return stop-start;
+}
+
 /**
    print_utf8_internal: Print a single string
    ps: The print state.
@@ -78,6 +177,15 @@ size_t print_utf8_internal(XMQPrintState *ps, const char *start, const char *sto
     const char *i = start;
     while (*i && (!stop || i < stop))
     {
+        // Write as many plain chars as possible using a single write.
+        const char *run = find_plain_utf8_run(ps, i, stop, &u_len);
+        if (run > i)
+        {
+            write(writer_state, i, run);
+            i = run;
+            continue;
+        }
+
         // Find next utf8 char....
         const char *j = i+1;
         while (j < stop && (*j & 0xc0) == 0x80) j++;
@@ -36,7 +36,9 @@ typedef struct XMQPrintState XMQPrintState;
 enum XMQColor;
 typedef enum XMQColor XMQColor;
 
+const char *find_plain_utf8_run(XMQPrintState *ps, const char *start, const char *stop, size_t *u_len);
 size_t print_utf8_char(XMQPrintState *ps, const char *start, const char *stop);
+size_t print_utf8_chars(XMQPrintState *ps, const char *start, const char *stop);
 size_t print_utf8_internal(XMQPrintState *ps, const char *start, const char *stop);
 size_t print_utf8(XMQPrintState *ps, XMQColor c, size_t num_pairs, ...);
 
@@ -28,12 +28,15 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include<ctype.h>
 #include<errno.h>
 #include<math.h>
+#include<pthread.h>
 #include<setjmp.h>
 #include<stdarg.h>
 #include<stdbool.h>
+#include<stdint.h>
 #include<stdio.h>
 #include<stdlib.h>
 #include<string.h>
+#include<time.h>
 #include<unistd.h>
 
 #include"xmq.h"
@@ -42,6 +45,7 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include<libxml/HTMLparser.h>
 #include<libxml/HTMLtree.h>
 #include<libxml/xmlreader.h>
+#include<libxml/xmlsave.h>
 #include<libxml/xpath.h>
 #include<libxml/xpathInternals.h>
 
@@ -118,6 +122,10 @@ typedef struct XMQReturnXMLNode XMQReturnXMLNode;
 
 #define MAGIC_COOKIE 7287528
 
+// Json literals shorter than this are stored inline in the unused properties and nsDef
+// pointers of the text node, the same room that libxml uses for short text.
+#define JSON_INLINE_LITERAL_MAX (2*sizeof(void*))
+
 struct XMQDoc
 {
     union {
@@ -139,8 +147,73 @@ struct XMQDoc
     YaepParseRun *yaep_parse_run_; // The currently executing parse variables.
     YaepGrammar *yaep_grammar_; // The yaep grammar to be used by the run.
     XMQParseState *xmq_parse_state_; // The parse state used to parse the ixml grammar.
+    bool json_literals_; // The text of short json numbers, booleans and null is stored inline in the text nodes.
 };
 
+/**
+    XMQJsonLines:
+    @i: Start of the next line to parse.
+    @stop: Points to byte after the last byte in the buffer.
+    @line: Line number of the next line, used for error messages.
+    @implicit_root: Passed on to the json parser.
+    @output_settings: Required by the parse state, reused for all records.
+    @callbacks: The dom building callbacks, reused for all records.
+    @state: The parse state, reset and reused for each record.
+
+    Reads json lines, ie one json value per line, one record at a time.
+*/
+struct XMQJsonLines
+{
+    const char *i;
+    const char *stop;
+    size_t line;
+    const char *implicit_root;
+    XMQOutputSettings *output_settings;
+    XMQParseCallbacks *callbacks;
+    XMQParseState *state;
+};
+
+/**
+    XMQFixup:
+    @XMQ_FIXUP_COMMENTS: Unescape the xml comments, after reading xml/html.
+    @XMQ_FIXUP_TRIM: Trim whitespace according to the trim flags, after reading.
+    @XMQ_FIXUP_HTML: Escape the comments and turn cdata into text, before writing xml/html.
+    @XMQ_FIXUP_JSON: Collapse mixed text and entities into a single text, before writing json.
+
+    The dom fixups that can be combined into a single traversal of the document.
+    The fixups are applied to each node in this order.
+*/
+enum XMQFixup
+{
+    XMQ_FIXUP_COMMENTS = 1,
+    XMQ_FIXUP_TRIM = 2,
+    XMQ_FIXUP_HTML = 4,
+    XMQ_FIXUP_JSON = 8
+};
+typedef enum XMQFixup XMQFixup;
+
+/**
+    XMQFixupWalk:
+    @doq: The document being fixed up.
+    @flags: The trim flags used by XMQ_FIXUP_TRIM.
+    @depth: The depth of the visited node, the document children have depth 0.
+    @inside_cdata_declared: Used by XMQ_FIXUP_HTML, the visited node is inside a style or script element.
+
+    The state of a traversal applying several fixups. A fixup visits a node and may replace
+    or remove it (the node pointer is updated or set to NULL). It returns true if it
+    should also visit the children of the node.
+*/
+struct XMQFixupWalk
+{
+    XMQDoc *doq;
+    int flags;
+    int depth;
+    bool inside_cdata_declared;
+};
+typedef struct XMQFixupWalk XMQFixupWalk;
+
+typedef bool (*XMQFixupVisit)(XMQFixupWalk *walk, xmlNode **node);
+
 #ifdef __cplusplus
 enum Level : short {
 #else
@@ -154,6 +227,48 @@ enum Level {
 };
 typedef enum Level Level;
 
+/**
+    XMQCompiledTheme:
+    @theme_spec: The resolved theme spec, eg "dark" or "mono,red" that was installed.
+    @render_to: The render format the theme was set up for.
+    @dark_mode: The theme was set up for a dark background.
+    @use_color, @truecolor, @render_raw, @use_id, @use_class: The remaining settings the setup depends on.
+    @theme: The fully set up theme, never modified after compilation.
+    @indentation_space, @explicit_space, @explicit_tab, @explicit_cr, @explicit_nl: Whitespace strings for the output settings.
+    @free_me, @free_and_me: Buffers allocated by the setup, referenced from the theme.
+
+    A theme spec plus render format compiled once and cached for the lifetime of the process.
+    Output settings reference it instead of setting up their own copy, which makes it
+    cheap to create settings per document and safe to share the theme between threads.
+*/
+struct XMQCompiledTheme
+{
+    char *theme_spec;
+    XMQRenderFormat render_to;
+    bool dark_mode;
+    bool use_color;
+    bool truecolor;
+    bool render_raw;
+    char *use_id;
+    char *use_class;
+
+    XMQTheme *theme;
+
+    const char *indentation_space;
+    const char *explicit_space;
+    const char *explicit_tab;
+    const char *explicit_cr;
+    const char *explicit_nl;
+
+    void *free_me;
+    void *free_and_me;
+
+    struct XMQCompiledTheme *next;
+};
+typedef struct XMQCompiledTheme XMQCompiledTheme;
+
+#define XMQ_MAX_COMPILED_THEMES 32
+
 /**
     XMQOutputSettings:
     @add_indent: Default is 4. Indentation starts at 0 which means no spaces prepended.
@@ -161,6 +276,7 @@ typedef enum Level Level;
     @escape_newlines: Replace newlines with &#10; this is implied if compact is set.
     @escape_non_7bit: Replace all chars above 126 with char entities, ie &#10;
     @escape_tabs: Replace tabs with &#9;
+    @json_lines: Print json as one compact record per line, a root array prints each member as a record.
     @allow_json_quotes: Allow quoting with "..." for content with no newlines but single quotes.
     @always_json_quotes: Always quote using "..." when quoting is needed.
     @output_format: Print xmq/xml/html/json
@@ -185,8 +301,10 @@ struct XMQOutputSettings
     bool escape_newlines;
     bool escape_non_7bit;
     bool escape_tabs;
+    bool json_lines;
     bool allow_json_quotes;
     bool always_json_quotes;
+    int  print_threads; // Render large runs of siblings using this many threads, 0 or 1 prints serially.
 
     XMQContentType output_format;
     XMQRenderFormat render_to;
@@ -216,6 +334,7 @@ struct XMQOutputSettings
     const char *use_class; // If non-NULL insert this class in the pre tag.
 
     XMQTheme *theme; // The theme used to print.
+    XMQCompiledTheme *compiled_theme; // If non-NULL then theme is shared with this cached compiled theme.
     void *free_me;
     void *free_and_me;
 };
@@ -247,6 +366,11 @@ struct IXMLCharset
     // Charset contents.
     IXMLCharsetPart *first;
     IXMLCharsetPart *last;
+    // The charset is handed to yaep as a single class terminal with this name
+    // and interval table, sorted inclusive from,to pairs of code points.
+    char *class_name;
+    int *intervals;
+    int num_intervals;
 };
 typedef struct IXMLCharset IXMLCharset;
 
@@ -284,6 +408,47 @@ struct IXMLRule
 };
 typedef struct IXMLRule IXMLRule;
 
+/**
+   XMQJsonKey:
+   @raw: Copy of the key bytes found between the quotes, NULL if the slot is empty.
+   @raw_len: Number of bytes in the key.
+   @hash: Hash of the key bytes.
+   @name_len: Length of the key when the [n] index suffix has been dropped.
+   @colon: Offset of the namespace colon, zero if there is no namespace prefix.
+   @safe: True if the key without index suffix is a valid element name.
+*/
+struct XMQJsonKey
+{
+    char *raw;
+    size_t raw_len;
+    size_t hash;
+    size_t name_len;
+    size_t colon;
+    bool safe;
+};
+typedef struct XMQJsonKey XMQJsonKey;
+
+/**
+   XMQJsonKeyCache:
+   @slots: Open addressing table of the object keys seen so far.
+   @size: Number of slots, a power of two.
+   @used: Number of occupied slots.
+
+   Used by the json parser to resolve repeated object keys with a single hash probe.
+   The cache is kept in the parse state and survives the json lines records.
+*/
+struct XMQJsonKeyCache
+{
+    XMQJsonKey *slots;
+    size_t size;
+    size_t used;
+};
+typedef struct XMQJsonKeyCache XMQJsonKeyCache;
+
+// The seen unicode code points are tracked in pages of 4096 code points.
+#define XMQ_UNICODE_PAGE_SIZE 4096
+#define XMQ_NUM_UNICODE_PAGES (0x110000/XMQ_UNICODE_PAGE_SIZE)
+
 struct XMQParseState
 {
     char *source_name; // Only used for generating any error messages.
@@ -313,6 +478,15 @@ struct XMQParseState
     bool parsing_pi; // True when parsing a processing instruction, pi.
     bool merge_text; // Merge text nodes and character entities.
     bool no_trim_quotes; // No trimming if quotes, used when reading json strings.
+    bool json_literal; // True when the element value text is a json number, boolean or null.
+    bool json_use_index; // Build the json index before parsing, set by XMQ_FLAG_JSON_INDEX.
+    uint32_t *json_index; // Offsets of the json tokens, string ends and newlines between tokens, found by build_json_index.
+    size_t json_index_size; // Number of offsets in the json index.
+    size_t json_index_capacity; // Allocated number of offsets.
+    size_t json_index_pos; // Next offset in the json index to visit.
+    XMQJsonKeyCache json_keys; // The already processed object keys.
+    XMQJsonKey *json_key; // The cached key of the member being parsed.
+    Stack *json_transcode_strings; // Decoded keys and quotes held by the json transcoder, freed if it falls back to the dom.
     bool ixml_all_parses; // If IXML parse is ambiguous then print all parses.
     bool ixml_try_to_recover; // If IXML parse fails, try to recover.
     const char *pi_name; // Name of the pi node just started.
@@ -397,6 +571,7 @@ struct XMQParseState
     int *yaep_tmp_transl_;
     HashMapIterator *yaep_i_;
     size_t yaep_j_;
+    size_t yaep_k_;
 
     // When debugging parsing of ixml, track indentation of depth here.
     int depth;
@@ -404,9 +579,61 @@ struct XMQParseState
     bool build_xml_of_ixml;
 
     // When fixing ixml and using --lines the already added unicode chars
-    // are stored here between lines.
-    char *used_unicodes;
+    // are stored here between lines. A bitset is allocated for each page
+    // of XMQ_UNICODE_PAGE_SIZE code points when a char in the page is first seen.
+    uint64_t *used_unicode_pages[XMQ_NUM_UNICODE_PAGES];
+
+    // The number of terminals and rules in the yaep grammar when it was last compiled.
+    // If the content scan adds neither, the compiled yaep grammar is reused.
+    bool yaep_grammar_compiled_;
+    size_t yaep_compiled_terminals_;
+    size_t yaep_compiled_rules_;
+};
+
+// Must be a power of two.
+#define XMQ_NAME_WIDTH_CACHE_SIZE 256
+
+/**
+   XMQNameWidth:
+   @name: Pointer to a node/attribute/namespace name, used as the cache key.
+   @u_width: The number of unicode characters in the name.
+*/
+struct XMQNameWidth
+{
+    const char *name;
+    size_t u_width;
+};
+typedef struct XMQNameWidth XMQNameWidth;
+
+/**
+   XMQJsonKeyCount:
+   @name: A json key, ie the name of a child element, NULL if the slot is empty.
+   @total: The number of siblings with this key.
+   @used: The number of siblings with this key printed so far.
+*/
+struct XMQJsonKeyCount
+{
+    const char *name;
+    size_t total;
+    size_t used;
+};
+typedef struct XMQJsonKeyCount XMQJsonKeyCount;
+
+/**
+   XMQJsonKeyTables:
+   @slots: Storage for the open addressing tables of the objects being printed.
+   @top: The first free slot, every nested object pushes its table above its parent's table.
+   @size: The allocated number of slots, only grows during a print.
+
+   Used by the json printer to count repeated keys without allocating per object.
+*/
+struct XMQJsonKeyTables
+{
+    XMQJsonKeyCount *slots;
+    size_t top;
+    size_t size;
 };
+typedef struct XMQJsonKeyTables XMQJsonKeyTables;
 
 /**
    XMQPrintState:
@@ -421,6 +648,8 @@ struct XMQParseState
    @ns: the last namespace reference.
    @output_settings: the output settings.
    @doc: The xmq document that is being printed.
+   @name_widths: cache of the unicode widths of names used when aligning = signs.
+   @json_keys: scratch tables for detecting repeated keys when printing json.
 */
 struct XMQPrintState
 {
@@ -436,6 +665,8 @@ struct XMQPrintState
     Stack *post_nodes; // Used to remember ending comments when printing json.
     XMQOutputSettings *output_settings;
     XMQDoc *doq;
+    XMQNameWidth name_widths[XMQ_NAME_WIDTH_CACHE_SIZE];
+    XMQJsonKeyTables json_keys;
 };
 typedef struct XMQPrintState XMQPrintState;
 
@@ -493,6 +724,11 @@ const char *find_word_ignore_case(const char *start, const char *stop, const cha
 void setup_terminal_coloring(XMQOutputSettings *os, XMQTheme *c, bool dark_mode, bool use_color, bool truecolor, bool render_raw);
 void setup_html_coloring(XMQOutputSettings *os, XMQTheme *c, bool dark_mode, bool use_color, bool render_raw);
 void setup_tex_coloring(XMQOutputSettings *os, XMQTheme *c, bool dark_mode, bool use_color, bool render_raw);
+void setup_theme(XMQOutputSettings *os, XMQTheme *theme, bool dark_mode);
+XMQCompiledTheme *find_or_compile_theme(XMQOutputSettings *os, bool dark_mode);
+bool compiled_theme_matches(XMQCompiledTheme *ct, XMQOutputSettings *os, bool dark_mode);
+XMQCompiledTheme *compile_theme(XMQOutputSettings *os, bool dark_mode);
+void use_compiled_theme(XMQOutputSettings *os, XMQCompiledTheme *ct);
 
 // XMQ tokenizer functions ///////////////////////////////////////////////////////////
 
@@ -503,7 +739,6 @@ XMQReturnString xmq_trim_quote(const char *start, const char *stop, bool is_xmq,
 char *escape_xml_comment(const char *comment);
 char *unescape_xml_comment(const char *comment);
 void xmq_fixup_html_before_writeout(XMQDoc *doq);
-void xmq_fixup_comments_after_readin(XMQDoc *doq);
 
 char *xmq_comment(int indent,
                  const char *start,
@@ -515,8 +750,12 @@ XMQReturnString xmq_un_quote(const char *start, const char *stop, bool remove_qs
 // XML/HTML dom functions ///////////////////////////////////////////////////////////////
 
 xmlDtdPtr parse_doctype_raw(XMQDoc *doq, const char *start, const char *stop);
-void trim_node(xmlNode *node, int flags);
-void trim_text_node(xmlNode *node, int flags);
+bool trim_text_node(xmlNode *node, int flags);
+void xmq_fixup_doc(XMQDoc *doq, int fixups, int flags);
+void fixup_walk_node(XMQFixupWalk *walk, xmlNode *node, int fixups);
+bool fixup_comments_visit(XMQFixupWalk *walk, xmlNode **node);
+bool fixup_trim_visit(XMQFixupWalk *walk, xmlNode **node);
+bool fixup_html_visit(XMQFixupWalk *walk, xmlNode **node);
 
 // Output buffer functions ////////////////////////////////////////////////////////
 
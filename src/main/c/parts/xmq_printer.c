@@ -7,8 +7,11 @@
 #include"xml.h"
 #include"xmq_parser.h"
 #include"xmq_printer.h"
+#include"membuffer.h"
+#include"stack.h"
 
 #include<assert.h>
+#include<pthread.h>
 #include<string.h>
 #include<stdbool.h>
 
@@ -16,9 +19,70 @@
 
 #ifdef XMQ_PRINTER_MODULE
 
-size_t find_attr_key_max_u_width(xmlAttr *a);
+/**
+    XMQPrintChunk:
+    @from: First sibling in the chunk.
+    @stop: The sibling after the chunk, NULL if the chunk ends the siblings.
+    @from_index: The position of from among the siblings.
+    @prev: The sibling before from, rendered and discarded to find the state to start the chunk in.
+    @prev_align: The key alignment in use at prev.
+    @align: The key alignment in use at from.
+    @restart_find_at_node: Where the alignment group following from starts.
+    @start_last_char: The last_char the chunk was rendered after.
+    @start_current_indent: The current_indent the chunk was rendered at.
+    @end_last_char: The last_char after the chunk.
+    @end_current_indent: The current_indent after the chunk.
+    @output: The rendered chunk.
+*/
+struct XMQPrintChunk
+{
+    xmlNode *from;
+    xmlNode *stop;
+    size_t from_index;
+    xmlNode *prev;
+    size_t prev_align;
+    size_t align;
+    xmlNode *restart_find_at_node;
+    int start_last_char;
+    size_t start_current_indent;
+    int end_last_char;
+    size_t end_current_indent;
+    MemBuffer *output;
+};
+typedef struct XMQPrintChunk XMQPrintChunk;
+
+/**
+    XMQPrintWorkers:
+    @ps: The print state of the caller, only read by the workers.
+    @print_run: Prints the siblings of a chunk.
+    @data: Passed on to print_run.
+    @chunks: The chunks to render.
+    @num_chunks: Number of chunks.
+    @next_chunk: The next chunk to be picked up by a worker.
+    @lock: Protects next_chunk.
+*/
+struct XMQPrintWorkers
+{
+    XMQPrintState *ps;
+    XMQPrintRun print_run;
+    void *data;
+    XMQPrintChunk *chunks;
+    size_t num_chunks;
+    size_t next_chunk;
+    pthread_mutex_t lock;
+};
+typedef struct XMQPrintWorkers XMQPrintWorkers;
+
+size_t cached_name_u_width(XMQPrintState *ps, const char *name);
+size_t attr_key_u_width(XMQPrintState *ps, xmlAttr *a);
+size_t element_key_u_width(XMQPrintState *ps, xmlNodePtr node);
+size_t find_attr_key_max_u_width(XMQPrintState *ps, xmlAttr *a);
 size_t find_namespace_max_u_width(size_t max, xmlNs *ns);
-size_t find_element_key_max_width(xmlNodePtr node, xmlNodePtr *restart_find_at_node);
+size_t find_element_key_max_width(XMQPrintState *ps, xmlNodePtr node, xmlNodePtr *restart_find_at_node);
+void print_chunk(XMQPrintWorkers *w, XMQPrintChunk *c);
+void *print_worker(void *w);
+bool write_print_chunk(void *buffer, const char *start, const char *stop);
+bool write_print_nothing(void *buffer, const char *start, const char *stop);
 const char *toHtmlEntity(int uc);
 void node_strlen_name_prefix(xmlNode *node, const char **name, size_t *name_len, const char **prefix, size_t *prefix_len, size_t *total_len);
 
@@ -213,18 +277,59 @@ size_t count_necessary_slashes(const char *start, const char *stop)
     return max+1;
 }
 
+/**
+  Return the unicode character width of a name. Names read from xml/html are interned
+  in the libxml2 dictionary, so the same pointer shows up for every sibling with the
+  same name. The dom is not modified while printing, so the pointer is a safe cache key.
+*/
+size_t cached_name_u_width(XMQPrintState *ps, const char *name)
+{
+    uintptr_t h = (uintptr_t)name;
+    h ^= h >> 4;
+    h ^= h >> 9;
+    XMQNameWidth *e = &ps->name_widths[h & (XMQ_NAME_WIDTH_CACHE_SIZE-1)];
+
+    if (e->name != name)
+    {
+        size_t b_len;
+        size_t u_len;
+        str_b_u_len(name, NULL, &b_len, &u_len);
+        e->name = name;
+        e->u_width = u_len;
+    }
+    return e->u_width;
+}
+
+/**
+  Width of attribute key including any namespace prefix and colon.
+*/
+size_t attr_key_u_width(XMQPrintState *ps, xmlAttr *a)
+{
+    size_t w = cached_name_u_width(ps, (const char*)a->name);
+    if (a->ns && a->ns->prefix) w += cached_name_u_width(ps, (const char*)a->ns->prefix) + 1;
+    return w;
+}
+
+/**
+  Width of element key including any namespace prefix and colon.
+*/
+size_t element_key_u_width(XMQPrintState *ps, xmlNodePtr node)
+{
+    if (!node->name) return 0;
+    size_t w = cached_name_u_width(ps, (const char*)node->name);
+    if (node->ns && node->ns->prefix) w += cached_name_u_width(ps, (const char*)node->ns->prefix) + 1;
+    return w;
+}
+
 /**
   Scan the attribute names and find the max unicode character width.
 */
-size_t find_attr_key_max_u_width(xmlAttr *a)
+size_t find_attr_key_max_u_width(XMQPrintState *ps, xmlAttr *a)
 {
     size_t max = 0;
     while (a)
     {
-        const char *name;
-        const char *prefix;
-        size_t total_u_len;
-        attr_strlen_name_prefix(a, &name, &prefix, &total_u_len);
+        size_t total_u_len = attr_key_u_width(ps, a);
 
         if (total_u_len > max) max = total_u_len;
         a = xml_next_attribute(a);
@@ -235,9 +340,11 @@ size_t find_attr_key_max_u_width(xmlAttr *a)
 /**
   Scan nodes until there is a node which is not suitable for using the = sign.
   I.e. it has multiple children or no children. This node unsuitable node is stored in
-  restart_find_at_node or NULL if all nodes were suitable.
+  restart_find_at_node or NULL if all nodes were suitable. If the scan starts on
+  unsuitable nodes, then skip them all in one go and restart at the next suitable node,
+  the skipped nodes are not aligned and get width 0.
 */
-size_t find_element_key_max_width(xmlNodePtr element, xmlNodePtr *restart_find_at_node)
+size_t find_element_key_max_width(XMQPrintState *ps, xmlNodePtr element, xmlNodePtr *restart_find_at_node)
 {
     size_t max = 0;
     xmlNodePtr i = element;
@@ -245,14 +352,14 @@ size_t find_element_key_max_width(xmlNodePtr element, xmlNodePtr *restart_find_a
     {
         if (!is_key_value_node(i) || xml_first_attribute(i))
         {
-            if (i == element) *restart_find_at_node = xml_next_sibling(i);
-            else *restart_find_at_node = i;
+            if (i == element)
+            {
+                do i = xml_next_sibling(i); while (i && (!is_key_value_node(i) || xml_first_attribute(i)));
+            }
+            *restart_find_at_node = i;
             return max;
         }
-        const char *name;
-        const char *prefix;
-        size_t total_u_len;
-        element_strlen_name_prefix(i, &name, &prefix, &total_u_len);
+        size_t total_u_len = element_key_u_width(ps, i);
 
         if (total_u_len > max) max = total_u_len;
         i = xml_next_sibling(i);
@@ -281,17 +388,34 @@ size_t find_namespace_max_u_width(size_t max, xmlNs *ns)
 }
 
 void print_nodes(XMQPrintState *ps, xmlNode *from, xmlNode *to, size_t align)
+{
+    // In compact mode everything ends up on a single line and each chunk would depend
+    // on the exact column it starts at, so compact output is always printed serially.
+    if (!ps->output_settings->compact &&
+        print_nodes_parallel(ps, from, NULL, true, true, print_node_run, NULL)) return;
+
+    print_node_run(ps, NULL, from, NULL, 0, 0, from);
+}
+
+void print_node_run(XMQPrintState *ps,
+                    void *data,
+                    xmlNode *from,
+                    xmlNode *stop,
+                    size_t from_index,
+                    size_t align,
+                    xmlNode *restart_find_at_node)
 {
     xmlNode *i = from;
-    xmlNode *restart_find_at_node = from;
-    size_t max = 0;
+    size_t max = align;
+    bool compact = ps->output_settings->compact;
 
-    while (i)
+    while (i != stop)
     {
         // We need to search ahead to find the max width of the node names so that we can align the equal signs.
-        if (!ps->output_settings->compact && i == restart_find_at_node)
+        // Each alignment group (a run of key=value siblings) is measured once.
+        if (!compact && i == restart_find_at_node)
         {
-            max = find_element_key_max_width(i, &restart_find_at_node);
+            max = find_element_key_max_width(ps, i, &restart_find_at_node);
         }
 
         print_node(ps, i, max);
@@ -299,6 +423,195 @@ void print_nodes(XMQPrintState *ps, xmlNode *from, xmlNode *to, size_t align)
     }
 }
 
+/**
+    print_nodes_parallel:
+    @ps: The print state, updated as if the siblings were printed serially.
+    @from: First sibling to print.
+    @stop: Stop before this sibling, NULL prints all remaining siblings.
+    @align_keys: Track the key alignment groups (xmq) when splitting the siblings into chunks.
+    @depends_on_indent: The output of a chunk depends on the current_indent it starts at.
+    @print_run: Prints the siblings of a chunk.
+    @data: Passed on to print_run.
+
+    Split a long run of siblings into chunks that are rendered into separate buffers
+    by print_threads threads. The chunks are then written in order. A chunk (except the first)
+    is rendered after rendering and discarding its preceding sibling, which in practice always
+    results in the same last_char (and current_indent) as the serial printing would have reached.
+    If the state differs anyway, then the chunk is printed again serially. Thus the output is
+    always identical to the serial output.
+
+    Returns false, having printed nothing, if the siblings should be printed serially.
+*/
+bool print_nodes_parallel(XMQPrintState *ps,
+                          xmlNode *from,
+                          xmlNode *stop,
+                          bool align_keys,
+                          bool depends_on_indent,
+                          XMQPrintRun print_run,
+                          void *data)
+{
+    int num_threads = ps->output_settings->print_threads;
+    if (num_threads <= 1) return false;
+
+    // The leading/ending comments and doctype stored for json are consumed when printing
+    // the top level object. This must happen in order, so do not split anything until then.
+    if (ps->pre_nodes && ps->pre_nodes->size > 0) return false;
+    if (ps->post_nodes && ps->post_nodes->size > 0) return false;
+
+    size_t num_nodes = 0;
+    for (xmlNode *i = from; i != stop; i = xml_next_sibling(i)) num_nodes++;
+    if (num_nodes < XMQ_PARALLEL_PRINT_MIN_NODES) return false;
+
+    size_t num_chunks = num_threads * XMQ_PARALLEL_PRINT_CHUNKS_PER_THREAD;
+    if (num_chunks > num_nodes / XMQ_PARALLEL_PRINT_MIN_CHUNK_NODES)
+    {
+        num_chunks = num_nodes / XMQ_PARALLEL_PRINT_MIN_CHUNK_NODES;
+    }
+    size_t chunk_size = (num_nodes + num_chunks - 1) / num_chunks;
+    num_chunks = (num_nodes + chunk_size - 1) / chunk_size;
+
+    XMQPrintChunk *chunks = (XMQPrintChunk*)calloc(num_chunks, sizeof(XMQPrintChunk));
+
+    // Find where each chunk starts and which alignment group is in use there.
+    xmlNode *prev = NULL;
+    xmlNode *restart_find_at_node = from;
+    size_t align = 0;
+    size_t prev_align = 0;
+    size_t n = 0;
+    for (xmlNode *i = from; i != stop; i = xml_next_sibling(i), n++)
+    {
+        if (align_keys && i == restart_find_at_node)
+        {
+            align = find_element_key_max_width(ps, i, &restart_find_at_node);
+        }
+        if (n % chunk_size == 0)
+        {
+            XMQPrintChunk *c = &chunks[n / chunk_size];
+            if (n > 0) (c-1)->stop = i;
+            c->from = i;
+            c->from_index = n;
+            c->prev = prev;
+            c->prev_align = prev_align;
+            c->align = align;
+            c->restart_find_at_node = restart_find_at_node;
+            c->output = new_membuffer();
+        }
+        prev = i;
+        prev_align = align;
+    }
+    chunks[num_chunks-1].stop = stop;
+
+    XMQPrintWorkers w = {};
+    w.ps = ps;
+    w.print_run = print_run;
+    w.data = data;
+    w.chunks = chunks;
+    w.num_chunks = num_chunks;
+    pthread_mutex_init(&w.lock, NULL);
+
+    // The calling thread is also a worker.
+    size_t num_workers = (size_t)num_threads - 1;
+    if (num_workers > num_chunks - 1) num_workers = num_chunks - 1;
+    pthread_t *workers = (pthread_t*)malloc(num_workers * sizeof(pthread_t));
+    size_t started = 0;
+    while (started < num_workers && !pthread_create(&workers[started], NULL, print_worker, &w)) started++;
+
+    print_worker(&w);
+
+    for (size_t t = 0; t < started; ++t) pthread_join(workers[t], NULL);
+    free(workers);
+    pthread_mutex_destroy(&w.lock);
+
+    XMQWrite write = ps->output_settings->content.write;
+    void *writer_state = ps->output_settings->content.writer_state;
+
+    for (size_t k = 0; k < num_chunks; ++k)
+    {
+        XMQPrintChunk *c = &chunks[k];
+        if (c->start_last_char == ps->last_char &&
+            (!depends_on_indent || c->start_current_indent == ps->current_indent))
+        {
+            if (c->output->used_ > 0)
+            {
+                write(writer_state, c->output->buffer_, c->output->buffer_ + c->output->used_);
+            }
+            ps->last_char = c->end_last_char;
+            ps->current_indent += c->end_current_indent - c->start_current_indent;
+        }
+        else
+        {
+            // The guess was wrong, print the chunk again with the correct state.
+            print_run(ps, data, c->from, c->stop, c->from_index, c->align, c->restart_find_at_node);
+        }
+        free_membuffer_and_free_content(c->output);
+    }
+
+    free(chunks);
+    return true;
+}
+
+void *print_worker(void *worker_state)
+{
+    XMQPrintWorkers *w = (XMQPrintWorkers*)worker_state;
+
+    for (;;)
+    {
+        pthread_mutex_lock(&w->lock);
+        size_t k = w->next_chunk++;
+        pthread_mutex_unlock(&w->lock);
+
+        if (k >= w->num_chunks) break;
+        print_chunk(w, &w->chunks[k]);
+    }
+    return NULL;
+}
+
+void print_chunk(XMQPrintWorkers *w, XMQPrintChunk *c)
+{
+    XMQOutputSettings os = *w->ps->output_settings;
+    // No nested threads inside a worker.
+    os.print_threads = 1;
+
+    XMQPrintState ps = *w->ps;
+    ps.output_settings = &os;
+    ps.pre_nodes = NULL;
+    ps.post_nodes = NULL;
+    memset(&ps.json_keys, 0, sizeof(ps.json_keys));
+
+    if (c->prev)
+    {
+        // Any non-zero last_char will do as a start for prev, since it is the state
+        // after prev that matters.
+        ps.last_char = '}';
+        os.content.write = write_print_nothing;
+        os.content.writer_state = NULL;
+        w->print_run(&ps, w->data, c->prev, c->from, c->from_index - 1, c->prev_align, c->restart_find_at_node);
+    }
+
+    c->start_last_char = ps.last_char;
+    c->start_current_indent = ps.current_indent;
+
+    os.content.write = write_print_chunk;
+    os.content.writer_state = c->output;
+    w->print_run(&ps, w->data, c->from, c->stop, c->from_index, c->align, c->restart_find_at_node);
+
+    c->end_last_char = ps.last_char;
+    c->end_current_indent = ps.current_indent;
+
+    free(ps.json_keys.slots);
+}
+
+bool write_print_chunk(void *buffer, const char *start, const char *stop)
+{
+    membuffer_append_region((MemBuffer*)buffer, start, stop);
+    return true;
+}
+
+bool write_print_nothing(void *buffer, const char *start, const char *stop)
+{
+    return true;
+}
+
 void print_content_node(XMQPrintState *ps, xmlNode *node)
 {
     print_value(ps, node, NULL, NULL, LEVEL_XMQ, false);
@@ -509,21 +822,40 @@ void print_element_with_children(XMQPrintState *ps,
                                  xmlNode *node,
                                  size_t align)
 {
-    print_element_name_and_attributes(ps, node);
+    print_element_open(ps, node);
 
     void *from = xml_first_child(node);
     void *to = xml_last_child(node);
 
-    check_space_before_opening_brace(ps);
-    print_utf8(ps, COLOR_brace_left, 1, "{", NULL);
-
-    ps->line_indent += ps->output_settings->add_indent;
-
     while (xml_prev_sibling((xmlNode*)from)) from = xml_prev_sibling((xmlNode*)from);
     assert(from != NULL);
 
     print_nodes(ps, (xmlNode*)from, (xmlNode*)to, align);
 
+    print_element_close(ps);
+}
+
+/**
+    print_element_open:
+    @ps: The print state.
+    @node: The element with children.
+
+    Print the element name, the attributes and the opening brace.
+    The children are then printed one indentation level deeper,
+    until print_element_close is called.
+*/
+void print_element_open(XMQPrintState *ps, xmlNode *node)
+{
+    print_element_name_and_attributes(ps, node);
+
+    check_space_before_opening_brace(ps);
+    print_utf8(ps, COLOR_brace_left, 1, "{", NULL);
+
+    ps->line_indent += ps->output_settings->add_indent;
+}
+
+void print_element_close(XMQPrintState *ps)
+{
     ps->line_indent -= ps->output_settings->add_indent;
 
     check_space_before_closing_brace(ps);
@@ -643,6 +975,210 @@ void print_node(XMQPrintState *ps, xmlNode *node, size_t align)
     return print_element_with_children(ps, node, align);
 }
 
+/**
+    use_compact_printer:
+    @os: The output settings.
+
+    The compact printer can be used for uncoloured compact output
+    where no whitespace or newline replacements have been requested.
+*/
+bool use_compact_printer(XMQOutputSettings *os)
+{
+    if (!os->compact || os->use_color || os->render_to != XMQ_RENDER_PLAIN) return false;
+    if (os->prefix_line || os->postfix_line) return false;
+    if (os->theme && (os->theme->whitespace.pre || os->theme->whitespace.post)) return false;
+
+    return
+        (!os->indentation_space || !strcmp(os->indentation_space, " ")) &&
+        (!os->explicit_space || !strcmp(os->explicit_space, " ")) &&
+        (!os->explicit_tab || !strcmp(os->explicit_tab, "\t"));
+}
+
+/**
+    compact_print_nodes:
+    @ps: The print state.
+    @from: The first sibling to print.
+
+    Print the siblings in compact form, identical to print_nodes with compact set,
+    but without the alignment, indentation and color handling. Elements, attributes
+    and plain text values are written directly, everything else is handed over to the
+    normal printer functions which already know how to print in compact form.
+    The current_indent is not maintained since it is never used in compact output.
+*/
+void compact_print_nodes(XMQPrintState *ps, xmlNode *from)
+{
+    for (xmlNode *i = from; i; i = xml_next_sibling(i))
+    {
+        compact_print_node(ps, i);
+    }
+}
+
+void compact_print_node(XMQPrintState *ps, xmlNode *node)
+{
+    if (node->type != XML_ELEMENT_NODE)
+    {
+        // Content, entities, comments, pi and doctype nodes.
+        print_node(ps, node, 0);
+        return;
+    }
+
+    XMQWrite write = ps->output_settings->content.write;
+    void *writer_state = ps->output_settings->content.writer_state;
+
+    compact_print_name_and_attributes(ps, node);
+
+    if (is_leaf_node(node)) return;
+
+    if (is_key_value_node(node))
+    {
+        write(writer_state, "=", NULL);
+        ps->last_char = '=';
+        compact_print_value(ps, xml_first_child(node), LEVEL_ELEMENT_VALUE);
+        return;
+    }
+
+    write(writer_state, "{", NULL);
+    ps->last_char = '{';
+    compact_print_nodes(ps, xml_first_child(node));
+    write(writer_state, "}", NULL);
+    ps->last_char = '}';
+}
+
+/**
+    compact_print_element_open:
+    @ps: The print state.
+    @node: The element with children.
+
+    Print the element name, the attributes and the opening brace in compact form.
+*/
+void compact_print_element_open(XMQPrintState *ps, xmlNode *node)
+{
+    compact_print_name_and_attributes(ps, node);
+    ps->output_settings->content.write(ps->output_settings->content.writer_state, "{", NULL);
+    ps->last_char = '{';
+}
+
+void compact_print_element_close(XMQPrintState *ps)
+{
+    ps->output_settings->content.write(ps->output_settings->content.writer_state, "}", NULL);
+    ps->last_char = '}';
+}
+
+void compact_print_name_and_attributes(XMQPrintState *ps, xmlNode *node)
+{
+    XMQWrite write = ps->output_settings->content.write;
+    void *writer_state = ps->output_settings->content.writer_state;
+
+    if (need_separation_before_element_name(ps)) write(writer_state, " ", NULL);
+
+    if (node->ns && node->ns->prefix)
+    {
+        compact_print_text(ps, (const char*)node->ns->prefix, NULL);
+        write(writer_state, ":", NULL);
+        ps->last_char = ':';
+    }
+    compact_print_text(ps, (const char*)node->name, NULL);
+
+    xmlAttr *a = xml_first_attribute(node);
+    xmlNs *ns = xml_first_namespace_def(node);
+
+    if (!a && !ns) return;
+
+    write(writer_state, "(", NULL);
+    ps->last_char = '(';
+
+    for (; a; a = xml_next_attribute(a))
+    {
+        if (need_separation_before_attribute_key(ps)) write(writer_state, " ", NULL);
+
+        if (a->ns && a->ns->prefix)
+        {
+            compact_print_text(ps, (const char*)a->ns->prefix, NULL);
+            write(writer_state, ":", NULL);
+            ps->last_char = ':';
+        }
+        compact_print_text(ps, (const char*)a->name, NULL);
+
+        if (a->children != NULL && !is_single_empty_text_node(a->children))
+        {
+            write(writer_state, "=", NULL);
+            ps->last_char = '=';
+            compact_print_value(ps, a->children, LEVEL_ATTR_VALUE);
+        }
+    }
+
+    for (; ns; ns = xml_next_namespace_def(ns))
+    {
+        print_namespace_declaration(ps, ns, 0);
+    }
+
+    write(writer_state, ")", NULL);
+    ps->last_char = ')';
+}
+
+void compact_print_value(XMQPrintState *ps, xmlNode *node, Level level)
+{
+    if (node->next == NULL && !is_entity_node(node))
+    {
+        const char *start = xml_element_content(node);
+        const char *stop = start ? start+strlen(start) : NULL;
+        if (start && is_compact_text_value(ps, start, stop))
+        {
+            compact_print_text(ps, start, stop);
+            return;
+        }
+    }
+
+    // Quotes, entities and compounds.
+    print_value(ps, node, NULL, NULL, level, false);
+}
+
+/**
+    compact_print_text:
+    @ps: The print state.
+    @start: Text to print.
+    @stop: Points to after the text, or NULL if the text is zero terminated.
+
+    Write text that print_utf8 would copy unchanged, ie names and text values
+    when no whitespace replacements are in use.
+*/
+void compact_print_text(XMQPrintState *ps, const char *start, const char *stop)
+{
+    if (!stop) stop = start+strlen(start);
+    if (stop == start) return;
+
+    ps->output_settings->content.write(ps->output_settings->content.writer_state, start, stop);
+    ps->last_char = *(stop-1);
+}
+
+/**
+    is_compact_text_value:
+    @ps: The print state.
+    @start: Value to check.
+    @stop: Points to after the value.
+
+    Return true if the value would be printed by print_value as an unquoted text,
+    ie it is a non-empty xmq text value that does not need to be compounded.
+*/
+bool is_compact_text_value(XMQPrintState *ps, const char *start, const char *stop)
+{
+    if (start >= stop) return false;
+    if (unsafe_value_start(*start, start+1 < stop ? *(start+1) : 0)) return false;
+
+    bool non7bit = ps->output_settings->escape_non_7bit;
+
+    for (const char *i = start; i < stop; ++i)
+    {
+        unsigned char c = (unsigned char)*i;
+        if (c <= ' ' || c == '(' || c == ')' || c == '{' || c == '}' || c == '\'' || c == '"') return false;
+        if (c > 126)
+        {
+            if (non7bit || !is_safe_value_char(i, stop)) return false;
+        }
+    }
+    return true;
+}
+
 void print_white_spaces(XMQPrintState *ps, int num)
 {
     XMQOutputSettings *os = ps->output_settings;
@@ -1026,11 +1562,9 @@ void print_attribute(XMQPrintState *ps, xmlAttr *a, size_t align)
 {
     check_space_before_attribute(ps);
 
-    const char *key;
-    const char *prefix;
-    size_t total_u_len;
-
-    attr_strlen_name_prefix(a, &key, &prefix, &total_u_len);
+    const char *key = (const char*)a->name;
+    const char *prefix = NULL;
+    if (a->ns && a->ns->prefix) prefix = (const char*)a->ns->prefix;
 
     if (prefix)
     {
@@ -1055,7 +1589,7 @@ void print_attribute(XMQPrintState *ps, xmlAttr *a, size_t align)
 
     if (a->children != NULL && !is_single_empty_text_node(a->children))
     {
-        if (!ps->output_settings->compact) print_white_spaces(ps, 1+align-total_u_len);
+        if (!ps->output_settings->compact) print_white_spaces(ps, 1+align-attr_key_u_width(ps, a));
 
         print_utf8(ps, COLOR_equals, 1, "=", NULL);
 
@@ -1107,7 +1641,7 @@ void print_attributes(XMQPrintState *ps,
     xmlAttr *a = xml_first_attribute(node);
 
     size_t max = 0;
-    if (!ps->output_settings->compact) max = find_attr_key_max_u_width(a);
+    if (!ps->output_settings->compact) max = find_attr_key_max_u_width(ps, a);
 
     xmlNs *ns = xml_first_namespace_def(node);
     if (!ps->output_settings->compact) max = find_namespace_max_u_width(max, ns);
@@ -1170,7 +1704,9 @@ void print_quote_lines_and_color_uwhitespace(XMQPrintState *ps,
         }
         else
         {
-            i += print_utf8_char(ps, i, stop);
+            const char *eol = (const char*)memchr(i, '\n', stop-i);
+            if (!eol) eol = stop;
+            i += print_utf8_chars(ps, i, eol);
             all_newlines = false;
         }
     }
@@ -38,7 +38,30 @@ void annotate_offsets(xmlDoc *doc, const char *attribute_name, const char *ns);
 int count_necessary_quotes(const char *start, const char *stop, bool *add_nls, bool *add_compound, bool prefer_double_quotes, bool *use_double_quotes);
 size_t count_necessary_slashes(const char *start, const char *stop);
 
+// Runs of siblings shorter than this are always printed serially.
+#define XMQ_PARALLEL_PRINT_MIN_NODES 256
+// Never hand out a chunk with fewer siblings than this to a print worker.
+#define XMQ_PARALLEL_PRINT_MIN_CHUNK_NODES 32
+// Split the siblings into more chunks than threads to even out the load.
+#define XMQ_PARALLEL_PRINT_CHUNKS_PER_THREAD 4
+
+/**
+    XMQPrintRun:
+    @ps: The print state.
+    @data: Printer specific data, eg the json duplicate key counters.
+    @from: First sibling to print.
+    @stop: Stop before this sibling, NULL prints all remaining siblings.
+    @from_index: The position of from among all the siblings.
+    @align: The key alignment in use at from.
+    @restart_find_at_node: Where the next alignment group starts.
+
+    Print a run of siblings, used by print_nodes_parallel.
+*/
+typedef void (*XMQPrintRun)(XMQPrintState *ps, void *data, xmlNode *from, xmlNode *stop, size_t from_index, size_t align, xmlNode *restart_find_at_node);
+
 void print_nodes(XMQPrintState *ps, xmlNode *from, xmlNode *to, size_t align);
+void print_node_run(XMQPrintState *ps, void *data, xmlNode *from, xmlNode *stop, size_t from_index, size_t align, xmlNode *restart_find_at_node);
+bool print_nodes_parallel(XMQPrintState *ps, xmlNode *from, xmlNode *stop, bool align_keys, bool depends_on_indent, XMQPrintRun print_run, void *data);
 void print_content_node(XMQPrintState *ps, xmlNode *node);
 void print_entity_node(XMQPrintState *ps, xmlNode *node);
 void print_color_post(XMQPrintState *ps, XMQColor c);
@@ -55,10 +78,22 @@ void print_key_node(XMQPrintState *ps,
 void print_element_with_children(XMQPrintState *ps,
                                  xmlNode *node,
                                  size_t align);
+void print_element_open(XMQPrintState *ps, xmlNode *node);
+void print_element_close(XMQPrintState *ps);
 void print_doctype(XMQPrintState *ps, xmlNode *node);
 void print_pi_node(XMQPrintState *ps, xmlNode *node);
 void print_node(XMQPrintState *ps, xmlNode *node, size_t align);
 
+bool use_compact_printer(XMQOutputSettings *os);
+void compact_print_nodes(XMQPrintState *ps, xmlNode *from);
+void compact_print_node(XMQPrintState *ps, xmlNode *node);
+void compact_print_name_and_attributes(XMQPrintState *ps, xmlNode *node);
+void compact_print_element_open(XMQPrintState *ps, xmlNode *node);
+void compact_print_element_close(XMQPrintState *ps);
+void compact_print_value(XMQPrintState *ps, xmlNode *node, Level level);
+void compact_print_text(XMQPrintState *ps, const char *start, const char *stop);
+bool is_compact_text_value(XMQPrintState *ps, const char *start, const char *stop);
+
 void print_white_spaces(XMQPrintState *ps, int num);
 void print_all_whitespace(XMQPrintState *ps, const char *start, const char *stop, Level level);
 void print_explicit_spaces(XMQPrintState *ps, XMQColor c, int num);
@@ -83,10 +83,12 @@
 #ifndef BUILDING_DIST_XMQ
 
 #include <assert.h>
+#include <limits.h>
 #include <stdio.h>
 #include <stdarg.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #include "yaep_allocate.h"
 #include "yaep_cspc.h"
@@ -113,15 +115,30 @@
 
 static bool blocked_by_lookahead(YaepParseState *ps, YaepDottedRule *dotted_rule, YaepSymbol *symb, int n, const char *info);
 static bool core_has_not_rules(YaepStateSetCore *core);
+static void create_class_members(YaepParseState *ps);
 static void check_predicted_dotted_rules(YaepParseState *ps, YaepStateSet *set, YaepVect *predictions, int lookahead_term_id, int local_lookahead_level);
 static void check_leading_dotted_rules(YaepParseState *ps, YaepStateSet *set, int lookahead_term_id, int local_lookahead_level);
 static bool has_lookahead(YaepParseState *ps, YaepSymbol *symb, int n);
+static bool terminal_bitset_up_terminal(YaepParseState *ps, terminal_bitset_t *set, YaepSymbol *term);
 static int default_read_token(YaepParseRun *ps, void **attr);
 static void error_recovery(YaepParseState *ps, int *start, int *stop);
 static void error_recovery_init(YaepParseState *ps);
 static void free_error_recovery(YaepParseState *ps);
 static size_t memusage(YaepParseState *ps);
-static void read_input(YaepParseState *ps);
+static void free_parse_memory(YaepParseState *ps);
+static void free_dotted_rule_matched_length_sets(YaepParseState *ps);
+static void reset_tree_nodes(YaepParseState *ps);
+static void free_tree_nodes(YaepParseState *ps);
+static double now_seconds();
+static void fill_parse_stats(YaepParseState *ps, size_t mem, double parse_seconds, double tree_seconds);
+static bool input_has_token(YaepParseState *ps, int i);
+static void read_all_input(YaepParseState *ps);
+static void state_sets_put(YaepParseState *ps, int k, YaepStateSet *set);
+static void leo_init(YaepParseState *ps);
+static void free_leo(YaepParseState *ps);
+static YaepDottedRule *leo_waiting_dotted_rule(YaepParseState *ps, int state_set_k, YaepSymbol *symb, int *rule_index_in_core);
+static YaepLeoItem *leo_item_find(YaepParseState *ps, int state_set_k, YaepSymbol *symb);
+static void leo_add_top(YaepParseState *ps, YaepLeoItem *item);
 static void set_add_dotted_rule_with_matched_length(YaepParseState *ps, YaepDottedRule *dotted_rule, int matched_length, const char *why);
 static void set_add_dotted_rule_no_match_yet(YaepParseState *ps, YaepDottedRule *dotted_rule, const char *why);
 static void set_add_dotted_rule_with_parent(YaepParseState *ps, YaepDottedRule *dotted_rule, int parent_dotted_rule_id, const char *why);
@@ -261,8 +278,16 @@ static void rulestorage_free(YaepGrammar *grammar, YaepRuleStorage *rules)
 
 static void create_input(YaepParseState *ps)
 {
-    VLO_CREATE(ps->input_vlo, ps->run.grammar->alloc, NUM_INITIAL_YAEP_TOKENS * sizeof(YaepInputToken));
+    if (ps->parse_memory_p)
+    {
+        VLO_NULLIFY(ps->input_vlo);
+    }
+    else
+    {
+        VLO_CREATE(ps->input_vlo, ps->run.grammar->alloc, NUM_INITIAL_YAEP_TOKENS * sizeof(YaepInputToken));
+    }
     ps->input_len = 0;
+    ps->input_done_p = false;
 }
 
 /* Add input token with CODE and attribute at the end of input tokens array.*/
@@ -289,8 +314,17 @@ static void free_input(YaepParseState *ps)
 static void init_dotted_rules(YaepParseState *ps)
 {
     ps->num_all_dotted_rules = 0;
-    OS_CREATE(ps->dotted_rules_os, ps->run.grammar->alloc, 0);
-    VLO_CREATE(ps->dotted_rules_table_vlo, ps->run.grammar->alloc, 4096);
+    if (ps->parse_memory_p)
+    {
+        // The rows of the table are allocated again since the grammar might have changed.
+        OS_RESET(ps->dotted_rules_os);
+        VLO_NULLIFY(ps->dotted_rules_table_vlo);
+    }
+    else
+    {
+        OS_CREATE(ps->dotted_rules_os, ps->run.grammar->alloc, 0);
+        VLO_CREATE(ps->dotted_rules_table_vlo, ps->run.grammar->alloc, 4096);
+    }
     ps->dotted_rules_table = (YaepDottedRule***)VLO_BEGIN(ps->dotted_rules_table_vlo);
 }
 
@@ -308,7 +342,7 @@ static bool dotted_rule_calculate_lookahead(YaepParseState *ps, YaepDottedRule *
     }
     else
     {
-        dotted_rule->lookahead = terminal_bitset_create(ps);
+        dotted_rule->lookahead = terminal_bitset_create_for_parse(ps);
         terminal_bitset_clear(ps, dotted_rule->lookahead);
     }
 
@@ -322,7 +356,7 @@ static bool dotted_rule_calculate_lookahead(YaepParseState *ps, YaepDottedRule *
         {
             if (symb->is_terminal)
             {
-                terminal_bitset_up(ps, dotted_rule->lookahead, symb->u.terminal.term_id);
+                terminal_bitset_up_terminal(ps, dotted_rule->lookahead, symb);
             }
             else
             {
@@ -535,6 +569,13 @@ static bool stateset_term_lookahead_eq(YaepStateSetTermLookAhead *s1, YaepStateS
 /* Initiate the set of pairs(sit, dist). */
 static void dotted_rule_matched_length_set_init(YaepParseState *ps)
 {
+    if (ps->parse_memory_p)
+    {
+        // The set of the previous parse is kept, it is already cleared by the
+        // next increment of the generation. Start over before the generation wraps.
+        if (ps->dotted_rule_matched_length_vec_generation < INT_MAX / 2) return;
+        free_dotted_rule_matched_length_sets(ps);
+    }
     VLO_CREATE(ps->dotted_rule_matched_length_vec_vlo, ps->run.grammar->alloc, 8192);
     ps->dotted_rule_matched_length_vec_generation = 0;
 }
@@ -609,39 +650,58 @@ static void free_dotted_rule_matched_length_sets(YaepParseState *ps)
     VLO_DELETE(ps->dotted_rule_matched_length_vec_vlo);
 }
 
-/* Initialize work with sets for parsing input with N_INPUT tokens.*/
-static void set_init(YaepParseState *ps, int n_input)
+/* Initialize work with sets. The input length is not known since the
+   tokens are read as the parse advances, the hash tables grow as needed.
+   The sets of a previous parse are cleared and their memory reused.*/
+static void set_init(YaepParseState *ps)
 {
-    int n = n_input >> 3;
-
-    OS_CREATE(ps->set_cores_os, ps->run.grammar->alloc, 0);
-    OS_CREATE(ps->set_dotted_rules_os, ps->run.grammar->alloc, 2048);
-    OS_CREATE(ps->set_parent_dotted_rule_ids_os, ps->run.grammar->alloc, 2048);
-    OS_CREATE(ps->set_matched_lengths_os, ps->run.grammar->alloc, 2048);
-    OS_CREATE(ps->sets_os, ps->run.grammar->alloc, 0);
-    OS_CREATE(ps->set_term_lookahead_os, ps->run.grammar->alloc, 0);
+    if (ps->parse_memory_p)
+    {
+        OS_RESET(ps->set_cores_os);
+        OS_RESET(ps->set_dotted_rules_os);
+        OS_RESET(ps->set_parent_dotted_rule_ids_os);
+        OS_RESET(ps->set_matched_lengths_os);
+        OS_RESET(ps->sets_os);
+        OS_RESET(ps->set_term_lookahead_os);
+        empty_hash_table(ps->cache_stateset_cores);
+        empty_hash_table(ps->cache_stateset_matched_lengths);
+        empty_hash_table(ps->cache_stateset_core_matched_lengths);
+        empty_hash_table(ps->cache_stateset_term_lookahead);
+    }
+    else
+    {
+        OS_CREATE(ps->set_cores_os, ps->run.grammar->alloc, 0);
+        OS_CREATE(ps->set_dotted_rules_os, ps->run.grammar->alloc, 2048);
+        OS_CREATE(ps->set_parent_dotted_rule_ids_os, ps->run.grammar->alloc, 2048);
+        OS_CREATE(ps->set_matched_lengths_os, ps->run.grammar->alloc, 2048);
+        OS_CREATE(ps->sets_os, ps->run.grammar->alloc, 0);
+        OS_CREATE(ps->set_term_lookahead_os, ps->run.grammar->alloc, 0);
 
-    ps->cache_stateset_cores = create_hash_table(ps->run.grammar->alloc, 2000,
-                                                 (hash_table_hash_function)stateset_core_hash,
-                                                 (hash_table_eq_function)stateset_core_eq);
+        ps->cache_stateset_cores = create_hash_table(ps->run.grammar->alloc, 2000,
+                                                     (hash_table_hash_function)stateset_core_hash,
+                                                     (hash_table_eq_function)stateset_core_eq);
 
-    ps->cache_stateset_matched_lengths = create_hash_table(ps->run.grammar->alloc, n < 20000 ? 20000 : n,
-                                                           (hash_table_hash_function)matched_lengths_hash,
-                                                           (hash_table_eq_function)matched_lengths_eq);
+        ps->cache_stateset_matched_lengths = create_hash_table(ps->run.grammar->alloc, 20000,
+                                                               (hash_table_hash_function)matched_lengths_hash,
+                                                               (hash_table_eq_function)matched_lengths_eq);
 
-    ps->cache_stateset_core_matched_lengths = create_hash_table(ps->run.grammar->alloc, n < 20000 ? 20000 : n,
-                                                                (hash_table_hash_function)stateset_core_matched_lengths_hash,
-                                                                (hash_table_eq_function)stateset_core_matched_lengths_eq);
+        ps->cache_stateset_core_matched_lengths = create_hash_table(ps->run.grammar->alloc, 20000,
+                                                                    (hash_table_hash_function)stateset_core_matched_lengths_hash,
+                                                                    (hash_table_eq_function)stateset_core_matched_lengths_eq);
 
-    ps->cache_stateset_term_lookahead = create_hash_table(ps->run.grammar->alloc, n < 30000 ? 30000 : n,
-                                                          (hash_table_hash_function)stateset_term_lookahead_hash,
-                                                          (hash_table_eq_function)stateset_term_lookahead_eq);
+        ps->cache_stateset_term_lookahead = create_hash_table(ps->run.grammar->alloc, 30000,
+                                                              (hash_table_hash_function)stateset_term_lookahead_hash,
+                                                              (hash_table_eq_function)stateset_term_lookahead_eq);
+    }
 
     ps->num_set_cores = ps->num_set_core_start_dotted_rules= 0;
     ps->num_set_matched_lengths = ps->num_set_matched_lengths_len = ps->num_parent_dotted_rule_ids = 0;
     ps->num_sets_total = ps->num_dotted_rules_total= 0;
+    ps->n_set_lookups = ps->n_set_successes = 0;
     ps->num_set_term_lookahead = 0;
+    ps->n_goto_successes = ps->n_goto_lookups = 0;
     dotted_rule_matched_length_set_init(ps);
+    leo_init(ps);
 }
 
 static void debug_step(YaepParseState *ps, YaepDottedRule *dotted_rule, int matched_length, int parent_id)
@@ -875,6 +935,7 @@ static bool convert_leading_dotted_rules_into_new_set(YaepParseState *ps)
     ps->new_set = (YaepStateSet*)OS_TOP_BEGIN(ps->sets_os);
     ps->new_set->matched_lengths = ps->new_matched_lengths;
     ps->new_set->id = ps->num_sets_total;
+    ps->n_set_lookups++;
 
     yaep_trace(ps, "convert leading rules into s%d", ps->new_set->id);
 
@@ -992,6 +1053,7 @@ static bool convert_leading_dotted_rules_into_new_set(YaepParseState *ps)
     else
     {
         ps->new_set = *scm;
+        ps->n_set_successes++;
         OS_TOP_NULLIFY(ps->sets_os);
         yaep_trace(ps, "re-using s%d", ps->new_set->id);
     }
@@ -1012,11 +1074,12 @@ static void set_new_core_stop(YaepParseState *ps)
 
 static void free_sets(YaepParseState *ps)
 {
+    free_leo(ps);
     free_dotted_rule_matched_length_sets(ps);
-    delete_hash_table(ps->cache_stateset_term_lookahead);
-    delete_hash_table(ps->cache_stateset_core_matched_lengths);
-    delete_hash_table(ps->cache_stateset_matched_lengths);
-    delete_hash_table(ps->cache_stateset_cores);
+    delete_parse_hash_table(ps, ps->cache_stateset_term_lookahead);
+    delete_parse_hash_table(ps, ps->cache_stateset_core_matched_lengths);
+    delete_parse_hash_table(ps, ps->cache_stateset_matched_lengths);
+    delete_parse_hash_table(ps, ps->cache_stateset_cores);
     OS_DELETE(ps->set_term_lookahead_os);
     OS_DELETE(ps->sets_os);
     OS_DELETE(ps->set_parent_dotted_rule_ids_os);
@@ -1025,32 +1088,49 @@ static void free_sets(YaepParseState *ps)
     OS_DELETE(ps->set_cores_os);
 }
 
-/* Initialize work with the parser list.*/
-static void pl_init(YaepParseState *ps)
+/* The following function creates Earley's parser list.
+   The list is grown by state_sets_put as new state sets are built.*/
+static void allocate_state_sets(YaepParseState *ps)
 {
-    ps->state_sets = NULL;
+    if (ps->parse_memory_p)
+    {
+        VLO_NULLIFY(ps->state_sets_vlo);
+    }
+    else
+    {
+        VLO_CREATE(ps->state_sets_vlo, ps->run.grammar->alloc, NUM_INITIAL_YAEP_TOKENS * sizeof(YaepStateSet*));
+    }
+    ps->state_sets = (YaepStateSet**)VLO_BEGIN(ps->state_sets_vlo);
+    ps->state_set_k = -1;
 }
 
-/* The following function creates Earley's parser list.*/
-static void allocate_state_sets(YaepParseState *ps)
+/* Store SET at index K in the parser list. Because of error recovery
+   we may have up to 2 times more sets than tokens.*/
+static void state_sets_put(YaepParseState *ps, int k, YaepStateSet *set)
 {
-    /* Because of error recovery we may have sets 2 times more than tokens.*/
-    void *mem = yaep_malloc(ps->run.grammar->alloc, sizeof(YaepStateSet*)*(ps->input_len + 1)* 2);
-    ps->state_sets = (YaepStateSet**)mem;
-    ps->state_set_k = -1;
+    size_t len = (k + 1) * sizeof(YaepStateSet*);
+    if ((size_t)VLO_LENGTH(ps->state_sets_vlo) < len)
+    {
+        VLO_EXPAND(ps->state_sets_vlo, len - VLO_LENGTH(ps->state_sets_vlo));
+        ps->state_sets = (YaepStateSet**)VLO_BEGIN(ps->state_sets_vlo);
+    }
+    ps->state_sets[k] = set;
 }
 
 static void free_state_sets(YaepParseState *ps)
 {
     if (ps->state_sets != NULL)
     {
-        yaep_free(ps->run.grammar->alloc, ps->state_sets);
+        VLO_DELETE(ps->state_sets_vlo);
         ps->state_sets = NULL;
     }
 }
 
 static void verbose_stats(YaepParseState *ps)
 {
+    // Summing the memory usage walks all object stack segments, only do it when it is printed.
+    if (!xmq_verbose_enabled_) return;
+
     size_t size = memusage(ps);
     char *siz = humanReadableTwoDecimals(size);
     verbose("ixml=", "@%d/%d #sets=%d #cores=%d #dotted_rules=%d #matched_lengths=%d mem=%s",
@@ -1141,6 +1221,7 @@ void yaepResetParseRun(YaepParseRun *pr)
     }
     ps->run.failed_p = false;
     ps->run.ambiguous_p = false;
+    memset(&ps->run.stats, 0, sizeof(ps->run.stats));
 }
 
 void yaepFreeParseRun(YaepParseRun *pr)
@@ -1158,6 +1239,9 @@ void yaepFreeParseRun(YaepParseRun *pr)
     }
     ps->run.ambiguous_p = false;
 
+    free_parse_memory(ps);
+    free_tree_nodes(ps);
+
     free(ps);
 }
 
@@ -1199,6 +1283,42 @@ yaep_error_message(YaepGrammar*g)
     return g->error_message;
 }
 
+/* Set the bit for the terminal in the set. A class terminal also sets the
+   bits of all the terminals it matches, since those are the terminals
+   that can appear in the input. */
+static bool terminal_bitset_up_terminal(YaepParseState *ps, terminal_bitset_t *set, YaepSymbol *term)
+{
+    bool changed_p = terminal_bitset_up(ps, set, term->u.terminal.term_id);
+    if (term->u.terminal.is_class)
+    {
+        changed_p |= terminal_bitset_or(ps, set, term->u.terminal.class_members);
+    }
+    return changed_p;
+}
+
+/* The following function tests all terminals against the interval
+   tables of the class terminals and stores the matches as a bitset
+   in each class terminal.*/
+static void create_class_members(YaepParseState *ps)
+{
+    YaepSymbol *class_symb, *term;
+
+    for (int i = 0; (class_symb = class_get(ps, i)) != NULL; i++)
+    {
+        class_symb->u.terminal.class_members = terminal_bitset_create(ps);
+        terminal_bitset_clear(ps, class_symb->u.terminal.class_members);
+
+        for (int j = 0; (term = term_get(ps, j)) != NULL; j++)
+        {
+            if (term->u.terminal.is_class || term->u.terminal.code < 0) continue;
+            if (symb_class_has_code(class_symb, term->u.terminal.code))
+            {
+                terminal_bitset_up(ps, class_symb->u.terminal.class_members, term->u.terminal.term_id);
+            }
+        }
+    }
+}
+
 /* The following function creates sets FIRST and FOLLOW for all
    grammar nonterminals.*/
 static void create_first_follow_sets(YaepParseState *ps)
@@ -1236,8 +1356,7 @@ static void create_first_follow_sets(YaepParseState *ps)
                     {
                         if (first_continue_p)
                         {
-                            changed_p |= terminal_bitset_up(ps, symb->u.nonterminal.first,
-                                                            rhs_symb->u.terminal.term_id);
+                            changed_p |= terminal_bitset_up_terminal(ps, symb->u.nonterminal.first, rhs_symb);
                         }
                     }
                     else
@@ -1254,8 +1373,7 @@ static void create_first_follow_sets(YaepParseState *ps)
                             if (next_rhs_symb->is_terminal)
                             {
                                 changed_p
-                                    |= terminal_bitset_up(ps, rhs_symb->u.nonterminal.follow,
-                                                   next_rhs_symb->u.terminal.term_id);
+                                    |= terminal_bitset_up_terminal(ps, rhs_symb->u.nonterminal.follow, next_rhs_symb);
                             }
                             else
                             {
@@ -1447,6 +1565,8 @@ static void check_grammar(YaepParseState *ps, int strict_p)
                  symb->repr);
         }
     }
+    /* The first and follow sets include the terminals matched by class terminals.*/
+    create_class_members(ps);
     /* We should have correct flags empty_p here.*/
     create_first_follow_sets(ps);
 }
@@ -1460,11 +1580,13 @@ static void check_grammar(YaepParseState *ps, int strict_p)
 /* It should be negative.*/
 #define END_MARKER_CODE -1
 #define TERM_ERROR_CODE -2
+#define TERM_CLASS_CODE -3
 
 int yaep_read_grammar(YaepParseRun *pr,
                       YaepGrammar *g,
                       int strict_p,
                       const char*(*read_terminal)(YaepParseRun*pr,YaepGrammar*g,int*code),
+                      const char*(*read_class)(YaepParseRun*pr,YaepGrammar*g,const int**intervals,int*num_intervals),
                       const char*(*read_rule)(YaepParseRun*pr,YaepGrammar*g,const char***rhs,
                                               const char**abs_node,
                                               int*anode_cost, int**transl, char*mark, char**marks))
@@ -1477,6 +1599,8 @@ int yaep_read_grammar(YaepParseRun *pr,
     char mark;
     char*marks;
     int i, el, code;
+    const int *intervals;
+    int num_intervals;
 
     assert(g != NULL);
     YaepParseState *ps = (YaepParseState*)pr;
@@ -1510,6 +1634,16 @@ int yaep_read_grammar(YaepParseRun *pr,
         symb_add_terminal(ps, name, code);
     }
 
+    while (read_class && (name = (*read_class)(pr, pr->grammar, &intervals, &num_intervals)) != NULL)
+    {
+        if (symb_find_by_repr(ps, name) != NULL)
+        {
+            yaep_error(ps, YAEP_REPEATED_TERM_DECL,
+                        "repeated declaration of term `%s'", name);
+        }
+        symb_add_class_terminal(ps, name, TERM_CLASS_CODE, intervals, num_intervals);
+    }
+
     /* Adding error symbol.*/
     if (symb_find_by_repr(ps, TERM_ERROR_NAME) != NULL)
     {
@@ -1737,12 +1871,12 @@ int yaep_set_recovery_match(YaepGrammar *grammar, int n_input)
     return old;
 }
 
-static void yaep_parse_init(YaepParseState *ps, int n_input)
+static void yaep_parse_init(YaepParseState *ps)
 {
     YaepRule*rule;
 
     init_dotted_rules(ps);
-    set_init(ps, n_input);
+    set_init(ps);
     core_symb_to_predcomps_init(ps);
 #ifdef USE_CORE_SYMB_HASH_TABLE
     {
@@ -1768,6 +1902,62 @@ static void free_inside_parse_state(YaepParseState *ps)
     free_dotted_rules(ps);
 }
 
+/* Free the input, the state sets and the tables kept for the next parse.*/
+static void free_parse_memory(YaepParseState *ps)
+{
+    if (!ps->parse_memory_p) return;
+
+    free_state_sets(ps);
+    free_inside_parse_state(ps);
+    free_input(ps);
+    ps->parse_memory_p = false;
+}
+
+/* Add the counters of the hash tables kept for the next parse to the statistics.*/
+static void count_parse_tables(YaepParseState *ps)
+{
+    count_parse_hash_table(ps, ps->cache_stateset_cores);
+    count_parse_hash_table(ps, ps->cache_stateset_matched_lengths);
+    count_parse_hash_table(ps, ps->cache_stateset_core_matched_lengths);
+    count_parse_hash_table(ps, ps->cache_stateset_term_lookahead);
+    count_parse_hash_table(ps, ps->map_leo_items);
+#ifdef USE_CORE_SYMB_HASH_TABLE
+    count_parse_hash_table(ps, ps->map_core_symb_to_predcomps);
+#endif
+    count_parse_hash_table(ps, ps->map_transition_to_coresymbvect);
+    count_parse_hash_table(ps, ps->map_reduce_to_coresymbvect);
+}
+
+/* Prepare tree_nodes_os for the nodes of a new parse tree, the nodes of
+   the previous tree are released. Not used when the caller allocates the nodes.*/
+static void reset_tree_nodes(YaepParseState *ps)
+{
+    if (ps->run.parse_alloc != NULL) return;
+
+    if (ps->tree_nodes_p && objstack_memusage(&ps->tree_nodes_os) > MAX_RETAINED_PARSE_MEMORY)
+    {
+        free_tree_nodes(ps);
+    }
+    if (ps->tree_nodes_p)
+    {
+        OS_RESET(ps->tree_nodes_os);
+    }
+    else
+    {
+        OS_CREATE(ps->tree_nodes_os, ps->run.grammar->alloc, 0);
+        ps->tree_nodes_p = true;
+    }
+}
+
+static void free_tree_nodes(YaepParseState *ps)
+{
+    if (!ps->tree_nodes_p) return;
+
+    OS_DELETE(ps->tree_nodes_os);
+    ps->tree_nodes_p = false;
+    ps->run.root = NULL;
+}
+
 static size_t memusage(YaepParseState *ps)
 {
     size_t sum = 0;
@@ -1821,6 +2011,8 @@ static size_t memusage(YaepParseState *ps)
     sum += hash_table_memusage(ps->map_transition_to_coresymbvect);
     sum += hash_table_memusage(ps->map_reduce_to_coresymbvect);
     sum += objstack_memusage(&ps->recovery_state_tail_sets);
+    sum += vlo_memusage(&ps->input_vlo);
+    sum += vlo_memusage(&ps->state_sets_vlo);
     sum += vlo_memusage(&ps->original_state_set_tail_stack);
     sum += vlo_memusage(&ps->vlo_array);
     sum += hash_table_memusage(ps->set_of_reserved_memory);
@@ -1829,23 +2021,40 @@ static size_t memusage(YaepParseState *ps)
     sum += objstack_memusage(&ps->node_visits_os);
     sum += vlo_memusage(&ps->recovery_state_stack);
     sum += objstack_memusage(&ps->parse_state_os);
+    if (ps->tree_nodes_p) sum += objstack_memusage(&ps->tree_nodes_os);
     sum += hash_table_memusage(ps->map_rule_orig_statesetind_to_internalstate);
 
     return sum;
 }
 
-/* The following function reads all input tokens.*/
-static void read_input(YaepParseState *ps)
+/* Return true if there is an input token at index I. The tokens are read
+   from read_token when needed, the end marker is added after the last token.*/
+static bool input_has_token(YaepParseState *ps, int i)
 {
-    int code;
-    void *attr;
-
-    while((code = ps->run.read_token((YaepParseRun*)ps, &attr)) >= 0)
+    while (i >= ps->input_len && !ps->input_done_p)
     {
-        tok_add(ps, code, attr);
+        void *attr;
+        int code = ps->run.read_token((YaepParseRun*)ps, &attr);
+        if (code >= 0)
+        {
+            tok_add(ps, code, attr);
+        }
+        else
+        {
+            tok_add(ps, END_MARKER_CODE, NULL);
+            ps->input_done_p = true;
+        }
     }
+    return i < ps->input_len;
+}
 
-    tok_add(ps, END_MARKER_CODE, NULL);
+/* The following function reads all remaining input tokens.*/
+static void read_all_input(YaepParseState *ps)
+{
+    while (!ps->input_done_p)
+    {
+        input_has_token(ps, ps->input_len);
+    }
 }
 
 /* Add predicted (derived) not yet started dotted_rules which is formed from
@@ -1952,7 +2161,7 @@ static bool has_lookahead(YaepParseState *ps, YaepSymbol *symb, int n)
     int p = ps->tok_i+n;
 
     // End of buffer immediately returns no lookahead match.
-    if (p >= ps->input_len) return false;
+    if (!input_has_token(ps, p)) return false;
     // The last token is $eof returs no lookahead match.
     if (!strcmp(ps->input[p].symb->hr, "$eof")) return false;
 
@@ -1962,7 +2171,7 @@ static bool has_lookahead(YaepParseState *ps, YaepSymbol *symb, int n)
         // Start scanning utf8 characters after the S: |!S...
         const char *u = symb->repr+3;
         const char *stop = symb->repr+strlen(symb->repr);
-        for (int i = p; i < ps->input_len && u < stop; ++i)
+        for (int i = p; input_has_token(ps, i) && u < stop; ++i)
         {
             YaepSymbol *next = ps->input[i].symb;
             if (!strcmp(next->hr, "$eof")) return false;
@@ -2203,6 +2412,8 @@ static void build_start_set(YaepParseState *ps)
         terminal_bitset_t *empty_dyn_lookahead_context_set = terminal_bitset_create(ps);
         terminal_bitset_clear(ps, empty_dyn_lookahead_context_set);
         dyn_lookahead_context = terminal_bitset_insert(ps, empty_dyn_lookahead_context_set);
+        // The empty set is already in the table when the grammar is reused from a previous parse.
+        if (dyn_lookahead_context < 0) dyn_lookahead_context = -dyn_lookahead_context - 1;
 
         /* Empty dyn_lookahead_context in the table has always number zero. */
         assert(dyn_lookahead_context == 0);
@@ -2218,7 +2429,7 @@ static void build_start_set(YaepParseState *ps)
     assert(core_added);
 
     expand_new_set(ps);
-    ps->state_sets[0] = ps->new_set;
+    state_sets_put(ps, 0, ps->new_set);
 }
 
 static int lookup_matched_length(YaepParseState *ps, YaepStateSet *set, int rule_index_in_core)
@@ -2245,6 +2456,219 @@ static void trace_lookahead_predicts_no_match(YaepParseState *ps, int lookahead_
     membuffer_append(mb, "\n");
 }
 
+/* Leo's optimization of right recursion.
+
+   A right recursive rule, e.g. list = item, list?. completes a chain of
+   rules at every position: list from 0, list from 1, list from 2 etc.
+   Each state set would then contain all of the chain, which makes the
+   parse quadratic in the input length. When the completion of a symbol
+   is deterministic (see YaepLeoItem) we follow the chain to its top,
+   remember the chain and only add the top to the state set.
+   The tree builder later expands the chain when it needs the completions. */
+
+static unsigned leo_item_hash(hash_table_entry_t i)
+{
+    YaepLeoItem *item = (YaepLeoItem*)i;
+
+    return (jauquet_prime_mod32 * hash_shift + (unsigned)item->state_set_k) * hash_shift + (unsigned)item->symb->id;
+}
+
+static bool leo_item_eq(hash_table_entry_t i1, hash_table_entry_t i2)
+{
+    YaepLeoItem *item1 = (YaepLeoItem*)i1;
+    YaepLeoItem *item2 = (YaepLeoItem*)i2;
+
+    return item1->state_set_k == item2->state_set_k && item1->symb == item2->symb;
+}
+
+static void leo_init(YaepParseState *ps)
+{
+    ps->leo_p = !ps->run.grammar->error_recovery_p;
+    if (ps->parse_memory_p)
+    {
+        OS_RESET(ps->leo_items_os);
+        empty_hash_table(ps->map_leo_items);
+        VLO_NULLIFY(ps->leo_walk_vlo);
+        VLO_NULLIFY(ps->leo_steps_vlo);
+    }
+    else
+    {
+        OS_CREATE(ps->leo_items_os, ps->run.grammar->alloc, 0);
+        ps->map_leo_items = create_hash_table(ps->run.grammar->alloc, 2000,
+                                              (hash_table_hash_function)leo_item_hash,
+                                              (hash_table_eq_function)leo_item_eq);
+        VLO_CREATE(ps->leo_walk_vlo, ps->run.grammar->alloc, 0);
+        VLO_CREATE(ps->leo_steps_vlo, ps->run.grammar->alloc, 0);
+    }
+    ps->num_leo_items = ps->num_leo_steps = 0;
+}
+
+static void free_leo(YaepParseState *ps)
+{
+    VLO_DELETE(ps->leo_steps_vlo);
+    VLO_DELETE(ps->leo_walk_vlo);
+    delete_parse_hash_table(ps, ps->map_leo_items);
+    OS_DELETE(ps->leo_items_os);
+}
+
+/* Find or create the Leo item for (STATE_SET_K, SYMB). Set NEW_P if it was created. */
+static YaepLeoItem *leo_item_insert(YaepParseState *ps, int state_set_k, YaepSymbol *symb, bool *new_p)
+{
+    OS_TOP_EXPAND(ps->leo_items_os, sizeof(YaepLeoItem));
+    YaepLeoItem *item = (YaepLeoItem*)OS_TOP_BEGIN(ps->leo_items_os);
+    item->state_set_k = state_set_k;
+    item->symb = symb;
+
+    YaepLeoItem **entry = (YaepLeoItem**)find_hash_table_entry(ps->map_leo_items, item, true);
+    if (*entry != NULL)
+    {
+        OS_TOP_NULLIFY(ps->leo_items_os);
+        *new_p = false;
+        return *entry;
+    }
+    OS_TOP_FINISH(ps->leo_items_os);
+    *entry = item;
+    item->dotted_rule = NULL;
+    item->from_i = 0;
+    item->next = NULL;
+    item->top_dotted_rule = NULL;
+    item->top_from_i = 0;
+    item->chain_length = 0;
+    item->walking_p = false;
+    ps->num_leo_items++;
+    *new_p = true;
+    return item;
+}
+
+/* If the completion of SYMB from STATE_SET_K is deterministic, then return the
+   dotted rule waiting for SYMB and its index in the core of the state set. */
+static YaepDottedRule *leo_waiting_dotted_rule(YaepParseState *ps, int state_set_k, YaepSymbol *symb, int *rule_index_in_core)
+{
+    if (symb->is_not_operator) return NULL;
+
+    YaepStateSet *set = ps->state_sets[state_set_k];
+    YaepCoreSymbToPredComps *core_symb_to_predcomps = core_symb_to_predcomps_find(ps, set->core, symb);
+    if (core_symb_to_predcomps == NULL || core_symb_to_predcomps->predictions.len != 1) return NULL;
+
+    *rule_index_in_core = core_symb_to_predcomps->predictions.ids[0];
+    YaepDottedRule *dotted_rule = set->core->dotted_rules[*rule_index_in_core];
+    if (dotted_rule->dot_j + 1 != dotted_rule->rule->rhs_len) return NULL;
+
+    return dotted_rule;
+}
+
+/* Return the Leo item for completing SYMB from STATE_SET_K or NULL if the
+   completion is not deterministic or the chain is shorter than LEO_MIN_CHAIN_LENGTH.
+   Short chains are not remembered. A long chain is followed upwards until a
+   known Leo item or a non-deterministic completion is found, then the tops
+   are filled in from the end of the chain. */
+static YaepLeoItem *leo_item_find(YaepParseState *ps, int state_set_k, YaepSymbol *symb)
+{
+    YaepLeoItem key;
+    key.state_set_k = state_set_k;
+    key.symb = symb;
+    YaepLeoItem **entry = (YaepLeoItem**)find_hash_table_entry(ps->map_leo_items, &key, false);
+    if (*entry != NULL)
+    {
+        return (*entry)->dotted_rule != NULL ? *entry : NULL;
+    }
+
+    int rule_index_in_core;
+    int k = state_set_k;
+    YaepSymbol *s = symb;
+    for (int n = 0; n < LEO_MIN_CHAIN_LENGTH; n++)
+    {
+        YaepDottedRule *dotted_rule = leo_waiting_dotted_rule(ps, k, s, &rule_index_in_core);
+        if (dotted_rule == NULL) return NULL;
+        k -= lookup_matched_length(ps, ps->state_sets[k], rule_index_in_core);
+        s = dotted_rule->rule->lhs;
+    }
+
+    YaepLeoItem *item;
+    bool new_p;
+
+    VLO_NULLIFY(ps->leo_walk_vlo);
+    for (;;)
+    {
+        item = leo_item_insert(ps, state_set_k, symb, &new_p);
+        if (!new_p) break;
+
+        YaepDottedRule *dotted_rule = leo_waiting_dotted_rule(ps, state_set_k, symb, &rule_index_in_core);
+        if (dotted_rule == NULL) break;
+
+        item->dotted_rule = create_dotted_rule(ps, dotted_rule->rule, dotted_rule->dot_j + 1,
+                                               dotted_rule->dyn_lookahead_context);
+        item->from_i = state_set_k - lookup_matched_length(ps, ps->state_sets[state_set_k], rule_index_in_core);
+        item->walking_p = true;
+        VLO_ADD_MEMORY(ps->leo_walk_vlo, &item, sizeof(YaepLeoItem*));
+
+        state_set_k = item->from_i;
+        symb = dotted_rule->rule->lhs;
+    }
+
+    YaepLeoItem **walk = (YaepLeoItem**)VLO_BEGIN(ps->leo_walk_vlo);
+    int num_walk = VLO_LENGTH(ps->leo_walk_vlo) / sizeof(YaepLeoItem*);
+
+    if (item->walking_p)
+    {
+        // The chain loops back into itself, this can only happen with a cyclic grammar.
+        // Treat the whole chain as non-deterministic.
+        for (int i = 0; i < num_walk; i++)
+        {
+            walk[i]->dotted_rule = NULL;
+            walk[i]->walking_p = false;
+        }
+        return NULL;
+    }
+
+    YaepLeoItem *next = item->dotted_rule != NULL ? item : NULL;
+    for (int i = num_walk - 1; i >= 0; i--)
+    {
+        YaepLeoItem *w = walk[i];
+        w->walking_p = false;
+        w->next = next;
+        if (next != NULL)
+        {
+            w->top_dotted_rule = next->top_dotted_rule;
+            w->top_from_i = next->top_from_i;
+            w->chain_length = next->chain_length + 1;
+        }
+        else
+        {
+            w->top_dotted_rule = w->dotted_rule;
+            w->top_from_i = w->from_i;
+            w->chain_length = 1;
+        }
+        next = w;
+    }
+
+    return next;
+}
+
+/* Add the top of the chain of ITEM to the set being formed and remember
+   the step for the tree builder. */
+static void leo_add_top(YaepParseState *ps, YaepLeoItem *item)
+{
+    int state_set_k = ps->state_set_k + 1;
+    int matched_length = state_set_k - item->top_from_i;
+
+    if (!dotted_rule_matched_length_test_and_set(ps, item->top_dotted_rule, matched_length))
+    {
+        set_add_dotted_rule_with_matched_length(ps, item->top_dotted_rule, matched_length, "leo");
+    }
+
+    int num_steps = VLO_LENGTH(ps->leo_steps_vlo) / sizeof(YaepLeoStep);
+    YaepLeoStep *last = num_steps > 0 ? (YaepLeoStep*)VLO_BOUND(ps->leo_steps_vlo) - 1 : NULL;
+    if (last != NULL && last->state_set_k == state_set_k && last->bottom == item) return;
+
+    YaepLeoStep step;
+    step.state_set_k = state_set_k;
+    step.bottom = item;
+    step.expanded_p = false;
+    VLO_ADD_MEMORY(ps->leo_steps_vlo, &step, sizeof(YaepLeoStep));
+    ps->num_leo_steps++;
+}
+
 void try_eat_token(const char *why, YaepParseState *ps, YaepStateSet *set,
                    YaepDottedRule *dotted_rule, int rule_index_in_core,
                    int lookahead_term_id, int local_lookahead_level,
@@ -2316,6 +2740,17 @@ void check_leading_dotted_rules(YaepParseState *ps, YaepStateSet *set, int looka
                make reduce and add new dotted_rules. */
             int new_matched_length = ps->new_matched_lengths[i];
             int place = ps->state_set_k + 1 - new_matched_length;
+            if (ps->leo_p)
+            {
+                // Short chains are completed as usual. They are cheap and the state set
+                // can then be reused by the goto cache.
+                YaepLeoItem *item = leo_item_find(ps, place, new_dotted_rule->rule->lhs);
+                if (item != NULL && item->chain_length >= LEO_MIN_CHAIN_LENGTH)
+                {
+                    leo_add_top(ps, item);
+                    continue;
+                }
+            }
             YaepStateSet *prev_set = ps->state_sets[place];
             YaepCoreSymbToPredComps *prev_core_symb_to_predcomps = core_symb_to_predcomps_find(ps, prev_set->core, new_dotted_rule->rule->lhs);
             if (prev_core_symb_to_predcomps == NULL)
@@ -2538,7 +2973,7 @@ static void set_recovery_state(YaepParseState *ps, YaepRecoveryState*state)
 
     for(i = 0; i < state->state_set_tail_length; i++)
     {
-        ps->state_sets[++ps->state_set_k] = state->state_set_tail[i];
+        state_sets_put(ps, ++ps->state_set_k, state->state_set_tail[i]);
 
         if (ps->run.debug)
         {
@@ -2642,6 +3077,7 @@ static YaepStateSetTermLookAhead *lookup_cached_set_term_lookahead(YaepParseStat
     memset(new_set_term_lookahead->result, 0, MAX_CACHED_GOTO_RESULTS*sizeof(new_set_term_lookahead->result[0]));
 
     new_set_term_lookahead->curr = 0;
+    ps->n_goto_lookups++;
     // We write into the hashtable using the entry point! Yay!
     // I.e. there is no write hash table entry function.....
     YaepStateSetTermLookAhead **stlg = (YaepStateSetTermLookAhead**)find_hash_table_entry(ps->cache_stateset_term_lookahead, new_set_term_lookahead, true);
@@ -2737,7 +3173,7 @@ static void perform_parse(YaepParseState *ps)
     ps->tok_i = 0;
     ps->state_set_k = 0;
 
-    for(; ps->tok_i < ps->input_len; ps->tok_i++)
+    for(; input_has_token(ps, ps->tok_i); ps->tok_i++)
     {
         // This assert is TODO! Theoretically the state_set_k could be less than tok_i
         // assuming a state set has been reused.
@@ -2747,7 +3183,7 @@ static void perform_parse(YaepParseState *ps)
         YaepSymbol *THE_TERMINAL = ps->input[ps->tok_i].symb;
         YaepSymbol *NEXT_TERMINAL = NULL;
 
-        if (ps->run.grammar->lookahead_level != 0 && ps->tok_i < ps->input_len-1)
+        if (ps->run.grammar->lookahead_level != 0 && input_has_token(ps, ps->tok_i + 1))
         {
             NEXT_TERMINAL = ps->input[ps->tok_i + 1].symb;
         }
@@ -2779,7 +3215,7 @@ static void perform_parse(YaepParseState *ps)
 
         if (ps->new_set == NULL)
         {
-            YaepCoreSymbToPredComps *core_symb_to_predcomps = core_symb_to_predcomps_find(ps, set->core, THE_TERMINAL);
+            YaepCoreSymbToPredComps *core_symb_to_predcomps = core_term_to_predcomps_find(ps, set->core, THE_TERMINAL);
 
             if (core_symb_to_predcomps == NULL)
             {
@@ -2805,16 +3241,23 @@ static void perform_parse(YaepParseState *ps)
                 free_membuffer_and_free_content(mb);
                 }*/
 
+            int num_leo_steps = ps->num_leo_steps;
+
             // Do the actual predict/complete cycle.
             complete_and_predict_new_state_set(ps, set, core_symb_to_predcomps, THE_TERMINAL, NEXT_TERMINAL);
 
 #ifdef USE_SET_HASH_TABLE
-            save_cached_set(ps, entry, NEXT_TERMINAL);
+            // A set built using Leo items depends on the chains at this position,
+            // the tree builder also needs the Leo steps for this position. Do not reuse it.
+            if (ps->num_leo_steps == num_leo_steps)
+            {
+                save_cached_set(ps, entry, NEXT_TERMINAL);
+            }
 #endif
         }
 
         ps->state_set_k++;
-        ps->state_sets[ps->state_set_k] = ps->new_set;
+        state_sets_put(ps, ps->state_set_k, ps->new_set);
 
         if (ps->run.trace)
         {
@@ -2831,28 +3274,65 @@ static void perform_parse(YaepParseState *ps)
 
 
 
-static void *parse_alloc_default(int nmemb)
+static void parse_free_default(void *mem)
 {
-    void *result;
-
-    assert(nmemb > 0);
-
-    result = calloc(1, nmemb);
-    if (result == NULL)
-    {
-        exit(1);
-    }
+    free(mem);
+}
 
-    return result;
+static double now_seconds()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1000000000.0;
 }
 
-static void parse_free_default(void *mem)
+/* Store the statistics of the parse in the parse run, where the caller can read them.
+   All counters are inside the parse state, parses in different runs do not disturb each other. */
+static void fill_parse_stats(YaepParseState *ps, size_t mem, double parse_seconds, double tree_seconds)
 {
-    free(mem);
+    YaepParseStats *stats = &ps->run.stats;
+
+    stats->input_len = ps->input_len;
+    stats->num_state_sets = ps->num_sets_total;
+    stats->num_set_cores = ps->num_set_cores;
+    stats->num_dotted_rules = ps->num_dotted_rules_total;
+    stats->num_unique_dotted_rules = ps->num_all_dotted_rules;
+    stats->num_set_lookups = ps->n_set_lookups;
+    stats->num_set_hits = ps->n_set_successes;
+    stats->num_goto_lookups = ps->n_goto_lookups;
+    stats->num_goto_hits = ps->n_goto_successes;
+    stats->num_leo_steps = ps->num_leo_steps;
+    stats->table_searches = ps->table_searches;
+    stats->table_collisions = ps->table_collisions;
+    stats->memusage = mem;
+    stats->num_term_nodes = ps->n_parse_term_nodes;
+    stats->num_abstract_nodes = ps->n_parse_abstract_nodes;
+    stats->num_alt_nodes = ps->n_parse_alt_nodes;
+    stats->parse_seconds = parse_seconds;
+    stats->tree_seconds = tree_seconds;
 }
 
-static void print_statistics(YaepParseState *ps, bool *ambiguous_p, int table_searches, int table_collisions)
+static void print_statistics(YaepParseState *ps, bool *ambiguous_p)
 {
+    YaepParseStats *stats = &ps->run.stats;
+
+    if (xmq_verbose_enabled_)
+    {
+        char *siz = humanReadableTwoDecimals(stats->memusage);
+        verbose("ixml=", "parsed %d tokens in %.3fs, tree in %.3fs #sets=%d set_hits=%d/%d goto_hits=%d/%d leo_steps=%d mem=%s",
+                stats->input_len,
+                stats->parse_seconds,
+                stats->tree_seconds,
+                stats->num_state_sets,
+                stats->num_set_hits,
+                stats->num_set_lookups,
+                stats->num_goto_hits,
+                stats->num_goto_lookups,
+                stats->num_leo_steps,
+                siz);
+        free(siz);
+    }
+
     if (ps->run.debug)
     {
         yaep_debug(ps, "print_statistics()");
@@ -2899,10 +3379,11 @@ static void print_statistics(YaepParseState *ps, bool *ambiguous_p, int table_se
                  ps->n_parse_alt_nodes,
                  ps->n_parse_term_nodes + ps->n_parse_abstract_nodes
                  + ps->n_parse_alt_nodes);
+        size_t table_searches = stats->table_searches;
         if (table_searches == 0) table_searches++;
-        yaep_trace(ps, "#table collisions = %.2g%%(%d out of %d)",
-                 table_collisions* 100.0 / table_searches,
-                 table_collisions, table_searches);
+        yaep_trace(ps, "#table collisions = %.2g%%(%zu out of %zu)",
+                 stats->table_collisions* 100.0 / table_searches,
+                 stats->table_collisions, stats->table_searches);
     }
 }
 /* The following function parses input according read grammar.
@@ -2924,6 +3405,12 @@ int yaepParse(YaepParseRun *pr, YaepGrammar *g)
     assert(CAN_PARSE_STATE_MAGIC(ps));
     PARSE_START_MAGIC(ps);
 
+    if (ps->run.grammar != g)
+    {
+        // The kept memory was allocated by the previous grammar.
+        free_parse_memory(ps);
+        free_tree_nodes(ps);
+    }
     ps->run.grammar = g;
     YaepTreeNode **root = &ps->run.root;
     bool *ambiguous_p = &ps->run.ambiguous_p;
@@ -2931,29 +3418,28 @@ int yaepParse(YaepParseRun *pr, YaepGrammar *g)
     int code;
     bool tok_init_p, parse_init_p;
 
-    /* Set up parse allocation*/
-    if (ps->run.parse_alloc == NULL)
+    /* Set up parse allocation. Without parse_alloc the tree nodes are
+       placed in tree_nodes_os and freed together with yaepFreeParseTree.*/
+    if (ps->run.parse_alloc == NULL && ps->run.parse_free != NULL)
     {
-        if (ps->run.parse_free != NULL)
-        {
-            /* Cannot allocate memory with a null function*/
-            return YAEP_NO_MEMORY;
-        }
-        /* Set up defaults*/
-        ps->run.parse_alloc = parse_alloc_default;
-        ps->run.parse_free = parse_free_default;
+        /* Cannot allocate memory with a null function*/
+        return YAEP_NO_MEMORY;
     }
 
     assert(ps->run.grammar != NULL);
     *root = NULL;
     *ambiguous_p = false;
-    pl_init(ps);
     tok_init_p = parse_init_p = false;
 
     if (!ps->run.read_token) ps->run.read_token = default_read_token;
 
     if ((code = setjmp(ps->error_longjump_buff)) != 0)
     {
+        if (ps->parse_memory_p)
+        {
+            free_parse_memory(ps);
+            return code;
+        }
         free_state_sets(ps);
         if (parse_init_p)
         {
@@ -2969,31 +3455,55 @@ int yaepParse(YaepParseRun *pr, YaepGrammar *g)
     {
         yaep_error(ps, YAEP_UNDEFINED_OR_BAD_GRAMMAR, "undefined or bad grammar");
     }
-    ps->n_goto_successes = 0;
+    ps->table_searches = ps->table_collisions = 0;
+    reset_tree_nodes(ps);
     create_input(ps);
     tok_init_p = true;
-    read_input(ps);
-    yaep_parse_init(ps, ps->input_len);
+    yaep_parse_init(ps);
     parse_init_p = true;
     allocate_state_sets(ps);
-
-    int table_collisions_init = get_all_collisions();
-    int table_searches_init = get_all_searches();
+    ps->parse_memory_p = true;
 
     // Perform a parse.
+    double start = now_seconds();
     perform_parse(ps);
+    double parsed = now_seconds();
 
     // Reconstruct a parse tree from the state sets.
     *root = build_parse_tree(ps, ambiguous_p);
+    double built = now_seconds();
+    double parse_seconds = parsed - start;
+    double tree_seconds = built - parsed;
 
-    int table_collisions = get_all_collisions() - table_collisions_init;
-    int table_searches = get_all_searches() - table_searches_init;
+    if (*ambiguous_p && ps->num_leo_steps > 0)
+    {
+        // Which of the ambiguous parses is picked depends on the order of the
+        // completions in the state sets. The order is different when Leo chains
+        // are used, so parse again without them to pick the same parse as always.
+        verbose("ixml=", "ambiguous parse using Leo chains, parse again");
+        yaepFreeParseTree(pr);
+        yaep_parse_init(ps);
+        allocate_state_sets(ps);
+        ps->leo_p = false;
+        perform_parse(ps);
+        parsed = now_seconds();
+        *ambiguous_p = false;
+        *root = build_parse_tree(ps, ambiguous_p);
+        parse_seconds += parsed - built;
+        built = now_seconds();
+        tree_seconds += built - parsed;
+    }
 
-    print_statistics(ps, ambiguous_p, table_searches, table_collisions);
+    size_t mem = memusage(ps);
 
-    free_state_sets(ps);
-    free_inside_parse_state(ps);
-    free_input(ps);
+    count_parse_tables(ps);
+    if (mem > MAX_RETAINED_PARSE_MEMORY)
+    {
+        free_parse_memory(ps);
+    }
+
+    fill_parse_stats(ps, mem, parse_seconds, tree_seconds);
+    print_statistics(ps, ambiguous_p);
     verbose("ixml=", "done parse");
 
     PARSE_STOP_MAGIC(ps);
@@ -3011,7 +3521,8 @@ void yaepFreeGrammar(YaepParseRun *pr, YaepGrammar *g)
     if (g != NULL)
     {
         allocator = g->alloc;
-        free_state_sets(ps);
+        free_parse_memory(ps);
+        free_tree_nodes(ps);
         rulestorage_free(g, g->rulestorage_ptr);
         termsetstorage_free(g, g->term_sets_ptr);
         symbolstorage_free(ps, g->symbs_ptr);
@@ -3156,6 +3667,21 @@ static void free_tree_sweep(YaepTreeNode *node,
     parse_free(node);
 }
 
+void yaepFreeParseTree(YaepParseRun *pr)
+{
+    YaepParseState *ps = (YaepParseState*)pr;
+
+    if (ps->run.parse_alloc == NULL)
+    {
+        if (ps->tree_nodes_p) OS_RESET(ps->tree_nodes_os);
+    }
+    else if (ps->run.root != NULL && ps->run.parse_free != NULL)
+    {
+        yaepFreeTree(ps->run.root, ps->run.parse_free, NULL);
+    }
+    ps->run.root = NULL;
+}
+
 void yaepFreeTree(YaepTreeNode *root, void (*parse_free)(void*), void (*termcb)(YaepTerminalNode*))
 {
     if (root == NULL)
@@ -3222,6 +3748,8 @@ static void error_recovery(YaepParseState *ps, int *start, int *stop)
     back_to_frontier_move_cost = backward_move_cost;
     save_original_sets(ps);
     push_recovery_state(ps, ps->back_state_set_frontier, backward_move_cost);
+    // The recovery cost is bounded by the input length, read the rest of the input.
+    read_all_input(ps);
     best_cost = 2* ps->input_len;
     while(VLO_LENGTH(ps->recovery_state_stack) > 0)
     {
@@ -3292,7 +3820,7 @@ static void error_recovery(YaepParseState *ps, int *start, int *stop)
             fprintf(stderr, "++++Making error shift in set=%d\n", ps->state_set_k);
 
         complete_and_predict_new_state_set(ps, set, core_symb_to_predcomps, NULL, NULL);
-        ps->state_sets[++ps->state_set_k] = ps->new_set;
+        state_sets_put(ps, ++ps->state_set_k, ps->new_set);
 
         if (ps->run.debug)
         {
@@ -3304,7 +3832,7 @@ static void error_recovery(YaepParseState *ps, int *start, int *stop)
         /* Search the first right token.*/
         while(ps->tok_i < ps->input_len)
         {
-            core_symb_to_predcomps = core_symb_to_predcomps_find(ps, ps->new_core, ps->input[ps->tok_i].symb);
+            core_symb_to_predcomps = core_term_to_predcomps_find(ps, ps->new_core, ps->input[ps->tok_i].symb);
             if (core_symb_to_predcomps != NULL)
                 break;
 
@@ -3357,7 +3885,7 @@ static void error_recovery(YaepParseState *ps, int *start, int *stop)
             NEXT_TERMINAL = ps->input[ps->tok_i + 1].symb;
         }
         complete_and_predict_new_state_set(ps, ps->new_set, core_symb_to_predcomps, NULL, NEXT_TERMINAL);
-        ps->state_sets[++ps->state_set_k] = ps->new_set;
+        state_sets_put(ps, ++ps->state_set_k, ps->new_set);
 
         if (ps->run.debug)
         {
@@ -3402,7 +3930,7 @@ static void error_recovery(YaepParseState *ps, int *start, int *stop)
 
                 push_recovery_state(ps, state.last_original_state_set_el, cost);
             }
-            core_symb_to_predcomps = core_symb_to_predcomps_find(ps, ps->new_core, ps->input[ps->tok_i].symb);
+            core_symb_to_predcomps = core_term_to_predcomps_find(ps, ps->new_core, ps->input[ps->tok_i].symb);
             if (core_symb_to_predcomps == NULL)
             {
                 break;
@@ -3413,7 +3941,7 @@ static void error_recovery(YaepParseState *ps, int *start, int *stop)
                 NEXT_TERMINAL = ps->input[ps->tok_i + 1].symb;
             }
             complete_and_predict_new_state_set(ps, ps->new_set, core_symb_to_predcomps, NULL, NEXT_TERMINAL);
-            ps->state_sets[++ps->state_set_k] = ps->new_set;
+            state_sets_put(ps, ++ps->state_set_k, ps->new_set);
         }
         if (num_matched_input >= ps->run.grammar->recovery_token_matches || ps->tok_i >= ps->input_len)
         {
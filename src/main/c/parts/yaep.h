@@ -49,6 +49,9 @@ typedef struct YaepGrammar YaepGrammar;
 struct YaepParseRun;
 typedef struct YaepParseRun YaepParseRun;
 
+struct YaepParseStats;
+typedef struct YaepParseStats YaepParseStats;
+
 struct YaepAltNode;
 typedef struct YaepAltNode YaepAltNode;
 
@@ -90,6 +93,41 @@ typedef struct YaepTreeNode YaepTreeNode;
 #define YAEP_LOOP_NONTERM                  16
 #define YAEP_INVALID_TOKEN_CODE            17
 
+/* The following structure describes the work done by the last parse of a
+   parse run. It is filled in by yaepParse and can be read after the parse. */
+struct YaepParseStats
+{
+    // Number of tokens parsed.
+    int input_len;
+    // Number of unique state sets and state set cores built.
+    int num_state_sets;
+    int num_set_cores;
+    // Number of dotted rules in all unique state sets.
+    int num_dotted_rules;
+    // Number of unique dotted rules.
+    int num_unique_dotted_rules;
+    // Number of state sets looked up in the set cache and how many were found.
+    int num_set_lookups;
+    int num_set_hits;
+    // Number of goto lookups (set, terminal, lookahead) and how many found a cached set.
+    int num_goto_lookups;
+    int num_goto_hits;
+    // Number of completions taken through Leo chains.
+    int num_leo_steps;
+    // Number of searches and collisions in the hash tables of the parse.
+    size_t table_searches;
+    size_t table_collisions;
+    // Memory used by the grammar and the parse state at the end of the parse.
+    size_t memusage;
+    // Number of terminal, abstract and alternative nodes in the parse tree.
+    int num_term_nodes;
+    int num_abstract_nodes;
+    int num_alt_nodes;
+    // Wall clock seconds spent parsing the input and building the parse tree.
+    double parse_seconds;
+    double tree_seconds;
+};
+
 struct YaepParseRun
 {
     void *user_data; // Points to user supplied data, useful inside the callbacked read_token and syntax_error.
@@ -106,9 +144,9 @@ struct YaepParseRun
                          void *start_ignored_tok_attr,
                          int start_recovered_tok_num,
                          void *start_recovered_tok_attr);
-    // If parse_alloc is NULL then use the built in allocator (malloc).
+    // If parse_alloc and parse_free are NULL then the tree nodes are allocated
+    // by the parse run and freed all at once with yaepFreeParseTree.
     void *(*parse_alloc)(int nmemb);
-    // If parse_free is NULL then use the built in free (free).
     void (*parse_free)(void *mem);
     // The resulting DOM tree is stored here.
     YaepTreeNode *root;
@@ -118,6 +156,8 @@ struct YaepParseRun
     bool ambiguous_p;
     // Set to true if the parse faild.
     bool failed_p;
+    // Statistics of the last parse.
+    YaepParseStats stats;
 
     // We are parsing with this grammar.
     YaepGrammar *grammar;
@@ -262,8 +302,16 @@ extern const char *yaep_error_message(YaepGrammar *g);
    read the function returns NULL.  The return code should be
    nonnegative.
 
+   READ_CLASS is an optional function (can be NULL) for reading class
+   terminals.  It is called after read_terminal.  The function should
+   return the name of the next class terminal and its interval table,
+   an array of NUM_INTERVALS sorted and non overlapping inclusive
+   from,to pairs of codes.  A class terminal matches any input terminal
+   whose code is within the table.  If all class terminals have been
+   read the function returns NULL.
+
    READ_RULE is function called to read the next rule.  This function
-   is called after function read_terminal.  The function should return
+   is called after functions read_terminal and read_class.  The function should return
    the name of LHS rule and array of names of symbols in RHS of the
    rule (the array end marker should be NULL).  If all rules have been
    read the function returns NULL.  All symbol with name which was not
@@ -289,6 +337,10 @@ extern int yaep_read_grammar(YaepParseRun *ps,
                              const char *(*read_terminal) (YaepParseRun *pr,
                                                            YaepGrammar *g,
                                                            int *code),
+                             const char *(*read_class) (YaepParseRun *pr,
+                                                        YaepGrammar *g,
+                                                        const int **intervals,
+                                                        int *num_intervals),
                              const char *(*read_rule) (YaepParseRun *pr,
                                                        YaepGrammar *g,
                                                        const char ***rhs,
@@ -357,7 +409,8 @@ extern int yaep_set_recovery_match(YaepGrammar *grammar, int n_toks);
    convenient to free all memory but parse tree.  Therefore we require
    the following function. If PARSE_ALLOC is a null pointer, then
    PARSE_FREE must also be a null pointer. In this case, YAEP will
-   handle the memory management. Otherwise, the caller will be responsible to
+   handle the memory management and the tree is freed with
+   yaepFreeParseTree. Otherwise, the caller will be responsible to
    allocate and free memory for parse tree representation.  But the
    caller should not free the memory until yaep_fin is called.  The
    function may be called even during reading the grammar not only
@@ -367,13 +420,23 @@ extern int yaep_set_recovery_match(YaepGrammar *grammar, int n_toks);
    returned parse tree should also not be freed with yaep_free_tree(). */
 extern int yaepParse(YaepParseRun *ps, YaepGrammar *g);
 
-/* The following function frees memory allocated for the parse state. */
+/* The following function frees memory allocated for the parse state.
+   The memory used by a parse is kept by the parse run and reused
+   by the next parse, it is released here or by yaepFreeGrammar. */
 extern void yaepFreeParseRun(YaepParseRun *ps);
 
 /* The following function frees memory allocated for the grammar. */
 extern void yaepFreeGrammar(YaepParseRun *ps, YaepGrammar *g);
 
+/* The following function frees the parse tree in ROOT of the parse run.
+   When PARSE_ALLOC was a null pointer, all nodes are freed at once. The
+   tree is also freed by the next yaepParse, yaepFreeGrammar and
+   yaepFreeParseRun. */
+extern void yaepFreeParseTree(YaepParseRun *ps);
+
 /* The following function frees memory allocated for the parse tree.
+   Use it only for trees allocated with PARSE_ALLOC, use yaepFreeParseTree
+   otherwise.
    It must not be called until after yaep_free_grammar() has been called.
    ROOT must be the root of the parse tree as returned by yaep_parse().
    If ROOT is a null pointer, no operation is performed.
@@ -26,7 +26,10 @@
 
 #ifndef BUILDING_DIST_XMQ
 
+#include <stdlib.h>
 #include "yaep_cspc.h"
+#include "yaep_symbols.h"
+#include "yaep_terminal_bitset.h"
 #include "yaep_vlobject.h"
 #include "yaep_util.h"
 
@@ -144,9 +147,38 @@ static bool completion_ids_eq(hash_table_entry_t t1, hash_table_entry_t t2)
                        &((YaepCoreSymbToPredComps*) t2)->completions);
 }
 
-/* Initialize work with the triples(set core, symbol, vector).*/
+/* Remove all triples and vectors but keep their memory for the next parse.*/
+static void clear_core_symb_to_vect_lookup(YaepParseState *ps)
+{
+    OS_RESET(ps->core_symb_to_predcomps_os);
+    VLO_NULLIFY(ps->new_core_symb_to_predcomps_vlo);
+    OS_RESET(ps->vect_ids_os);
+
+    vlo_array_nullify(ps);
+#ifdef USE_CORE_SYMB_HASH_TABLE
+    empty_hash_table(ps->map_core_symb_to_predcomps);
+#else
+    VLO_NULLIFY(ps->core_symb_table_vlo);
+    ps->core_symb_table = (YaepCoreSymbToPredComps***)VLO_BEGIN(ps->core_symb_table_vlo);
+    OS_RESET(ps->core_symb_tab_rows);
+#endif
+    empty_hash_table(ps->map_transition_to_coresymbvect);
+    empty_hash_table(ps->map_reduce_to_coresymbvect);
+
+    ps->n_core_symb_pairs = ps->n_core_symb_to_predcomps_len = 0;
+    ps->n_transition_vects = ps->n_transition_vect_len = 0;
+    ps->n_reduce_vects = ps->n_reduce_vect_len = 0;
+}
+
+/* Initialize work with the triples(set core, symbol, vector).
+   The memory kept from a previous parse is cleared and reused.*/
 void core_symb_to_predcomps_init(YaepParseState *ps)
 {
+    if (ps->parse_memory_p)
+    {
+        clear_core_symb_to_vect_lookup(ps);
+        return;
+    }
     OS_CREATE(ps->core_symb_to_predcomps_os, ps->run.grammar->alloc, 0);
     VLO_CREATE(ps->new_core_symb_to_predcomps_vlo, ps->run.grammar->alloc, 0);
     OS_CREATE(ps->vect_ids_os, ps->run.grammar->alloc, 0);
@@ -259,10 +291,10 @@ YaepCoreSymbToPredComps *core_symb_to_predcomps_find(YaepParseState *ps, YaepSta
     return r;
 }
 
-YaepCoreSymbToPredComps *core_symb_to_predcomps_new(YaepParseState *ps, YaepStateSetCore*core, YaepSymbol*symb)
+/* Allocate a new triple with empty vectors. The caller places it in the table. */
+static YaepCoreSymbToPredComps *core_symb_to_predcomps_alloc(YaepParseState *ps, YaepStateSetCore*core, YaepSymbol*symb)
 {
     YaepCoreSymbToPredComps*core_symb_to;
-    YaepCoreSymbToPredComps**addr;
     vlo_t*vlo_ptr;
 
     /* Create table element.*/
@@ -271,16 +303,9 @@ YaepCoreSymbToPredComps *core_symb_to_predcomps_new(YaepParseState *ps, YaepStat
     core_symb_to->id = ps->core_symb_to_pred_comps_counter++;
     core_symb_to->core = core;
     core_symb_to->symb = symb;
+    core_symb_to->classes_merged = false;
     OS_TOP_FINISH(ps->core_symb_to_predcomps_os);
 
-#ifdef USE_CORE_SYMB_HASH_TABLE
-    addr = core_symb_to_pred_comps_addr_get(ps, core_symb_to, true);
-#else
-    addr = core_symb_to_pred_comps_addr_get(ps, core, symb);
-#endif
-    assert(*addr == NULL);
-   *addr = core_symb_to;
-
     core_symb_to->predictions.intern = vlo_array_expand(ps);
     vlo_ptr = vlo_array_el(ps, core_symb_to->predictions.intern);
     core_symb_to->predictions.len = 0;
@@ -297,6 +322,36 @@ YaepCoreSymbToPredComps *core_symb_to_predcomps_new(YaepParseState *ps, YaepStat
     return core_symb_to;
 }
 
+/* Return the table entry for the triple. The entry is empty for a new triple. */
+static YaepCoreSymbToPredComps **core_symb_to_predcomps_slot(YaepParseState *ps, YaepCoreSymbToPredComps *core_symb_to)
+{
+#ifdef USE_CORE_SYMB_HASH_TABLE
+    // Bypass the symbol cache since the entry in the hash table is wanted.
+    core_symb_to->symb->cached_core_symb_to_predcomps = NULL;
+    return core_symb_to_pred_comps_addr_get(ps, core_symb_to, true);
+#else
+    return core_symb_to_predcomps_addr_get(ps, core_symb_to->core, core_symb_to->symb);
+#endif
+}
+
+YaepCoreSymbToPredComps *core_symb_to_predcomps_new(YaepParseState *ps, YaepStateSetCore*core, YaepSymbol*symb)
+{
+    YaepCoreSymbToPredComps *core_symb_to = core_symb_to_predcomps_alloc(ps, core, symb);
+    YaepCoreSymbToPredComps **addr = core_symb_to_predcomps_slot(ps, core_symb_to);
+
+    assert(*addr == NULL);
+   *addr = core_symb_to;
+
+    return core_symb_to;
+}
+
+static int compare_rule_index_in_core(const void *a, const void *b)
+{
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
 static void vect_add_id(YaepParseState *ps, YaepVect *vec, int id)
 {
     vec->len++;
@@ -335,6 +390,66 @@ void core_symb_to_predcomps_add_complete(YaepParseState *ps,
 
 }
 
+/* The following function returns the triple(if any) for the input terminal
+   TERM and SET_CORE. The class terminals after the dot in the core that match
+   TERM also predict dotted rules. These predictions are merged with the
+   predictions for TERM itself when the pair is looked up the first time, the
+   merged triple then replaces the triple for TERM in the table. */
+YaepCoreSymbToPredComps *core_term_to_predcomps_find(YaepParseState *ps, YaepStateSetCore *core, YaepSymbol *term)
+{
+    YaepCoreSymbToPredComps *r = core_symb_to_predcomps_find(ps, core, term);
+
+    if (ps->run.grammar->symbs_ptr->num_classes == 0) return r;
+    if (r != NULL && r->classes_merged) return r;
+
+    YaepSymbol *class_symb;
+    int num_classes = 0;
+    for (int i = 0; (class_symb = class_get(ps, i)) != NULL; i++)
+    {
+        if (terminal_bitset_test(ps, class_symb->u.terminal.class_members, term->u.terminal.term_id)
+            && core_symb_to_predcomps_find(ps, core, class_symb) != NULL)
+        {
+            num_classes++;
+        }
+    }
+
+    if (num_classes == 0)
+    {
+        if (r != NULL) r->classes_merged = true;
+        return r;
+    }
+
+    YaepCoreSymbToPredComps *merged = core_symb_to_predcomps_alloc(ps, core, term);
+    if (r != NULL)
+    {
+        for (int j = 0; j < r->predictions.len; j++)
+        {
+            vect_add_id(ps, &merged->predictions, r->predictions.ids[j]);
+        }
+    }
+    for (int i = 0; (class_symb = class_get(ps, i)) != NULL; i++)
+    {
+        if (!terminal_bitset_test(ps, class_symb->u.terminal.class_members, term->u.terminal.term_id)) continue;
+        YaepCoreSymbToPredComps *c = core_symb_to_predcomps_find(ps, core, class_symb);
+        if (c == NULL) continue;
+        for (int j = 0; j < c->predictions.len; j++)
+        {
+            vect_add_id(ps, &merged->predictions, c->predictions.ids[j]);
+        }
+    }
+    // Keep the predictions in the core order, as if they had been added by expand_new_set.
+    qsort(merged->predictions.ids, merged->predictions.len, sizeof(int), compare_rule_index_in_core);
+    merged->classes_merged = true;
+
+    *core_symb_to_predcomps_slot(ps, merged) = merged;
+#ifdef USE_CORE_SYMB_HASH_TABLE
+    term->cached_core_symb_to_predcomps = merged;
+#endif
+    core_symb_to_predcomps_new_all_stop(ps);
+
+    return merged;
+}
+
 /* Insert vector VEC from CORE_SYMB_TO_PREDCOMPS into table TAB.  Update
    *N_VECTS and INT*N_VECT_LEN if it is a new vector in the table. */
 static void process_core_symb_to_predcomps_el(YaepParseState *ps,
@@ -395,11 +510,11 @@ void core_symb_to_predcomps_new_all_stop(YaepParseState *ps)
 /* Finalize work with all triples(set core, symbol, vector).*/
 void free_core_symb_to_vect_lookup(YaepParseState *ps)
 {
-    delete_hash_table(ps->map_transition_to_coresymbvect);
-    delete_hash_table(ps->map_reduce_to_coresymbvect);
+    delete_parse_hash_table(ps, ps->map_transition_to_coresymbvect);
+    delete_parse_hash_table(ps, ps->map_reduce_to_coresymbvect);
 
 #ifdef USE_CORE_SYMB_HASH_TABLE
-    delete_hash_table(ps->map_core_symb_to_predcomps);
+    delete_parse_hash_table(ps, ps->map_core_symb_to_predcomps);
 #else
     OS_DELETE(ps->core_symb_tab_rows);
     VLO_DELETE(ps->core_symb_table_vlo);
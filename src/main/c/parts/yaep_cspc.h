@@ -36,6 +36,7 @@
 YaepCoreSymbToPredComps *core_symb_to_predcomps_new(YaepParseState *ps, YaepStateSetCore*core, YaepSymbol*symb);
 void core_symb_to_predcomps_init(YaepParseState *ps);
 YaepCoreSymbToPredComps *core_symb_to_predcomps_find(YaepParseState *ps, YaepStateSetCore *core, YaepSymbol *symb);
+YaepCoreSymbToPredComps *core_term_to_predcomps_find(YaepParseState *ps, YaepStateSetCore *core, YaepSymbol *term);
 void free_core_symb_to_vect_lookup(YaepParseState *ps);
 void core_symb_to_predcomps_add_predict(YaepParseState *ps,
                                         YaepCoreSymbToPredComps *core_symb_to_predcomps,
@@ -173,28 +173,13 @@ expand_hash_table (hash_table_t htab)
 	*new_entry_ptr = (*entry_ptr);
       }
   yaep_free (htab->alloc, htab->entries);
+  /* Keep the counters of the table, the reinsertions are not counted. */
+  new_htab->searches = htab->searches;
+  new_htab->collisions = htab->collisions;
   *htab = (*new_htab);
   yaep_free (new_htab->alloc, new_htab);
 }
 
-/* The following variable is used for debugging. Its value is number
-   of all calls of `find_hash_table_entry' for all hash tables. */
-int all_searches = 0;
-
-/* The following variable is used for debugging. Its value is number
-   of collisions fixed for time of work with all hash tables. */
-int all_collisions = 0;
-
-int get_all_searches ()
-{
-    return all_searches;
-}
-
-int get_all_collisions()
-{
-    return all_collisions;
-}
-
 /* This function searches for hash table entry which contains element
    equal to given value or empty entry in which given value can be
    placed (if the element with given value does not exist in the
@@ -223,9 +208,8 @@ find_hash_table_entry (hash_table_t htab,
   secondary_hash_value = 1 + hash_value % (htab->size - 2);
   hash_value %= htab->size;
   htab->searches++;
-  all_searches++;
   first_deleted_entry_ptr = NULL;
-  for (;; htab->collisions++, all_collisions++)
+  for (;; htab->collisions++)
     {
       entry_ptr = htab->entries + hash_value;
       if (*entry_ptr == EMPTY_ENTRY)
@@ -88,16 +88,6 @@ typedef struct
 } *hash_table_t;
 
 
-/* The following variable is used for debugging. Its value is number
-   of all calls of `find_hash_table_entry' for all hash tables. */
-
-//extern int all_searches;
-
-/* The following variable is used for debugging. Its value is number
-   of collisions fixed for time of work with all hash tables. */
-
-//extern int all_collisions;
-
 /* The prototypes of the package functions. */
 
 extern hash_table_t create_hash_table(YaepAllocator * allocator,
@@ -136,14 +126,7 @@ get_collisions (hash_table_t htab)
   return htab->collisions;
 }
 
-/* The following function returns number of searches during all work
-   with all hash tables. */
-int get_all_searches();
-/* The following function returns number of occurred collisions
-   during all work with all hash tables. */
-int get_all_collisions();
 int hash_table_collision_percentage (hash_table_t htab);
-int all_hash_table_collision_percentage (void);
 
 size_t hash_table_memusage(hash_table_t htab);
 
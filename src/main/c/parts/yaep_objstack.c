@@ -71,6 +71,31 @@ _OS_create_function (os_t * os, size_t initial_segment_length)
   os->os_top_object_stop = os->os_top_object_start;
   os->os_segment_stop = os->os_top_object_start + initial_segment_length;
   os->initial_segment_length = initial_segment_length;
+  os->os_free_segments = NULL;
+}
+
+/* Free the segments kept for reuse by OS_RESET. */
+
+static void
+free_os_free_segments (os_t * os)
+{
+  struct _os_segment *current_segment, *next_segment;
+
+  for (current_segment = os->os_free_segments; current_segment != NULL;
+       current_segment = next_segment)
+    {
+      next_segment = current_segment->os_previous_segment;
+      yaep_free (os->os_alloc, current_segment);
+    }
+  os->os_free_segments = NULL;
+}
+
+/* Return the first byte after the memory usable for objects in SEGMENT. */
+
+static char *
+os_segment_bound (struct _os_segment *segment)
+{
+  return (char *) segment + segment->os_segment_size;
 }
 
 /* The function implements macro `OS_DELETE' (freeing memory allocated
@@ -92,6 +117,7 @@ _OS_delete_function (os_t * os)
       yaep_free (os->os_alloc, current_segment);
     }
   os->os_current_segment = NULL;
+  free_os_free_segments (os);
 }
 
 /* The following function implements macro `OS_EMPTY' (freeing memory
@@ -117,6 +143,34 @@ _OS_empty_function (os_t * os)
     = (char *) _OS_ALIGNED_ADDRESS (current_segment->os_segment_content);
   os->os_top_object_stop = os->os_top_object_start;
   os->os_segment_stop = os->os_top_object_start + os->initial_segment_length;
+  free_os_free_segments (os);
+}
+
+/* The following function implements macro `OS_RESET' (removing all
+   objects but keeping the memory segments).  The first segment becomes
+   current again and the other segments are kept in the free list. */
+
+void
+_OS_reset_function (os_t * os)
+{
+  struct _os_segment *current_segment, *previous_segment;
+
+  assert (os->os_top_object_start != NULL && os->os_current_segment != NULL);
+  current_segment = os->os_current_segment;
+  for (;;)
+    {
+      previous_segment = current_segment->os_previous_segment;
+      if (previous_segment == NULL)
+	break;
+      current_segment->os_previous_segment = os->os_free_segments;
+      os->os_free_segments = current_segment;
+      current_segment = previous_segment;
+    }
+  os->os_current_segment = current_segment;
+  os->os_top_object_start
+    = (char *) _OS_ALIGNED_ADDRESS (current_segment->os_segment_content);
+  os->os_top_object_stop = os->os_top_object_start;
+  os->os_segment_stop = os_segment_bound (current_segment);
 }
 
 /* The function implements macro `OS_ADD_STRING' (addition of string
@@ -170,8 +224,23 @@ _OS_expand_memory (os_t * os, size_t additional_length)
     }
 
     size_t new_segment_size = segment_length + sizeof (struct _os_segment);
-    new_segment = (struct _os_segment*)yaep_malloc (os->os_alloc, new_segment_size);
-    new_segment->os_segment_size = new_segment_size;
+
+    /* Reuse a segment kept by OS_RESET if one is large enough. */
+    struct _os_segment **free_segment_ptr = &os->os_free_segments;
+    while (*free_segment_ptr != NULL && (*free_segment_ptr)->os_segment_size < new_segment_size)
+    {
+        free_segment_ptr = &(*free_segment_ptr)->os_previous_segment;
+    }
+    if (*free_segment_ptr != NULL)
+    {
+        new_segment = *free_segment_ptr;
+        *free_segment_ptr = new_segment->os_previous_segment;
+    }
+    else
+    {
+        new_segment = (struct _os_segment*)yaep_malloc (os->os_alloc, new_segment_size);
+        new_segment->os_segment_size = new_segment_size;
+    }
     new_os_top_object_start = (char *)_OS_ALIGNED_ADDRESS (new_segment->os_segment_content);
     memcpy (new_os_top_object_start, os->os_top_object_start, os_top_object_length);
 
@@ -189,7 +258,7 @@ _OS_expand_memory (os_t * os, size_t additional_length)
 
     os->os_top_object_start = new_os_top_object_start;
     os->os_top_object_stop = os->os_top_object_start + os_top_object_length;
-    os->os_segment_stop = os->os_top_object_start + segment_length;
+    os->os_segment_stop = os_segment_bound (new_segment);
 }
 
 size_t objstack_memusage(os_t *os)
@@ -204,6 +273,10 @@ size_t objstack_memusage(os_t *os)
         sum += curr->os_segment_size;
         curr = curr->os_previous_segment;
     }
+    for (curr = os->os_free_segments; curr; curr = curr->os_previous_segment)
+    {
+        sum += curr->os_segment_size;
+    }
 
     return sum;
 }
@@ -144,6 +144,9 @@ typedef struct
 
   /* Pointer to allocator. */
   YaepAllocator *os_alloc;
+
+  /* Segments kept by OS_RESET for reuse by later objects. */
+  struct _os_segment *os_free_segments;
 } os_t;
 
 
@@ -172,6 +175,12 @@ typedef struct
 
 #define OS_EMPTY(os) _OS_empty_function (& (os))
 
+/* This macro removes all objects from OS but keeps all memory
+   segments, the segments are reused as the OS grows again.  The macro
+   has no side effects. */
+
+#define OS_RESET(os) _OS_reset_function (& (os))
+
 /* This macro makes that length of variable length object on the top
    of OS will be equal to zero.  The macro has no side effects. */
 
@@ -330,6 +339,7 @@ typedef struct
 extern void _OS_create_function (os_t *os, size_t initial_segment_length);
 extern void _OS_delete_function (os_t *os);
 extern void _OS_empty_function (os_t *os);
+extern void _OS_reset_function (os_t *os);
 extern void _OS_add_string_function (os_t *os, const char *str);
 extern void _OS_expand_memory (os_t *os, size_t additional_length);
 
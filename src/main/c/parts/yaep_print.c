@@ -437,7 +437,8 @@ void print_parse(YaepParseState *ps, FILE* f, YaepTreeNode*root)
     OS_CREATE(ps->node_visits_os, ps->run.grammar->alloc, 0);
     print_yaep_node(ps, f, root);
     OS_DELETE(ps->node_visits_os);
-    delete_hash_table(ps->map_node_to_visit);
+    delete_parse_hash_table(ps, ps->map_node_to_visit);
+    ps->map_node_to_visit = NULL;
 }
 
 /* The following function prints SET to file F.  If NOT_YET_STARTED_P is true
@@ -63,7 +63,8 @@ typedef unsigned long int terminal_bitset_t;
    Lets pick 200_000 as the max, it shrinks to max-min code point anyway.*/
 #define MAX_SYMB_CODE_TRANS_VECT_SIZE 200000
 
-/* The initial length of array(in tokens) in which input tokens are placed.*/
+/* The initial length of array(in tokens) in which input tokens are placed.
+   The same length is used for the initial array of state sets.*/
 #ifndef NUM_INITIAL_YAEP_INIT_TOKENS
 #define NUM_INITIAL_YAEP_TOKENS 10000
 #endif
@@ -78,9 +79,18 @@ typedef unsigned long int terminal_bitset_t;
 /* This does not seem to be enabled by default? */
 #define USE_CORE_SYMB_HASH_TABLE
 
+/* The parse memory (state sets, dotted rules, hash tables) is kept between
+   the parses of a parse run and cleared before the next parse. A parse that
+   used more memory than this releases it instead. */
+#define MAX_RETAINED_PARSE_MEMORY (16*1024*1024)
+
 /* Maximal goto sets saved for triple(set, terminal, lookahead). */
 #define MAX_CACHED_GOTO_RESULTS 3
 
+/* Leo chains of deterministic completions shorter than this are completed as usual.
+   Right recursion grows the chains with the input, other rules give short chains. */
+#define LEO_MIN_CHAIN_LENGTH 8
+
 /* Prime number(79087987342985798987987) mod 32 used for hash calculations. */
 static const unsigned jauquet_prime_mod32 = 2053222611;
 
@@ -135,6 +145,18 @@ typedef struct YaepTreeNodeVisit YaepTreeNodeVisit;
 struct YaepRecoveryState;
 typedef struct YaepRecoveryState YaepRecoveryState;
 
+struct YaepLeoItem;
+typedef struct YaepLeoItem YaepLeoItem;
+
+struct YaepLeoStep;
+typedef struct YaepLeoStep YaepLeoStep;
+
+struct YaepLeoChildren;
+typedef struct YaepLeoChildren YaepLeoChildren;
+
+struct YaepLeoChild;
+typedef struct YaepLeoChild YaepLeoChild;
+
 // Structure definitions ////////////////////////////////////////////////////
 
 struct YaepGrammar
@@ -224,6 +246,15 @@ struct YaepSymbol
                starts with 100 and ends with 129,then the term_ids goes from 0 to 29.
                The term_ids are used for picking the bit in the bit arrays. */
             int term_id;
+            /* A class terminal is never an input token, instead it matches every input
+               terminal whose code is found in the interval table. The table is sorted
+               and stores inclusive from,to pairs. E.g. the ixml charset [L] is a single
+               class terminal, no matter how many letters the input contains. */
+            bool is_class;
+            int *class_intervals;
+            int num_class_intervals;
+            /* The term_ids of the terminals matched by the class terminal. */
+            terminal_bitset_t *class_members;
         } terminal;
         struct
         {
@@ -272,6 +303,10 @@ struct YaepSymbolStorage
     vlo_t terminals_vlo;
     vlo_t nonterminals_vlo;
 
+    /* The class terminals are also stored here, they are tested at scan time. */
+    vlo_t classes_vlo;
+    int num_classes;
+
     /* The following are tables to find terminal by its code and symbol by
        its representation.*/
     hash_table_t map_repr_to_symb;        /* key is `repr'*/
@@ -344,6 +379,10 @@ struct YaepCoreSymbToPredComps
 
     /* The following vector contains id of completed dotted_rule with given symb in lhs. */
     YaepVect completions;
+
+    /* True when the predictions for an input terminal also contain the predictions
+       of the class terminals in the core that matches the input terminal. */
+    bool classes_merged;
 };
 
 /* A StateSetCore is a state set in Earley's algorithm but without matched lengths for the dotted rules.
@@ -474,6 +513,65 @@ struct YaepStateSetTermLookAhead
     int place[MAX_CACHED_GOTO_RESULTS];
 };
 
+/* Leo's deterministic reduction path. When the state set at state_set_k
+   has exactly one dotted rule A = x . symb, and symb is the last symbol in
+   the rule, then completing symb from state_set_k always completes A too.
+   The chain of such deterministic completions is memoized in Leo items. */
+struct YaepLeoItem
+{
+    /* Keys */
+    int state_set_k;
+    YaepSymbol *symb;
+
+    /* The completed dotted rule A = x symb . and its origin. The dotted_rule
+       is NULL if the completion of symb from state_set_k is not deterministic. */
+    YaepDottedRule *dotted_rule;
+    int from_i;
+
+    /* The Leo item for completing A from from_i. NULL if dotted_rule is the top of the chain. */
+    YaepLeoItem *next;
+
+    /* The topmost completed dotted rule of the chain, its origin and the
+       number of completions from this item up to the top. */
+    YaepDottedRule *top_dotted_rule;
+    int top_from_i;
+    int chain_length;
+
+    /* True while the chain is being followed, used to detect cyclic chains. */
+    bool walking_p;
+};
+
+/* A Leo item used when the state set at state_set_k was built. Only the top of
+   the chain was added to the state set, the completions from the bottom item
+   up to the top are implied and expanded by the tree builder. */
+struct YaepLeoStep
+{
+    int state_set_k;
+    YaepLeoItem *bottom;
+    /* Set when the tree builder has expanded the chain of this step. */
+    bool expanded_p;
+};
+
+/* The implied completions that are children of the completed dotted rule
+   (with origin from_i) in the state set at state_set_k. Built by the tree builder. */
+struct YaepLeoChildren
+{
+    /* Keys */
+    int state_set_k;
+    YaepDottedRule *dotted_rule;
+    int from_i;
+
+    /* The children in the order they were found. */
+    YaepLeoChild *first, *last;
+};
+
+/* An implied child is the dotted_rule and from_i of the Leo item. */
+struct YaepLeoChild
+{
+    YaepLeoItem *item;
+    YaepLeoChild *next;
+};
+
 struct YaepRule
 {
     /* The following is order number of rule. */
@@ -616,10 +714,13 @@ struct YaepParseState
     /* Track state of this object. */
     int magic_cookie;
 
-    /* The input token array to be parsed. */
+    /* The input token array to be parsed. The tokens are read lazily from
+       read_token as the parse advances, input_len is the number of tokens
+       read so far and input_done_p is set when the end marker has been added. */
     YaepInputToken *input;
     int input_len;
     vlo_t input_vlo;
+    bool input_done_p;
 
     /* When parsing, the current input token is incremented from 0 to len. */
     int tok_i;
@@ -659,6 +760,10 @@ struct YaepParseState
     /* Number of state sets and their number of dotted_rules. */
     int num_sets_total, num_dotted_rules_total;
 
+    /* Number of new state sets looked up in the set cache and how many
+       were already there. */
+    int n_set_lookups, n_set_successes;
+
     /* Number of lookaheads (set, term, lookahead). */
     int num_set_term_lookahead;
 
@@ -687,6 +792,23 @@ struct YaepParseState
     hash_table_t cache_stateset_core_matched_lengths; /* key is (core, matched_lengths). */
     hash_table_t cache_stateset_term_lookahead;       /* key is (set, term, lookeahed). */
 
+    /* Leo's optimization of right recursion. It is disabled when error recovery
+       is on, since error recovery replaces state sets that the Leo items refer to. */
+    bool leo_p;
+
+    /* The Leo items are placed in the following os. */
+    os_t leo_items_os;
+    hash_table_t map_leo_items; /* key is (state_set_k, symb). */
+
+    /* Leo items of a chain being followed for the first time. */
+    vlo_t leo_walk_vlo;
+
+    /* The Leo steps in state set order, i.e. an array of YaepLeoStep. */
+    vlo_t leo_steps_vlo;
+
+    /* Number of Leo items and steps. */
+    int num_leo_items, num_leo_steps;
+
     /* The following contains current number of unique dotted_rules. */
     int num_all_dotted_rules;
 
@@ -758,10 +880,21 @@ struct YaepParseState
     /* Store state sets in a growing array. Even though early parser
        specifies a new state set per token, we can reuse a state set if
        the matched lengths are the same. This means that the
-       state_set_k can increment fewer times than tok_i. */
+       state_set_k can increment fewer times than tok_i.
+       The array is grown on demand in state_sets_vlo. */
     YaepStateSet **state_sets;
+    vlo_t state_sets_vlo;
     int state_set_k;
 
+    /* True when the input, the state sets and the parse tables exist. They
+       are created by the first parse and then cleared by each parse. */
+    bool parse_memory_p;
+
+    /* The tree nodes are allocated here when the caller has not set
+       parse_alloc. The whole tree is freed by resetting the os. */
+    os_t tree_nodes_os;
+    bool tree_nodes_p;
+
     /* The following is number of created terminal, abstract, and
        alternative nodes. */
     int n_parse_term_nodes, n_parse_abstract_nodes, n_parse_alt_nodes;
@@ -814,8 +947,13 @@ struct YaepParseState
     /* The following value is number of translation visit nodes. */
     int num_nodes_visits;
 
-    /* How many times we reuse Earley's sets without their recalculation. */
-    int n_goto_successes;
+    /* How many times we reuse Earley's sets without their recalculation
+       and how many times we looked for a set to reuse. */
+    int n_goto_successes, n_goto_lookups;
+
+    /* Searches and collisions in the hash tables of this parse. The counts
+       of a table are added when the table is deleted or the parse ends. */
+    size_t table_searches, table_collisions;
 
     /* The following vlo is error recovery states stack.  The stack
        contains error recovery state which should be investigated to find
@@ -834,6 +972,10 @@ struct YaepParseState
        translations. */
     hash_table_t map_rule_orig_statesetind_to_internalstate;        /* Key is rule, origin, state_set_k.*/
 
+    /* The implied children of Leo chains expanded by the tree builder. */
+    os_t leo_children_os;
+    hash_table_t map_leo_children; /* Key is state_set_k, dotted_rule, from_i. */
+
     int core_symb_to_pred_comps_counter;
 
     /* Jump here when error. */
@@ -90,11 +90,13 @@ YaepSymbolStorage *symbolstorage_create(YaepGrammar *grammar)
     VLO_CREATE(result->symbs_vlo, grammar->alloc, 1024);
     VLO_CREATE(result->terminals_vlo, grammar->alloc, 512);
     VLO_CREATE(result->nonterminals_vlo, grammar->alloc, 512);
+    VLO_CREATE(result->classes_vlo, grammar->alloc, 64);
     result->map_repr_to_symb = create_hash_table(grammar->alloc, 300, symb_repr_hash, symb_repr_eq);
     result->map_code_to_symb = create_hash_table(grammar->alloc, 200, symb_code_hash, symb_code_eq);
     result->symb_code_trans_vect = NULL;
     result->num_nonterminals = 0;
     result->num_terminals = 0;
+    result->num_classes = 0;
 
     return result;
 }
@@ -136,7 +138,7 @@ YaepSymbol *symb_find_by_code(YaepParseState *ps, int code)
 
 YaepSymbol *symb_find_by_term_id(YaepParseState *ps, int term_id)
 {
-    return symb_find_by_code(ps, term_id+ps->run.grammar->symbs_ptr->symb_code_trans_vect_start);
+    return term_get(ps, term_id);
 }
 
 /* The function creates new terminal symbol and returns reference for
@@ -183,6 +185,72 @@ YaepSymbol *symb_add_terminal(YaepParseState *ps, const char*name, int code)
     return result;
 }
 
+/* The function creates a new class terminal symbol with a copy of the
+   interval table. The class terminal has no entry in the code table
+   since it never appears in the input. */
+YaepSymbol *symb_add_class_terminal(YaepParseState *ps, const char *name, int code, const int *intervals, int num_intervals)
+{
+    YaepSymbol symb, *result;
+    hash_table_entry_t *repr_entry;
+
+    memset(&symb, 0, sizeof(symb));
+
+    symb.repr = name;
+    strncpy(symb.hr, name, 6);
+    symb.is_terminal = true;
+    // Assign the next available id.
+    symb.id = ps->run.grammar->symbs_ptr->num_nonterminals + ps->run.grammar->symbs_ptr->num_terminals;
+    symb.u.terminal.code = code;
+    symb.u.terminal.term_id = ps->run.grammar->symbs_ptr->num_terminals++;
+    symb.u.terminal.is_class = true;
+    symb.u.terminal.num_class_intervals = num_intervals;
+    repr_entry = find_hash_table_entry(ps->run.grammar->symbs_ptr->map_repr_to_symb, &symb, true);
+    assert(*repr_entry == NULL);
+    if (num_intervals > 0)
+    {
+        OS_TOP_ADD_MEMORY(ps->run.grammar->symbs_ptr->symbs_os, intervals, 2*num_intervals*sizeof(int));
+        symb.u.terminal.class_intervals = (int*)OS_TOP_BEGIN(ps->run.grammar->symbs_ptr->symbs_os);
+        OS_TOP_FINISH(ps->run.grammar->symbs_ptr->symbs_os);
+    }
+    OS_TOP_ADD_STRING(ps->run.grammar->symbs_ptr->symbs_os, name);
+    symb.repr =(char*) OS_TOP_BEGIN(ps->run.grammar->symbs_ptr->symbs_os);
+    OS_TOP_FINISH(ps->run.grammar->symbs_ptr->symbs_os);
+    OS_TOP_ADD_MEMORY(ps->run.grammar->symbs_ptr->symbs_os, &symb, sizeof(YaepSymbol));
+    result =(YaepSymbol*) OS_TOP_BEGIN(ps->run.grammar->symbs_ptr->symbs_os);
+    OS_TOP_FINISH(ps->run.grammar->symbs_ptr->symbs_os);
+   *repr_entry =(hash_table_entry_t) result;
+    VLO_ADD_MEMORY(ps->run.grammar->symbs_ptr->symbs_vlo, &result, sizeof(YaepSymbol*));
+    VLO_ADD_MEMORY(ps->run.grammar->symbs_ptr->terminals_vlo, &result, sizeof(YaepSymbol*));
+    VLO_ADD_MEMORY(ps->run.grammar->symbs_ptr->classes_vlo, &result, sizeof(YaepSymbol*));
+    ps->run.grammar->symbs_ptr->num_classes++;
+
+    return result;
+}
+
+/* Return true if CODE is inside the interval table of the class terminal. */
+bool symb_class_has_code(YaepSymbol *symb, int code)
+{
+    const int *intervals = symb->u.terminal.class_intervals;
+    int lo = 0;
+    int hi = symb->u.terminal.num_class_intervals;
+
+    // Binary search for the first interval that ends at or after code.
+    while (lo < hi)
+    {
+        int mid = lo + ((hi-lo) >> 1);
+        if (intervals[2*mid+1] < code) lo = mid+1;
+        else hi = mid;
+    }
+    return lo < symb->u.terminal.num_class_intervals && intervals[2*lo] <= code;
+}
+
+/* The following function return N-th class terminal(if any) or NULL otherwise. */
+YaepSymbol *class_get(YaepParseState *ps, int n)
+{
+    if (n < 0 || n >= ps->run.grammar->symbs_ptr->num_classes) return NULL;
+    return ((YaepSymbol**) VLO_BEGIN(ps->run.grammar->symbs_ptr->classes_vlo))[n];
+}
+
 /* The function creates new nonterminal symbol and returns reference
    for it.  The symbol should be not in the table. The function
    should create own copy of name for the new symbol. */
@@ -268,12 +336,16 @@ void symb_finish_adding_terms(YaepParseState *ps)
     YaepSymbol *symb;
     void *mem;
 
+    bool found = false;
     for (min_code = max_code = i = 0;(symb = term_get(ps, i)) != NULL; i++)
     {
-        if (i == 0 || min_code > symb->u.terminal.code) min_code = symb->u.terminal.code;
-        if (i == 0 || max_code < symb->u.terminal.code) max_code = symb->u.terminal.code;
+        // The class terminals are not looked up by code.
+        if (symb->u.terminal.is_class) continue;
+        if (!found || min_code > symb->u.terminal.code) min_code = symb->u.terminal.code;
+        if (!found || max_code < symb->u.terminal.code) max_code = symb->u.terminal.code;
+        found = true;
     }
-    assert(i != 0);
+    assert(found);
     assert((max_code - min_code) < MAX_SYMB_CODE_TRANS_VECT_SIZE);
 
     ps->run.grammar->symbs_ptr->symb_code_trans_vect_start = min_code;
@@ -285,8 +357,10 @@ void symb_finish_adding_terms(YaepParseState *ps)
 
     ps->run.grammar->symbs_ptr->symb_code_trans_vect =(YaepSymbol**)mem;
 
+    memset(mem, 0, vec_size);
     for(i = 0;(symb = term_get(ps, i)) != NULL; i++)
     {
+        if (symb->u.terminal.is_class) continue;
         ps->run.grammar->symbs_ptr->symb_code_trans_vect[symb->u.terminal.code - min_code] = symb;
     }
 
@@ -308,9 +382,10 @@ void symb_empty(YaepParseState *ps, YaepSymbolStorage *symbs)
     empty_hash_table(symbs->map_code_to_symb);
     VLO_NULLIFY(symbs->nonterminals_vlo);
     VLO_NULLIFY(symbs->terminals_vlo);
+    VLO_NULLIFY(symbs->classes_vlo);
     VLO_NULLIFY(symbs->symbs_vlo);
     OS_EMPTY(symbs->symbs_os);
-    symbs->num_nonterminals = symbs->num_terminals = 0;
+    symbs->num_nonterminals = symbs->num_terminals = symbs->num_classes = 0;
 }
 
 void symbolstorage_free(YaepParseState *ps, YaepSymbolStorage *symbs)
@@ -326,6 +401,7 @@ void symbolstorage_free(YaepParseState *ps, YaepSymbolStorage *symbs)
     delete_hash_table(ps->run.grammar->symbs_ptr->map_code_to_symb);
     VLO_DELETE(ps->run.grammar->symbs_ptr->nonterminals_vlo);
     VLO_DELETE(ps->run.grammar->symbs_ptr->terminals_vlo);
+    VLO_DELETE(ps->run.grammar->symbs_ptr->classes_vlo);
     VLO_DELETE(ps->run.grammar->symbs_ptr->symbs_vlo);
     OS_DELETE(ps->run.grammar->symbs_ptr->symbs_os);
     yaep_free(ps->run.grammar->alloc, symbs);
@@ -46,6 +46,14 @@ YaepSymbol *symb_find_by_term_id(YaepParseState *ps, int term_id);
    create own copy of name for the new symbol. */
 YaepSymbol *symb_add_terminal(YaepParseState *ps, const char*name, int code);
 
+/* The function creates a new class terminal symbol with a copy of the
+   interval table. The class terminal has no entry in the code table
+   since it never appears in the input. */
+YaepSymbol *symb_add_class_terminal(YaepParseState *ps, const char *name, int code, const int *intervals, int num_intervals);
+
+/* Return true if CODE is inside the interval table of the class terminal. */
+bool symb_class_has_code(YaepSymbol *symb, int code);
+
 /* The function creates new nonterminal symbol and returns reference
    for it.  The symbol should be not in the table. The function
    should create own copy of name for the new symbol. */
@@ -60,6 +68,9 @@ YaepSymbol *term_get(YaepParseState *ps, int n);
 /* The following function return N-th symbol(if any) or NULL otherwise. */
 YaepSymbol *nonterm_get(YaepParseState *ps, int n);
 
+/* The following function return N-th class terminal(if any) or NULL otherwise. */
+YaepSymbol *class_get(YaepParseState *ps, int n);
+
 void symb_finish_adding_terms(YaepParseState *ps);
 
 /* Free memory for symbols. */
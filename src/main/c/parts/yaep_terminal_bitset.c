@@ -105,6 +105,24 @@ terminal_bitset_t *terminal_bitset_create(YaepParseState *ps)
     return result;
 }
 
+/* Create a terminal set for a dotted rule lookahead. The set lives in the dotted rules
+   object stack and is freed when the parse is done. This keeps the grammar storage
+   from growing when a compiled grammar is reused for many parses. */
+terminal_bitset_t *terminal_bitset_create_for_parse(YaepParseState *ps)
+{
+    int size_bytes;
+    terminal_bitset_t *result;
+    int num_terminals = ps->run.grammar->symbs_ptr->num_terminals;
+
+    size_bytes = sizeof(terminal_bitset_t) * CALC_NUM_ELEMENTS(num_terminals);
+
+    OS_TOP_EXPAND(ps->dotted_rules_os, size_bytes);
+    result =(terminal_bitset_t*) OS_TOP_BEGIN(ps->dotted_rules_os);
+    OS_TOP_FINISH(ps->dotted_rules_os);
+
+    return result;
+}
+
 void terminal_bitset_clear(YaepParseState *ps, terminal_bitset_t* set)
 {
     terminal_bitset_t*bound;
@@ -70,6 +70,7 @@ unsigned terminal_bitset_hash(hash_table_entry_t s);
 bool terminal_bitset_eq(hash_table_entry_t s1, hash_table_entry_t s2);
 YaepTerminalSetStorage *termsetstorage_create(YaepGrammar *grammar);
 terminal_bitset_t *terminal_bitset_create(YaepParseState *ps);
+terminal_bitset_t *terminal_bitset_create_for_parse(YaepParseState *ps);
 void terminal_bitset_clear(YaepParseState *ps, terminal_bitset_t* set);
 void terminal_bitset_fill(YaepParseState *ps, terminal_bitset_t* set);
 void terminal_bitset_copy(YaepParseState *ps, terminal_bitset_t *dest, terminal_bitset_t *src);
@@ -27,6 +27,7 @@
 #ifndef BUILDING_DIST_XMQ
 
 #include <stdbool.h>
+#include <string.h>
 #include "yaep_cspc.h"
 #include "yaep_print.h"
 #include "yaep_structs.h"
@@ -37,6 +38,24 @@
 
 #ifdef YAEP_TREE_MODULE
 
+/* Allocate zeroed memory of SIZE bytes for the parse tree. Unless the caller
+   supplied parse_alloc the memory is taken from tree_nodes_os, the whole tree
+   is then freed at once when the os is reset. */
+static void *tree_alloc(YaepParseState *ps, int size)
+{
+    if (ps->run.parse_alloc != NULL)
+    {
+        return (*ps->run.parse_alloc)(size);
+    }
+
+    OS_TOP_EXPAND(ps->tree_nodes_os, size);
+    void *mem = OS_TOP_BEGIN(ps->tree_nodes_os);
+    OS_TOP_FINISH(ps->tree_nodes_os);
+    memset(mem, 0, size);
+
+    return mem;
+}
+
 static unsigned parse_state_hash(hash_table_entry_t s)
 {
     YaepParseTreeBuildState*state =((YaepParseTreeBuildState*) s);
@@ -60,6 +79,24 @@ static bool parse_state_eq(hash_table_entry_t s1, hash_table_entry_t s2)
             && state1->state_set_k == state2->state_set_k);
 }
 
+static unsigned leo_children_hash(hash_table_entry_t c)
+{
+    YaepLeoChildren *children = (YaepLeoChildren*)c;
+
+    return(((jauquet_prime_mod32* hash_shift +
+             (unsigned)children->dotted_rule->id)* hash_shift +
+             children->from_i)* hash_shift + children->state_set_k);
+}
+
+static bool leo_children_eq(hash_table_entry_t c1, hash_table_entry_t c2)
+{
+    YaepLeoChildren *children1 = (YaepLeoChildren*)c1;
+    YaepLeoChildren *children2 = (YaepLeoChildren*)c2;
+
+    return(children1->dotted_rule == children2->dotted_rule && children1->from_i == children2->from_i
+            && children1->state_set_k == children2->state_set_k);
+}
+
 /* The following function initializes work with parser states.*/
 static void parse_state_init(YaepParseState *ps)
 {
@@ -72,6 +109,13 @@ static void parse_state_init(YaepParseState *ps)
                               (hash_table_hash_function)parse_state_hash,
                               (hash_table_eq_function)parse_state_eq);
     }
+    if (ps->num_leo_steps > 0)
+    {
+        OS_CREATE(ps->leo_children_os, ps->run.grammar->alloc, 0);
+        ps->map_leo_children = create_hash_table(ps->run.grammar->alloc, 2000,
+                                                 (hash_table_hash_function)leo_children_hash,
+                                                 (hash_table_eq_function)leo_children_eq);
+    }
 }
 
 /* The following function returns new parser state.*/
@@ -132,11 +176,126 @@ static void free_parse_state(YaepParseState *ps)
 {
     if (!ps->run.grammar->one_parse_p)
     {
-        delete_hash_table(ps->map_rule_orig_statesetind_to_internalstate);
+        delete_parse_hash_table(ps, ps->map_rule_orig_statesetind_to_internalstate);
+        ps->map_rule_orig_statesetind_to_internalstate = NULL;
+    }
+    if (ps->num_leo_steps > 0)
+    {
+        delete_parse_hash_table(ps, ps->map_leo_children);
+        OS_DELETE(ps->leo_children_os);
     }
     OS_DELETE(ps->parse_state_os);
 }
 
+/* Add the implied completion of Leo item CHILD as a child of the completion
+   of Leo item PARENT in the state set at STATE_SET_K.
+   Returns false if the child was already added. */
+static bool leo_children_add(YaepParseState *ps, int state_set_k, YaepLeoItem *parent, YaepLeoItem *child)
+{
+    OS_TOP_EXPAND(ps->leo_children_os, sizeof(YaepLeoChildren));
+    YaepLeoChildren *children = (YaepLeoChildren*)OS_TOP_BEGIN(ps->leo_children_os);
+    children->state_set_k = state_set_k;
+    children->dotted_rule = parent->dotted_rule;
+    children->from_i = parent->from_i;
+
+    YaepLeoChildren **entry = (YaepLeoChildren**)find_hash_table_entry(ps->map_leo_children, children, true);
+    if (*entry != NULL)
+    {
+        OS_TOP_NULLIFY(ps->leo_children_os);
+        children = *entry;
+        for (YaepLeoChild *c = children->first; c != NULL; c = c->next)
+        {
+            if (c->item->dotted_rule == child->dotted_rule && c->item->from_i == child->from_i)
+            {
+                return false;
+            }
+        }
+    }
+    else
+    {
+        OS_TOP_FINISH(ps->leo_children_os);
+        *entry = children;
+        children->first = children->last = NULL;
+    }
+
+    OS_TOP_EXPAND(ps->leo_children_os, sizeof(YaepLeoChild));
+    YaepLeoChild *c = (YaepLeoChild*)OS_TOP_BEGIN(ps->leo_children_os);
+    OS_TOP_FINISH(ps->leo_children_os);
+    c->item = child;
+    c->next = NULL;
+    if (children->last != NULL)
+    {
+        children->last->next = c;
+    }
+    else
+    {
+        children->first = c;
+    }
+    children->last = c;
+    return true;
+}
+
+/* Expand the Leo chains used when building the state set at STATE_SET_K
+   whose top is the completed DOTTED_RULE with origin FROM_I. Each chain is
+   followed from its bottom until it joins an already expanded chain.
+   Returns false if there was nothing to expand. */
+static bool leo_expand_steps(YaepParseState *ps, int state_set_k, YaepDottedRule *dotted_rule, int from_i)
+{
+    YaepLeoStep *steps = (YaepLeoStep*)VLO_BEGIN(ps->leo_steps_vlo);
+    int lo = 0;
+    int hi = ps->num_leo_steps;
+
+    // The steps are stored in state set order, find the first step for state_set_k.
+    while (lo < hi)
+    {
+        int mid = lo + (hi - lo) / 2;
+        if (steps[mid].state_set_k < state_set_k) lo = mid + 1;
+        else hi = mid;
+    }
+
+    // Only the top of a chain is an explicit completion in the state set, the tree
+    // builder reaches the rest of the chain through the top. Thus a chain is not
+    // expanded unless the tree builder needs it.
+    bool expanded = false;
+    for (int i = lo; i < ps->num_leo_steps && steps[i].state_set_k == state_set_k; i++)
+    {
+        YaepLeoItem *bottom = steps[i].bottom;
+        if (steps[i].expanded_p || bottom->top_dotted_rule != dotted_rule || bottom->top_from_i != from_i) continue;
+
+        steps[i].expanded_p = true;
+        expanded = true;
+        for (YaepLeoItem *item = bottom; item->next != NULL; item = item->next)
+        {
+            if (!leo_children_add(ps, state_set_k, item->next, item)) break;
+        }
+    }
+    return expanded;
+}
+
+static YaepLeoChildren *leo_children_lookup(YaepParseState *ps, int state_set_k, YaepDottedRule *dotted_rule, int from_i)
+{
+    YaepLeoChildren key;
+    key.state_set_k = state_set_k;
+    key.dotted_rule = dotted_rule;
+    key.from_i = from_i;
+
+    return *(YaepLeoChildren**)find_hash_table_entry(ps->map_leo_children, &key, false);
+}
+
+/* Return the first implied completion that is a child of the completed DOTTED_RULE
+   with origin FROM_I in the state set at STATE_SET_K, or NULL if there is none. */
+static YaepLeoChild *leo_children_find(YaepParseState *ps, int state_set_k, YaepDottedRule *dotted_rule, int from_i)
+{
+    if (ps->num_leo_steps == 0) return NULL;
+
+    YaepLeoChildren *children = leo_children_lookup(ps, state_set_k, dotted_rule, from_i);
+    if (children == NULL && leo_expand_steps(ps, state_set_k, dotted_rule, from_i))
+    {
+        children = leo_children_lookup(ps, state_set_k, dotted_rule, from_i);
+    }
+    return children != NULL ? children->first : NULL;
+}
+
 /* The following function places translation NODE into *PLACE and
    creates alternative nodes if it is necessary. */
 static void place_translation(YaepParseState *ps, YaepTreeNode **place, YaepTreeNode *node)
@@ -153,7 +312,7 @@ static void place_translation(YaepParseState *ps, YaepTreeNode **place, YaepTree
 
     ps->n_parse_alt_nodes++;
 
-    alt =(YaepTreeNode*)(*ps->run.parse_alloc)(sizeof(YaepTreeNode));
+    alt =(YaepTreeNode*)tree_alloc(ps, sizeof(YaepTreeNode));
     alt->type = YAEP_ALT;
     alt->val.alt.node = node;
     if ((*place)->type == YAEP_ALT)
@@ -167,7 +326,7 @@ static void place_translation(YaepParseState *ps, YaepTreeNode **place, YaepTree
         ps->n_parse_alt_nodes++;
         next_alt = alt->val.alt.next
             =((YaepTreeNode*)
-              (*ps->run.parse_alloc)(sizeof(YaepTreeNode)));
+              tree_alloc(ps, sizeof(YaepTreeNode)));
         next_alt->type = YAEP_ALT;
         next_alt->val.alt.node =*place;
         next_alt->val.alt.next = NULL;
@@ -184,7 +343,7 @@ static YaepTreeNode *copy_anode(YaepParseState *ps,
     YaepTreeNode*node;
     int i;
 
-    node = ((YaepTreeNode*)(*ps->run.parse_alloc)(sizeof(YaepTreeNode)
+    node = ((YaepTreeNode*)tree_alloc(ps, sizeof(YaepTreeNode)
                                               + sizeof(YaepTreeNode*)
                                               *(rule->trans_len + 1)));
    *node =*anode;
@@ -351,9 +510,14 @@ static void loop_stack(YaepTreeNode **result,
                 {
                     // Allocate terminal node.
                     ps->n_parse_term_nodes++;
-                    node = ((YaepTreeNode*) (*ps->run.parse_alloc)(sizeof(YaepTreeNode)));
+                    node = ((YaepTreeNode*) tree_alloc(ps, sizeof(YaepTreeNode)));
                     node->type = YAEP_TERM;
                     node->val.terminal.code = symb->u.terminal.code;
+                    if (symb->u.terminal.is_class)
+                    {
+                        // A class terminal matched the actual input terminal.
+                        node->val.terminal.code = ps->input[state_set_k].symb->u.terminal.code;
+                    }
                     if (rule->marks && rule->marks[pos_j])
                     {
                         // Copy the ixml mark from the rhs position on to the terminal.
@@ -388,86 +552,102 @@ static void loop_stack(YaepTreeNode **result,
         YaepStateSetCore *set_core = set->core;
         YaepCoreSymbToPredComps *core_symb_to_predcomps = core_symb_to_predcomps_find(ps, set_core, symb);
         //debug("ixml.pa.c=", "core core%d symb %s -> %p", set_core->id, symb->hr, core_symb_to_predcomps);
-        if (!core_symb_to_predcomps)
+        int num_completions = core_symb_to_predcomps ? core_symb_to_predcomps->completions.len : 0;
+        // The completions of the last symbol can also be implied by Leo chains.
+        YaepLeoChild *leo_child = NULL;
+        if (pos_j == rule->rhs_len - 1)
+        {
+            leo_child = leo_children_find(ps, state_set_k, state->dotted_rule, from_i);
+        }
+        if (num_completions == 0 && leo_child == NULL)
             continue;
 
-        assert(core_symb_to_predcomps->completions.len != 0);
         n_candidates = 0;
         YaepParseTreeBuildState *orig_state = state;
         if (!ps->run.grammar->one_parse_p)
         {
             VLO_NULLIFY(orig_states);
         }
-        for (int i = 0; i < core_symb_to_predcomps->completions.len; i++)
+        for (int i = 0; i < num_completions || leo_child != NULL; i++)
         {
-            int rule_index_in_core = core_symb_to_predcomps->completions.ids[i];
-            dotted_rule = set_core->dotted_rules[rule_index_in_core];
             int dotted_rule_from_i;
-            if (rule_index_in_core < set_core->num_started_dotted_rules)
+            if (i < num_completions)
             {
-                // The state_set_k is the tok_i for which the state set was created.
-                // Ie, it is the to_i inside the Earley item.
-                // Now subtract the matched length from this to_i to get the from_i
-                // which is the origin.
-                dotted_rule_from_i = state_set_k - set->matched_lengths[rule_index_in_core];
-            } else
-            if (rule_index_in_core < set_core->num_all_matched_lengths)
-            {
-                // Parent??
-                dotted_rule_from_i = state_set_k - set->matched_lengths[set_core->to_parent_rule_index[rule_index_in_core]];
-            } else
-            {
-                dotted_rule_from_i = state_set_k;
-            }
+                int rule_index_in_core = core_symb_to_predcomps->completions.ids[i];
+                dotted_rule = set_core->dotted_rules[rule_index_in_core];
+                if (rule_index_in_core < set_core->num_started_dotted_rules)
+                {
+                    // The state_set_k is the tok_i for which the state set was created.
+                    // Ie, it is the to_i inside the Earley item.
+                    // Now subtract the matched length from this to_i to get the from_i
+                    // which is the origin.
+                    dotted_rule_from_i = state_set_k - set->matched_lengths[rule_index_in_core];
+                } else
+                if (rule_index_in_core < set_core->num_all_matched_lengths)
+                {
+                    // Parent??
+                    dotted_rule_from_i = state_set_k - set->matched_lengths[set_core->to_parent_rule_index[rule_index_in_core]];
+                } else
+                {
+                    dotted_rule_from_i = state_set_k;
+                }
 
-            YaepStateSet *check_set = ps->state_sets[dotted_rule_from_i];
-            YaepStateSetCore *check_set_core = check_set->core;
-            YaepCoreSymbToPredComps *check_core_symb_to_predcomps = core_symb_to_predcomps_find(ps, check_set_core, symb);
-            assert(check_core_symb_to_predcomps != NULL);
-            bool found = false;
-            if (ps->run.debug)
-            {
-                MemBuffer *mb = new_membuffer();
-                membuffer_printf(mb, "trying (s%d,d%d) [%d-%d]  cspc%d check_cspc%d  ",
-                                 state_set_k,
-                                 dotted_rule->id,
-                                 dotted_rule_from_i,
-                                 state_set_k,
-                                 core_symb_to_predcomps->id,
-                                 check_core_symb_to_predcomps->id);
-                print_rule(mb, ps, dotted_rule->rule);
-                debug_mb("ixml.bt.info=", mb);
-                free_membuffer_and_free_content(mb);
-            }
-            for (int j = 0; j < check_core_symb_to_predcomps->predictions.len; j++)
-            {
-                int rule_index_in_check_core = check_core_symb_to_predcomps->predictions.ids[j];
-                YaepDottedRule *check_dotted_rule = check_set->core->dotted_rules[rule_index_in_check_core];
-                if (check_dotted_rule->rule != rule || check_dotted_rule->dot_j != pos_j)
+                YaepStateSet *check_set = ps->state_sets[dotted_rule_from_i];
+                YaepStateSetCore *check_set_core = check_set->core;
+                YaepCoreSymbToPredComps *check_core_symb_to_predcomps = core_symb_to_predcomps_find(ps, check_set_core, symb);
+                assert(check_core_symb_to_predcomps != NULL);
+                bool found = false;
+                if (ps->run.debug)
                 {
-                    continue;
+                    MemBuffer *mb = new_membuffer();
+                    membuffer_printf(mb, "trying (s%d,d%d) [%d-%d]  cspc%d check_cspc%d  ",
+                                     state_set_k,
+                                     dotted_rule->id,
+                                     dotted_rule_from_i,
+                                     state_set_k,
+                                     core_symb_to_predcomps->id,
+                                     check_core_symb_to_predcomps->id);
+                    print_rule(mb, ps, dotted_rule->rule);
+                    debug_mb("ixml.bt.info=", mb);
+                    free_membuffer_and_free_content(mb);
                 }
-                int check_dotted_rule_from_i = dotted_rule_from_i;
-                if (rule_index_in_check_core < check_set_core->num_all_matched_lengths)
+                for (int j = 0; j < check_core_symb_to_predcomps->predictions.len; j++)
                 {
-                    if (rule_index_in_check_core < check_set_core->num_started_dotted_rules)
+                    int rule_index_in_check_core = check_core_symb_to_predcomps->predictions.ids[j];
+                    YaepDottedRule *check_dotted_rule = check_set->core->dotted_rules[rule_index_in_check_core];
+                    if (check_dotted_rule->rule != rule || check_dotted_rule->dot_j != pos_j)
                     {
-                        check_dotted_rule_from_i = dotted_rule_from_i - check_set->matched_lengths[rule_index_in_check_core];
-                    } else
+                        continue;
+                    }
+                    int check_dotted_rule_from_i = dotted_rule_from_i;
+                    if (rule_index_in_check_core < check_set_core->num_all_matched_lengths)
+                    {
+                        if (rule_index_in_check_core < check_set_core->num_started_dotted_rules)
+                        {
+                            check_dotted_rule_from_i = dotted_rule_from_i - check_set->matched_lengths[rule_index_in_check_core];
+                        } else
+                        {
+                            check_dotted_rule_from_i = (dotted_rule_from_i
+                                            - check_set->matched_lengths[check_set_core->to_parent_rule_index[rule_index_in_check_core]]);
+                        }
+                    }
+                    if (check_dotted_rule_from_i == from_i)
                     {
-                        check_dotted_rule_from_i = (dotted_rule_from_i
-                                        - check_set->matched_lengths[check_set_core->to_parent_rule_index[rule_index_in_check_core]]);
+                        found = true;
+                        break;
                     }
                 }
-                if (check_dotted_rule_from_i == from_i)
+                if (!found)
                 {
-                    found = true;
-                    break;
+                    continue;
                 }
             }
-            if (!found)
+            else
             {
-                continue;
+                // A completion implied by a Leo chain, its parent is always the current state.
+                dotted_rule = leo_child->item->dotted_rule;
+                dotted_rule_from_i = leo_child->item->from_i;
+                leo_child = leo_child->next;
             }
             if (n_candidates != 0)
             {
@@ -567,7 +747,7 @@ static void loop_stack(YaepTreeNode **result,
                     {
                         /* Allocate abtract node. */
                         ps->n_parse_abstract_nodes++;
-                        node = ((YaepTreeNode*) (*ps->run.parse_alloc)(sizeof(YaepTreeNode) + sizeof(YaepTreeNode*) * (dotted_rule_rule->trans_len + 1)));
+                        node = ((YaepTreeNode*) tree_alloc(ps, sizeof(YaepTreeNode) + sizeof(YaepTreeNode*) * (dotted_rule_rule->trans_len + 1)));
                         node->type = YAEP_ANODE;
                         state->anode = node;
                         if (table_state != NULL)
@@ -576,7 +756,7 @@ static void loop_stack(YaepTreeNode **result,
                         }
                         if (dotted_rule_rule->caller_anode == NULL)
                         {
-                            dotted_rule_rule->caller_anode = ((char*) (*ps->run.parse_alloc)(strlen(dotted_rule_rule->anode) + 1));
+                            dotted_rule_rule->caller_anode = ((char*) tree_alloc(ps, strlen(dotted_rule_rule->anode) + 1));
                             strcpy(dotted_rule_rule->caller_anode, dotted_rule_rule->anode);
                         }
                         node->val.anode.name = dotted_rule_rule->caller_anode;
@@ -866,7 +1046,8 @@ static YaepTreeNode *find_minimal_translation(YaepParseState *ps, YaepTreeNode *
             }
         }
         VLO_DELETE(ps->tnodes_vlo);
-        delete_hash_table(ps->set_of_reserved_memory);
+        delete_parse_hash_table(ps, ps->set_of_reserved_memory);
+        ps->set_of_reserved_memory = NULL;
     }
 
     return root;
@@ -913,11 +1094,11 @@ YaepTreeNode *build_parse_tree(YaepParseState *ps, bool *ambiguous_p)
     result = NULL;
 
     /* Create empty and error node:*/
-    YaepTreeNode *empty_node = ((YaepTreeNode*)(*ps->run.parse_alloc)(sizeof(YaepTreeNode)));
+    YaepTreeNode *empty_node = ((YaepTreeNode*)tree_alloc(ps, sizeof(YaepTreeNode)));
     empty_node->type = YAEP_NIL;
     empty_node->val.nil.used = 0;
 
-    YaepTreeNode *error_node = ((YaepTreeNode*)(*ps->run.parse_alloc)(sizeof(YaepTreeNode)));
+    YaepTreeNode *error_node = ((YaepTreeNode*)tree_alloc(ps, sizeof(YaepTreeNode)));
     error_node->type = YAEP_ERROR;
     error_node->val.error.used = 0;
 
@@ -118,6 +118,22 @@ int find_matched_length(YaepParseState *ps,
     return matched_length;
 }
 
+void delete_parse_hash_table(YaepParseState *ps, hash_table_t htab)
+{
+    // The counters are summed per parse run, no counters are shared between runs.
+    ps->table_searches += get_searches(htab);
+    ps->table_collisions += get_collisions(htab);
+    delete_hash_table(htab);
+}
+
+void count_parse_hash_table(YaepParseState *ps, hash_table_t htab)
+{
+    ps->table_searches += get_searches(htab);
+    ps->table_collisions += get_collisions(htab);
+    htab->searches = 0;
+    htab->collisions = 0;
+}
+
 void yaep_debug(YaepParseState *ps, const char *format, ...)
 {
     if (!ps->run.debug) return;
@@ -43,6 +43,11 @@ void dbg_print_dotted_rule(YaepParseState *ps, YaepDottedRule *dotted_rule);
 void fetch_state_vars(YaepParseState *ps, YaepStateSet *state_set, StateVars *out);
 int find_matched_length(YaepParseState *ps, YaepStateSet *state_set, StateVars *vars, int dotted_rule_id);
 
+// Delete a hash table owned by the parse state, adding its counters to the parse statistics.
+void delete_parse_hash_table(YaepParseState *ps, hash_table_t htab);
+// Add the counters of a hash table kept for the next parse to the parse statistics.
+void count_parse_hash_table(YaepParseState *ps, hash_table_t htab);
+
 void yaep_view(YaepParseState *ps, const char *format, ...);
 void yaep_debug(YaepParseState *ps, const char *format, ...);
 void yaep_trace(YaepParseState *ps, const char *format, ...);
@@ -41,6 +41,7 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include"xmq.h"
 #include"parts/xmq_internals.h"
 #include"parts/text.h"
+#include"parts/json.h"
 #include"parts/membuffer.h"
 #include"parts/xmq_printer.h"
 
@@ -53,6 +54,8 @@ void test_sl(const char *s, size_t expected_b_len, size_t expected_u_len);
 void test_trim_comment(int start_col, const char *in, const char *expected);
 void test_trim_quote(const char *in, const char *expected);
 void test_quote(int indent, bool compact, char *in, char *expected);
+void test_json_quote_scan(const char *s, size_t expected_offset, size_t expected_col);
+bool test_transcode(const char *xml, char **out);
 
 #define TESTS \
     X(test_indented_quotes) \
@@ -69,6 +72,11 @@ void test_quote(int indent, bool compact, char *in, char *expected);
     X(test_yaep) \
     X(test_yaep_reuse_grammar) \
     X(test_annotate_offsets) \
+    X(test_compiled_themes) \
+    X(test_json_quote_scanning) \
+    X(test_transcode_custom_writer) \
+    X(test_ixml_parse_stats) \
+    X(test_json_literals) \
 
 #define X(name) void name();
     TESTS
@@ -290,6 +298,7 @@ void test_quote(int indent, bool compact, char *in, char *expected)
 
     size_t size = membuffer_used(os->output_buffer);
     char *out = free_membuffer_but_return_trimmed_content(os->output_buffer);
+    os->output_buffer = NULL;
     out = realloc(out, size+1);
     out[size] = 0;
 
@@ -407,6 +416,8 @@ void test_quoting()
 
     test_quote(0, false, "alfa\nbeta", "test = 'alfa\n        beta'");
     test_quote(1, false, "alfa\nbeta", "test = 'alfa\n         beta'");
+    test_quote(0, false, "\xc3\xa5lfa b\xc3\xa9" "ta\ngamma", "test = '\xc3\xa5lfa b\xc3\xa9" "ta\n        gamma'");
+    test_quote(0, false, "alfa\xc2\xa0" "beta\tgamma", "test = 'alfa\xc2\xa0" "beta\tgamma'");
 
 //TODO     test_quote(4, false, " ''' ", "test = '''' ''' ''''");
 //TODO //    test_quote(4, " '''' ", "''''' '''' '''''");
@@ -789,6 +800,183 @@ void test_annotate_offsets()
     xmqFreeDoc(doc);
 }
 
+void test_compiled_themes()
+{
+    XMQOutputSettings *a = xmqNewOutputSettings();
+    XMQOutputSettings *b = xmqNewOutputSettings();
+    XMQOutputSettings *c = xmqNewOutputSettings();
+    xmqSetRenderFormat(a, XMQ_RENDER_HTML);
+    xmqSetRenderFormat(b, XMQ_RENDER_HTML);
+    xmqSetRenderFormat(c, XMQ_RENDER_HTML);
+    xmqRenderHtmlSettings(c, "alfa", NULL);
+    xmqSetupDefaultColors(a);
+    xmqSetupDefaultColors(b);
+    xmqSetupDefaultColors(c);
+
+    if (a->theme != b->theme || a->compiled_theme == NULL)
+    {
+        all_ok_ = false;
+        printf("Expected identical render settings to share the compiled theme.\n");
+    }
+    if (a->theme == c->theme || !strstr(c->theme->content.pre, "id=\"alfa\""))
+    {
+        all_ok_ = false;
+        printf("Expected a separate compiled theme for a different html id.\n");
+    }
+
+    xmqFreeOutputSettings(a);
+    xmqFreeOutputSettings(b);
+    xmqFreeOutputSettings(c);
+}
+
+void test_json_quote_scan(const char *s, size_t expected_offset, size_t expected_col)
+{
+    size_t col = 0;
+    const char *i = find_json_quote_special(s, s+strlen(s), &col);
+    if ((size_t)(i-s) != expected_offset || col != expected_col)
+    {
+        all_ok_ = false;
+        printf("Scanning json quote >%s< expected offset %zu col %zu but got %zu col %zu\n",
+               s, expected_offset, expected_col, (size_t)(i-s), col);
+    }
+}
+
+void test_json_quote_scanning()
+{
+    test_json_quote_scan("", 0, 0);
+    test_json_quote_scan("abc", 3, 3);
+    test_json_quote_scan("abc\"", 3, 3);
+    test_json_quote_scan("abcdefghijklmnopqrstuvwxyz\"", 26, 26);
+    test_json_quote_scan("abcdefghijklmnop\\n", 16, 16);
+    test_json_quote_scan("abcdefghijk\nlmnop", 11, 11);
+    test_json_quote_scan("abcdefgh\tijklmnop", 8, 8);
+    test_json_quote_scan("\x7f\x7f\x7f\x7f\x7f\x7f\x7f\x7f\x7f\x01", 9, 9);
+    test_json_quote_scan("\xc3\xa5\xc3\xa4\xc3\xb6\xe2\x82\xac abcdefgh\"", 18, 13);
+}
+
+void test_ixml_parse_stats()
+{
+    XMQReturnDoc rd = xmqNewDoc();
+    assert(rd.status == XMQ_OK);
+    XMQDoc *grammar = rd.doc;
+    bool ok = xmqParseBufferWithType(grammar, "a=n++-','.n=[N]+.", NULL, NULL, XMQ_CONTENT_IXML, 0);
+    assert(ok);
+
+    XMQIXMLParseStats stats;
+    if (xmqGetIXMLParseStats(grammar, &stats))
+    {
+        all_ok_ = false;
+        printf("ERROR: expected no ixml parse stats before parsing.\n");
+    }
+
+    rd = xmqNewDoc();
+    assert(rd.status == XMQ_OK);
+    XMQDoc *dom = rd.doc;
+    ok = xmqParseBufferWithIXML(dom, "123,9,455", NULL, grammar, 0);
+    assert(ok);
+
+    // Nine code points and the end of input, each code point is a terminal node in the tree.
+    if (!xmqGetIXMLParseStats(grammar, &stats) ||
+        stats.input_len != 10 ||
+        stats.num_state_sets == 0 ||
+        stats.num_term_nodes != 9 ||
+        stats.memusage == 0)
+    {
+        all_ok_ = false;
+        printf("ERROR: unexpected ixml parse stats input_len=%d sets=%d term_nodes=%d mem=%zu\n",
+               stats.input_len, stats.num_state_sets, stats.num_term_nodes, stats.memusage);
+    }
+
+    xmqFreeDoc(dom);
+    xmqFreeDoc(grammar);
+}
+
+void test_json_literals()
+{
+    XMQReturnDoc rd = xmqNewDoc();
+    assert(rd.status == XMQ_OK);
+    XMQDoc *doc = rd.doc;
+    bool ok = xmqParseBufferWithType(doc, "{\"a\":1,\"b\":\"1\"}", NULL, NULL, XMQ_CONTENT_JSON, 0);
+    assert(ok);
+
+    xmlNode *root = xmlDocGetRootElement(doc->docptr_.xml);
+    xmlNode *a = root->children;
+    xmlNode *b = a->next;
+
+    // The number is marked as a literal by storing its text inline in the node, the string is not.
+    if (!doc->json_literals_ ||
+        a->children->content != (xmlChar*)&a->children->properties ||
+        b->children->content == (xmlChar*)&b->children->properties)
+    {
+        all_ok_ = false;
+        printf("ERROR: expected only the json number text to be stored inline.\n");
+    }
+
+    // Changing the text drops the mark.
+    xmlNodeSetContent(a->children, (const xmlChar*)"x");
+    if (a->children->content == (xmlChar*)&a->children->properties)
+    {
+        all_ok_ = false;
+        printf("ERROR: expected the changed text to be moved out of the node.\n");
+    }
+
+    XMQOutputSettings *os = xmqNewOutputSettings();
+    xmqSetOutputFormat(os, XMQ_CONTENT_JSON);
+    xmqSetCompact(os, true);
+    char *start;
+    char *stop;
+    xmqSetupPrintMemory(os, &start, &stop);
+    xmqPrint(doc, os);
+    xmqFreeOutputSettings(os);
+    if (strcmp(start, "{\"a\":\"x\",\"b\":\"1\"}\n"))
+    {
+        all_ok_ = false;
+        printf("ERROR: edited json literals printed as >%s<\n", start);
+    }
+    free(start);
+    xmqFreeDoc(doc);
+}
+
+bool test_transcode(const char *xml, char **out)
+{
+    MemBuffer *mb = new_membuffer();
+    XMQWriter writer = { mb, (XMQWrite)(void*)membuffer_append_region };
+
+    XMQOutputSettings *os = xmqNewOutputSettings();
+    xmqSetOutputFormat(os, XMQ_CONTENT_XMQ);
+    xmqSetCompact(os, true);
+    xmqSetWriterContent(os, writer);
+    xmqSetupDefaultColors(os);
+    bool ok = xmqTranscodeBuffer(xml, NULL, XMQ_CONTENT_XML, 0, os);
+    xmqFreeOutputSettings(os);
+
+    membuffer_append_null(mb);
+    *out = free_membuffer_but_return_trimmed_content(mb);
+    return ok;
+}
+
+void test_transcode_custom_writer()
+{
+    char *out = NULL;
+    bool ok = test_transcode("<root><a>1</a><b>2</b></root>", &out);
+    if (!ok || strcmp(out, "root{a=1 b=2}\n"))
+    {
+        all_ok_ = false;
+        printf("ERROR: transcode to custom writer got >%s<\n", out);
+    }
+    free(out);
+
+    // The broken xml is only detected after a=1 has been converted,
+    // the custom writer must not have received anything.
+    ok = test_transcode("<root><a>1</a><b>", &out);
+    if (ok || *out)
+    {
+        all_ok_ = false;
+        printf("ERROR: failed transcode wrote >%s< to custom writer\n", out);
+    }
+    free(out);
+}
+
 int main(int argc, char **argv)
 {
 #define X(name) name();
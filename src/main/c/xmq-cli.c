@@ -32,6 +32,7 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include<assert.h>
 #include<ctype.h>
+#include<limits.h>
 #include<memory.h>
 #include<string.h>
 #include<stdio.h>
@@ -52,6 +53,7 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #else
 #include<signal.h>
 #include<sys/ioctl.h>
+#include<sys/mman.h>
 #include<termios.h>
 #endif
 
@@ -91,6 +93,7 @@ typedef enum
     XMQ_CLI_CMD_TO_HTMQ,
     XMQ_CLI_CMD_TO_HTML,
     XMQ_CLI_CMD_TO_JSON,
+    XMQ_CLI_CMD_TO_JSONL,
     XMQ_CLI_CMD_TO_TEXT,
     XMQ_CLI_CMD_TO_CLINES,
     XMQ_CLI_CMD_NO_OUTPUT,
@@ -167,6 +170,9 @@ struct XMQCliCommand
     const char *save_file; // Save output to this file name.
     xmlDocPtr   ixml_doc;  // A DOM containing the ixml grammar.
     const char *ixml_source; // IXML grammar source to be used.
+    const char *ixml_source_stop; // A compiled grammar is binary, this points to the byte after it.
+    bool ixml_source_mapped; // The compiled grammar is memory mapped from the file.
+    const char *compile_ixml_to; // Store the compiled ixml grammar in this file and exit.
     const char *ixml_engine; // If NULL use the internal, otherwise invoke this external program like this:
                              // engine source.ixml input.txt > /tmp/tmpfile
                              // then load the Document from tmpfile and continue as before.
@@ -226,10 +232,17 @@ struct XMQCliCommand
     bool escape_newlines;
     bool escape_non_7bit;
     bool escape_tabs;
+    int  print_threads; // Render large runs of siblings using this many threads.
     const char *implicit_root;
 
     // If true then chip away one line at a time from the content.
     bool lines;
+    // If true then the input is json lines, parsed one record at a time by the json lines reader.
+    bool jsonl;
+    XMQJsonLines *json_lines_reader;
+    bool json_lines_done;
+    // If true then print json lines, one compact record per line.
+    bool json_lines;
     // The content to be parsed one line at a time.
     const char *input_content_start;
     // The byte after the last input content byte.
@@ -259,6 +272,7 @@ struct XMQCliEnvironment
     char *out_start; // Points to generated output: xml/xmq/htmq/html/json/text
     char *out_stop; // Points to byte after output, or NULL which means start is NULL terminated.
     size_t out_skip; // Skip some leading part of the generated output. Used to skip the <?xml ..?>
+    bool transcoded; // The output was generated directly from the input without a document, skip the to command.
 };
 
 typedef enum {
@@ -329,9 +343,16 @@ bool cmd_for_each(XMQCliCommand *command);
 XMQCliCmd cmd_from(const char *s);
 XMQCliCmdGroup cmd_group(XMQCliCmd cmd);
 bool cmd_help(XMQCliCommand *c);
+bool compile_ixml_grammar(XMQCliCommand *command);
+void load_ixml_grammar_file(XMQCliCommand *command, const char *file);
+void unload_ixml_grammar_file(XMQCliCommand *command);
+void prepare_ixml_grammar(XMQCliCommand *command);
 void load_using_internal_ixml_engine(XMQCliCommand *command, const char *from);
 void load_using_external_ixml_engine(XMQCliCommand *command, const char *engine, const char *from);
 bool cmd_load(XMQCliCommand *command, bool *no_more_data);
+bool cmd_load_json_lines(XMQCliCommand *command, bool *no_more_data);
+bool cmd_load_transcode(XMQCliCommand *command);
+XMQOutputSettings *new_to_settings(XMQCliCommand *command);
 const char *cmd_name(XMQCliCmd cmd);
 bool cmd_output(XMQCliCommand *command);
 bool cmd_quote_unquote(XMQCliCommand *command);
@@ -381,6 +402,7 @@ void invoke_cmd(const char *cmd);
 const char *is_ixml_cmd(const char *arg);
 const char *is_xsl_cmd(const char *arg);
 char *load_file_into_buffer(const char *file);
+char *map_file_into_memory(const char *file, size_t *size);
 bool load_xslt(XMQCliCommand *command, const char *arg);
 char *make_shell_safe_name(char *name, char *name_start);
 int mkpath(char* file_path, mode_t mode);
@@ -520,6 +542,7 @@ XMQCliCmd cmd_from(const char *s)
     if (!strcmp(s, "to-html")) return XMQ_CLI_CMD_TO_HTML;
     if (!strcmp(s, "to-htmq")) return XMQ_CLI_CMD_TO_HTMQ;
     if (!strcmp(s, "to-json")) return XMQ_CLI_CMD_TO_JSON;
+    if (!strcmp(s, "to-jsonl")) return XMQ_CLI_CMD_TO_JSONL;
     if (!strcmp(s, "to-text")) return XMQ_CLI_CMD_TO_TEXT;
     if (!strcmp(s, "to-xml")) return XMQ_CLI_CMD_TO_XML;
     if (!strcmp(s, "to-xmq")) return XMQ_CLI_CMD_TO_XMQ;
@@ -545,6 +568,7 @@ const char *cmd_name(XMQCliCmd cmd)
     case XMQ_CLI_CMD_TO_HTMQ: return "to-htmq";
     case XMQ_CLI_CMD_TO_HTML: return "to-html";
     case XMQ_CLI_CMD_TO_JSON: return "to-json";
+    case XMQ_CLI_CMD_TO_JSONL: return "to-jsonl";
     case XMQ_CLI_CMD_TO_TEXT: return "to-text";
     case XMQ_CLI_CMD_TO_CLINES: return "to-clines";
     case XMQ_CLI_CMD_NO_OUTPUT: return "no-output";
@@ -588,6 +612,7 @@ XMQCliCmdGroup cmd_group(XMQCliCmd cmd)
     case XMQ_CLI_CMD_TO_HTMQ:
     case XMQ_CLI_CMD_TO_HTML:
     case XMQ_CLI_CMD_TO_JSON:
+    case XMQ_CLI_CMD_TO_JSONL:
     case XMQ_CLI_CMD_TO_TEXT:
     case XMQ_CLI_CMD_TO_CLINES:
         return XMQ_CLI_CMD_GROUP_TO;
@@ -837,6 +862,19 @@ bool handle_option(const char *arg, const char *arg_next, XMQCliCommand *command
             command->compact = true;
             return true;
         }
+        if (!strncmp(arg, "--threads=", 10))
+        {
+            const char *value = arg+10;
+            char *end = NULL;
+            long n = isdigit(*value) ? strtol(value, &end, 10) : 0;
+            if (n < 1 || n > INT_MAX || *end != 0)
+            {
+                fprintf(stderr, "xmq: threads must be a positive integer, got \"%s\"\n", value);
+                exit(1);
+            }
+            command->print_threads = (int)n;
+            return true;
+        }
     }
 
     if (command->cmd == XMQ_CLI_CMD_TO_XML)
@@ -1800,6 +1838,17 @@ bool handle_global_option(const char *arg, XMQCliCommand *command)
         command->in_format=XMQ_CONTENT_JSON;
         return true;
     }
+    if (!strcmp(arg, "--jsonl"))
+    {
+        command->in_format=XMQ_CONTENT_JSON;
+        command->jsonl = true;
+        return true;
+    }
+    if (!strcmp(arg, "--json-index"))
+    {
+        command->flags |= XMQ_FLAG_JSON_INDEX;
+        return true;
+    }
     if (!strcmp(arg, "--clines"))
     {
         command->in_format=XMQ_CONTENT_CLINES;
@@ -1830,6 +1879,11 @@ bool handle_global_option(const char *arg, XMQCliCommand *command)
         command->ixml_fail_silent = true;
         return true;
     }
+    if (!strncmp(arg, "--compile-ixml=", 15))
+    {
+        command->compile_ixml_to = arg+15;
+        return true;
+    }
     if (!strcmp(arg, "--log-xmq") || !strcmp(arg, "-lx"))
     {
         log_xmq__ = true;
@@ -1920,19 +1974,16 @@ bool handle_global_option(const char *arg, XMQCliCommand *command)
         size_t len = strlen(file);
         if (len < 6 ||
             (strcmp(file+len-5, ".ixml") &&
+             strcmp(file+len-6, ".ixmlc") &&
              strcmp(file+len-4, ".xml") &&
              strcmp(file+len-4, ".xmq")))
         {
-            printf("For ixml you can specify: g.ixml g.xml g.xmq\n");
+            printf("For ixml you can specify: g.ixml g.ixmlc g.xml g.xmq\n");
             exit(1);
         }
-        if (!strcmp(file+len-5, ".ixml"))
+        if (!strcmp(file+len-5, ".ixml") || !strcmp(file+len-6, ".ixmlc"))
         {
-            verbose_("xmq=", "reading ixml file %s", file);
-            command->ixml_filename = strdup(file);
-            command->ixml_source = load_file_into_buffer(file);
-            if (command->ixml_source == NULL) exit(1);
-
+            load_ixml_grammar_file(command, file);
             return true;
         }
 
@@ -1964,6 +2015,9 @@ bool cmd_help(XMQCliCommand *cmd)
            "  --help     Display this help and exit.\n"
            "  --license  Print license.\n"
            "  --lines    Assume each input line is a separate document.\n"
+           "  --jsonl    The input is json lines (ndjson), each line is a separate json document.\n"
+           "  --json-index\n"
+           "             Index the json structure before parsing. Can be faster for json with long strings and deep indentation.\n"
            "  --nomerge  When loading xmq do not merge text quotes and character entities.\n"
            "  --root=<name>\n"
            "             Create a root node <name> unless the file starts with a node with this <name> already.\n"
@@ -1976,6 +2030,10 @@ bool cmd_help(XMQCliCommand *cmd)
            "  --xmq|--htmq|--xml|--html|--ixml|--json|--clines\n"
            "             The input format is auto detected for xmq/xml/json but you can force the input format here.\n"
            "  --ixml=grammar.ixml Parse the content using the supplied grammar file.\n"
+           "             A grammar compiled with --compile-ixml can be used as well: --ixml=grammar.ixmlc\n"
+           "  --compile-ixml=grammar.ixmlc\n"
+           "             Store the ixml grammar in a compiled binary format and exit. Loading the compiled\n"
+           "             grammar skips parsing the ixml source.\n"
            "  -z         Do not read from stdin nor from a file. Start with an empty dom.\n"
            "  -i \"a=2\" Do not read from a file, use the next argument as the content to parse.\n"
            "\n"
@@ -1994,7 +2052,7 @@ bool cmd_help(XMQCliCommand *cmd)
            "  select\n"
            "  statistics\n"
            "  substitite-char-entities substitute-entity\n"
-           "  to-html to-htmq to-json to-lines to-text to-xml to-xmq\n"
+           "  to-html to-htmq to-json to-jsonl to-lines to-text to-xml to-xmq\n"
            "  tokenize\n"
            "  transform\n"
            "  validate\n\n"
@@ -2119,24 +2177,64 @@ bool cmd_tokenize(XMQCliCommand *command)
     return err == 0;
 }
 
-void load_using_internal_ixml_engine(XMQCliCommand *command, const char *from)
+void prepare_ixml_grammar(XMQCliCommand *command)
 {
-    if (command->ixml_grammar == NULL)
+    if (command->ixml_grammar != NULL) return;
+
+    XMQReturnDoc rd = xmqNewDoc();
+    assert(rd.status == XMQ_OK);
+    command->ixml_grammar = rd.doc;
+    xmqSetDocSourceName(command->ixml_grammar, command->ixml_filename);
+
+    bool ok = xmqParseBufferWithType(command->ixml_grammar,
+                                     command->ixml_source,
+                                     command->ixml_source_stop,
+                                     NULL,
+                                     XMQ_CONTENT_IXML,
+                                     0);
+    verbose_("xmq=", "parse ixml grammar %zu bytes from %s",
+             (size_t)(command->ixml_source_stop-command->ixml_source), command->ixml_filename);
+
+    if (!ok)
     {
-        XMQReturnDoc rd = xmqNewDoc();
-        assert(rd.status == XMQ_OK);
-        command->ixml_grammar = rd.doc;
-        xmqSetDocSourceName(command->ixml_grammar, command->ixml_filename);
+        fprintf(stderr, "%s\n", xmqDocError(command->ixml_grammar));
+        exit(1);
+    }
+}
 
-        bool ok = xmqParseBufferWithType(command->ixml_grammar, command->ixml_source, NULL, NULL, XMQ_CONTENT_IXML, 0);
-        verbose_("xmq=", "parse ixml grammar %zu bytes from %s", strlen(command->ixml_source), command->ixml_filename);
+bool compile_ixml_grammar(XMQCliCommand *command)
+{
+    if (!command->ixml_source)
+    {
+        fprintf(stderr, "xmq: --compile-ixml needs an ixml grammar, eg --ixml=grammar.ixml\n");
+        return false;
+    }
 
-        if (!ok)
-        {
-            fprintf(stderr, "%s\n", xmqDocError(command->ixml_grammar));
-            exit(1);
-        }
+    prepare_ixml_grammar(command);
+
+    char *start = NULL;
+    char *stop = NULL;
+    if (!xmqSerializeIXMLGrammar(command->ixml_grammar, &start, &stop)) return false;
+
+    FILE *f = fopen(command->compile_ixml_to, "wb");
+    if (!f)
+    {
+        fprintf(stderr, "xmq: could not write %s\n", command->compile_ixml_to);
+        free(start);
+        return false;
     }
+    size_t n = fwrite(start, 1, stop-start, f);
+    fclose(f);
+    free(start);
+
+    verbose_("xmq=", "wrote compiled ixml grammar %zu bytes to %s", n, command->compile_ixml_to);
+
+    return n == (size_t)(stop-start);
+}
+
+void load_using_internal_ixml_engine(XMQCliCommand *command, const char *from)
+{
+    prepare_ixml_grammar(command);
 
     int flags = 0;
     if (command->ixml_all_parses) flags |= XMQ_FLAG_IXML_ALL_PARSES;
@@ -2151,6 +2249,12 @@ void load_using_internal_ixml_engine(XMQCliCommand *command, const char *from)
 
     if (!ok)
     {
+        if (xmqDocError(command->env->doc))
+        {
+            // The yaep grammar could not be generated, there is nothing to print.
+            fprintf(stderr, "%s", xmqDocError(command->env->doc));
+            exit(1);
+        }
         verbose_("xmq=", "cmd-load-ixml parse failed", from);
     }
     else
@@ -2213,6 +2317,104 @@ void load_using_external_ixml_engine(XMQCliCommand *command, const char *engine,
     unlink(tmp_out);
 }
 
+bool cmd_load_json_lines(XMQCliCommand *command, bool *no_more_data)
+{
+    const char *from = "stdin";
+
+    if (!command->json_lines_reader)
+    {
+        const char *start, *stop;
+        if (command->in_is_content)
+        {
+            from = "-i argument";
+            start = command->in;
+            stop = command->in+strlen(command->in);
+        }
+        else
+        {
+            if (command->in) from = command->in;
+            XMQReturnDoc rd = xmqNewDoc();
+            assert(rd.status == XMQ_OK);
+            XMQDoc *tmp = rd.doc;
+            size_t len = 0;
+            verbose_("xmq=", "cmd-load json lines from %s", from);
+            bool ok = load_file(tmp, command->in, &len, &command->input_content_start);
+            command->input_content_stop = command->input_content_start+len;
+
+            if (!ok)
+            {
+                printf("%s\n", tmp->error_);
+                exit(1);
+            }
+            xmqFreeDoc(tmp);
+            start = command->input_content_start;
+            stop = command->input_content_stop;
+        }
+        command->json_lines_reader = xmqNewJsonLines(start, stop, command->implicit_root);
+    }
+
+    command->env->load = command;
+
+    if (!xmqNextJsonLine(command->json_lines_reader, command->env->doc))
+    {
+        const char *error = xmqDocError(command->env->doc);
+        if (error)
+        {
+            fprintf(stderr, error, command->in);
+            xmqFreeDoc(command->env->doc);
+            command->env->doc = NULL;
+            return false;
+        }
+        command->json_lines_done = true;
+        *no_more_data = true;
+        return false;
+    }
+    verbose_("xmq=", "cmd-load json line %zu bytes", xmqGetOriginalSize(command->env->doc));
+
+    return true;
+}
+
+/**
+    cmd_load_transcode:
+    @command: The load command.
+
+    If the loaded content is only converted and printed, then try to convert it
+    directly into the output without building the document.
+*/
+bool cmd_load_transcode(XMQCliCommand *command)
+{
+    XMQCliCommand *to = command->next;
+
+    if (!to || to->cmd != XMQ_CLI_CMD_TO_XMQ) return false;
+    for (XMQCliCommand *c = to->next; c; c = c->next)
+    {
+        if (cmd_group(c->cmd) != XMQ_CLI_CMD_GROUP_OUTPUT) return false;
+    }
+    if (command->lines || command->ixml_source) return false;
+    if (command->implicit_root && command->implicit_root[0]) return false;
+    if (command->in_format != XMQ_CONTENT_JSON &&
+        command->in_format != XMQ_CONTENT_XML &&
+        command->in_format != XMQ_CONTENT_DETECT) return false;
+
+    XMQOutputSettings *settings = new_to_settings(to);
+    xmqSetupPrintMemory(settings, &command->env->out_start, &command->env->out_stop);
+    xmqSetupPrintSkip(settings, &command->env->out_skip);
+
+    bool ok = xmqTranscodeBuffer(command->input_current_line_start,
+                                 command->input_current_line_stop,
+                                 command->in_format,
+                                 command->flags,
+                                 settings);
+    xmqFreeOutputSettings(settings);
+
+    if (ok)
+    {
+        verbose_("xmq=", "cmd-load transcoded %zu bytes", xmqGetOriginalSize(command->env->doc));
+        command->env->transcoded = true;
+    }
+    return ok;
+}
+
 bool cmd_load(XMQCliCommand *command, bool *no_more_data)
 {
     if (!command) return false;
@@ -2235,6 +2437,8 @@ bool cmd_load(XMQCliCommand *command, bool *no_more_data)
         command->in = NULL;
     }
 
+    if (command->jsonl) return cmd_load_json_lines(command, no_more_data);
+
     const char *from = "stdin";
 
     if (command->in_is_content)
@@ -2307,7 +2511,7 @@ bool cmd_load(XMQCliCommand *command, bool *no_more_data)
             load_using_internal_ixml_engine(command, from);
         }
     }
-    else
+    else if (!cmd_load_transcode(command))
     {
         bool ok = xmqParseBufferWithType(command->env->doc,
                                          command->input_current_line_start,
@@ -2340,9 +2544,14 @@ bool cmd_unload(XMQCliCommand *command)
         xmqFreeDoc(command->env->doc);
         command->env->doc = NULL;
 
-        if (command->input_current_line_start >= command->input_content_stop)
+        if (command->json_lines_reader && !command->json_lines_done) return true;
+
+        if (command->json_lines_done ||
+            command->input_current_line_start >= command->input_content_stop)
         {
             // Handled all input.
+            xmqFreeJsonLines(command->json_lines_reader);
+            command->json_lines_reader = NULL;
             if (command->ixml_grammar)
             {
                 xmqFreeDoc(command->ixml_grammar);
@@ -2355,10 +2564,7 @@ bool cmd_unload(XMQCliCommand *command)
             command->input_current_line_start = NULL;
             command->input_current_line_stop = NULL;
 
-            free((char*)command->ixml_filename);
-            command->ixml_filename = NULL;
-            free((char*)command->ixml_source);
-            command->ixml_source = NULL;
+            unload_ixml_grammar_file(command);
             return false;
         }
         return true;
@@ -2366,14 +2572,20 @@ bool cmd_unload(XMQCliCommand *command)
     return false;
 }
 
-bool cmd_to(XMQCliCommand *command)
+XMQOutputSettings *new_to_settings(XMQCliCommand *command)
 {
     XMQOutputSettings *settings = xmqNewOutputSettings();
     xmqSetCompact(settings, command->compact);
     xmqSetPreferDoubleQuotes(settings, command->prefer_double_quotes);
     xmqSetEscapeNewlines(settings, command->escape_newlines);
+    // A document loaded from a single input line is printed as a single compact record,
+    // otherwise a root array is split into one record per line.
+    bool per_line_input = command->env->load && (command->env->load->jsonl || command->env->load->lines);
+    xmqSetJsonLines(settings, command->json_lines && !per_line_input);
+    if (command->json_lines && per_line_input) xmqSetCompact(settings, true);
     xmqSetEscapeNon7bit(settings, command->escape_non_7bit);
     xmqSetEscapeTabs(settings, command->escape_tabs);
+    xmqSetPrintThreads(settings, command->print_threads);
     xmqSetAddIndent(settings, command->add_indent);
     xmqSetUseColor(settings, command->use_color);
     xmqSetBackgroundMode(settings, command->bg_dark_mode);
@@ -2396,6 +2608,15 @@ bool cmd_to(XMQCliCommand *command)
                             command->explicit_nl);
     }
 
+    return settings;
+}
+
+bool cmd_to(XMQCliCommand *command)
+{
+    if (command->env->transcoded) return true;
+
+    XMQOutputSettings *settings = new_to_settings(command);
+
     verbose_("xmq=", "cmd-to %s render %s",
              content_type_to_string(command->out_format),
              render_format_to_string(command->render_to));
@@ -3333,6 +3554,10 @@ void prepare_command(XMQCliCommand *c, XMQCliCommand *load_command)
     case XMQ_CLI_CMD_TO_JSON:
         c->out_format = XMQ_CONTENT_JSON;
         return;
+    case XMQ_CLI_CMD_TO_JSONL:
+        c->out_format = XMQ_CONTENT_JSON;
+        c->json_lines = true;
+        return;
     case XMQ_CLI_CMD_TO_TEXT:
         c->out_format = XMQ_CONTENT_TEXT;
         return;
@@ -4209,6 +4434,7 @@ bool perform_command(XMQCliCommand *c, bool *no_more_data)
     case XMQ_CLI_CMD_TO_HTMQ:
     case XMQ_CLI_CMD_TO_HTML:
     case XMQ_CLI_CMD_TO_JSON:
+    case XMQ_CLI_CMD_TO_JSONL:
     case XMQ_CLI_CMD_TO_TEXT:
     case XMQ_CLI_CMD_TO_CLINES:
     case XMQ_CLI_CMD_RENDER_TERMINAL:
@@ -4476,10 +4702,7 @@ bool xmq_parse_cmd_line(int argc, const char **argv, XMQCliCommand *load_command
                 }
             }
 
-            verbose_("xmq=", "reading ixml file %s", local_ixml_file);
-            load_command->ixml_filename = strdup(local_ixml_file);
-            load_command->ixml_source = load_file_into_buffer(local_ixml_file);
-            if (load_command->ixml_source == NULL) exit(1);
+            load_ixml_grammar_file(load_command, local_ixml_file);
             i++;
         }
     }
@@ -4487,14 +4710,11 @@ bool xmq_parse_cmd_line(int argc, const char **argv, XMQCliCommand *load_command
     if (argv[i])
     {
         char *dot = strrchr(argv[i], '.');
-        if (dot && !strcmp(dot, ".ixml") && !load_command->ixml_source)
+        if (dot && (!strcmp(dot, ".ixml") || !strcmp(dot, ".ixmlc")) && !load_command->ixml_source)
         {
             // A single foo.ixml file is interpreted as --ixml=foo.ixml
             // But not if an ixml file has already been found, or --ixml=file has been used.
-            verbose_("xmq=", "reading ixml file %s", argv[i]);
-            load_command->ixml_filename = strdup(argv[i]);
-            load_command->ixml_source = load_file_into_buffer(argv[i]);
-            if (load_command->ixml_source == NULL) exit(1);
+            load_ixml_grammar_file(load_command, argv[i]);
             i++;
         }
     }
@@ -4935,6 +5155,10 @@ int main(int argc, const char **argv)
     {
         return cmd_help(load_command->next);
     }
+    if (load_command->compile_ixml_to)
+    {
+        return compile_ixml_grammar(load_command) ? 0 : 1;
+    }
 
     bool more_content = true;
     bool no_more_data = false;
@@ -4997,6 +5221,107 @@ char *load_file_into_buffer(const char *file)
     return buf;
 }
 
+/**
+    map_file_into_memory:
+    @file: The file to map.
+    @size: Set to the size of the file.
+
+    Map the file read only into memory. On windows the file is read into a buffer instead.
+*/
+char *map_file_into_memory(const char *file, size_t *size)
+{
+#ifndef PLATFORM_WINAPI
+    int fd = open(file, O_RDONLY);
+    if (fd < 0)
+    {
+        fprintf(stderr, "xmq: %s: No such file or directory\n", file);
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        fprintf(stderr, "xmq: %s: Could not read file\n", file);
+        close(fd);
+        return NULL;
+    }
+    void *p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED)
+    {
+        fprintf(stderr, "xmq: %s: Could not map file\n", file);
+        return NULL;
+    }
+    *size = st.st_size;
+    return (char*)p;
+#else
+    FILE *f = fopen(file, "rb");
+    if (!f)
+    {
+        fprintf(stderr, "xmq: %s: No such file or directory\n", file);
+        return NULL;
+    }
+    fseek(f, 0L, SEEK_END);
+    size_t sz = ftell(f);
+    fseek(f, 0L, SEEK_SET);
+    char *buf = (char*)malloc(sz+1);
+    size_t n = fread(buf, 1, sz, f);
+    buf[sz] = 0;
+    fclose(f);
+    *size = n;
+    return buf;
+#endif
+}
+
+/**
+    load_ixml_grammar_file:
+    @command: The load command.
+    @file: An ixml source file, or a grammar compiled with --compile-ixml ending in .ixmlc
+
+    A compiled grammar is binary and is memory mapped as is.
+*/
+void load_ixml_grammar_file(XMQCliCommand *command, const char *file)
+{
+    verbose_("xmq=", "reading ixml file %s", file);
+    command->ixml_filename = strdup(file);
+
+    size_t len = strlen(file);
+    if (len > 6 && !strcmp(file+len-6, ".ixmlc"))
+    {
+        size_t size = 0;
+        command->ixml_source = map_file_into_memory(file, &size);
+        if (command->ixml_source == NULL) exit(1);
+        command->ixml_source_stop = command->ixml_source+size;
+#ifndef PLATFORM_WINAPI
+        command->ixml_source_mapped = true;
+#endif
+        return;
+    }
+
+    command->ixml_source = load_file_into_buffer(file);
+    if (command->ixml_source == NULL) exit(1);
+    command->ixml_source_stop = command->ixml_source+strlen(command->ixml_source);
+}
+
+void unload_ixml_grammar_file(XMQCliCommand *command)
+{
+    free((char*)command->ixml_filename);
+    command->ixml_filename = NULL;
+
+#ifndef PLATFORM_WINAPI
+    if (command->ixml_source_mapped)
+    {
+        munmap((void*)command->ixml_source, command->ixml_source_stop-command->ixml_source);
+        command->ixml_source_mapped = false;
+    }
+    else
+#endif
+    {
+        free((char*)command->ixml_source);
+    }
+    command->ixml_source = NULL;
+    command->ixml_source_stop = NULL;
+}
+
 bool check_file_exists(const char *file)
 {
     FILE *f = fopen(file, "rb");
@@ -116,9 +116,7 @@ XMQStatus do_ns_colon(XMQParseState *state, size_t line, size_t col, const char
 XMQStatus do_quote(XMQParseState *state, size_t l, size_t col, const char *start, const char *stop, const char *suffix);
 XMQStatus do_whitespace(XMQParseState *state, size_t line, size_t col, const char *start, const char *stop, const char *suffix);
 bool find_line(const char *start, const char *stop, size_t *indent, const char **after_last_non_space, const char **eol);
-void fixup_html(XMQDoc *doq, xmlNode *node, bool inside_cdata_declared);
-void fixup_comments(XMQDoc *doq, xmlNode *node, int depth);
-void generate_dom_from_yaep_node(xmlDocPtr doc, xmlNodePtr node, YaepTreeNode *n, YaepTreeNode *parent, int depth, int index);
+void generate_dom_from_yaep_node(xmlDocPtr doc, xmlNodePtr node, YaepTreeNode *n);
 void handle_yaep_syntax_error(YaepParseRun *pr,
                               int err_tok_num,
                               void *err_tok_attr,
@@ -132,6 +130,16 @@ const char *node_yaep_type_to_string(YaepTreeNodeType t);
 void reset_ansi(XMQParseState *state);
 void reset_ansi_nl(XMQParseState *state);
 const char *skip_any_potential_bom(const char *start, const char *stop);
+void reset_json_lines_state(XMQJsonLines *jl, XMQDoc *doq);
+void finish_print_memory(XMQOutputSettings *os);
+bool xmq_transcode_xml_to_xmq(XMQPrintState *ps, const char *start, const char *stop, int flags);
+void stream_xml_append(xmlNode *parent, xmlNode *node);
+xmlNode *stream_xml_copy_element(xmlNode *node, xmlNode *parent);
+void stream_xml_child(XMQPrintState *ps, Stack *opened, XMQFixupWalk *walk, xmlNode *parent, xmlNode *node, int fixups, bool compact);
+xmlNode *stream_xml_end_element(XMQPrintState *ps, Stack *opened, xmlNode *element, bool compact);
+void stream_xml_error(void *arg, const char *msg, xmlParserSeverities severity, xmlTextReaderLocatorPtr locator);
+void stream_xml_flush(XMQPrintState *ps, xmlNode *parent, xmlNode *stop, bool compact);
+void stream_xml_open(XMQPrintState *ps, Stack *opened, xmlNode *element, bool compact);
 void text_print_node(XMQPrintState *ps, xmlNode *node);
 void text_print_nodes(XMQPrintState *ps, xmlNode *from);
 void cline_print_node(XMQPrintState *ps, xmlNode *node);
@@ -152,6 +160,7 @@ bool xmq_parse_buffer_text(XMQDoc *doq, const char *start, const char *stop, con
 bool xmq_parse_buffer_clines(XMQDoc *doq, const char *start, const char *stop);
 void xmq_print_html(XMQDoc *doq, XMQOutputSettings *output_settings);
 void xmq_print_xml(XMQDoc *doq, XMQOutputSettings *output_settings);
+int write_xml_output(void *context, const char *buffer, int len);
 void xmq_print_xmq(XMQDoc *doq, XMQOutputSettings *output_settings);
 void xmq_print_json(XMQDoc *doq, XMQOutputSettings *output_settings);
 void xmq_print_text(XMQDoc *doq, XMQOutputSettings *output_settings);
@@ -180,7 +189,6 @@ void xmqSetupDefaultColors(XMQOutputSettings *os)
 {
     bool dark_mode = os->bg_dark_mode;
 //    bool truecolor = os->truecolor;
-    XMQTheme *theme = os->theme;
     if (os->render_theme_spec == NULL)
     {
         if (os->render_to == XMQ_RENDER_TEX) dark_mode = false;
@@ -199,6 +207,40 @@ void xmqSetupDefaultColors(XMQOutputSettings *os)
     }
 
     verbose("xmq=", "use theme %s", os->render_theme_spec);
+
+    XMQCompiledTheme *ct = find_or_compile_theme(os, dark_mode);
+    if (ct)
+    {
+        use_compiled_theme(os, ct);
+    }
+    else
+    {
+        // The cache is full, set up a private theme for these settings.
+        if (os->compiled_theme)
+        {
+            XMQTheme *theme = (XMQTheme*)malloc(sizeof(XMQTheme));
+            memset(theme, 0, sizeof(XMQTheme));
+            theme->indentation_space = " ";
+            theme->explicit_space = " ";
+            theme->explicit_nl = "\n";
+            theme->explicit_tab = "\t";
+            theme->explicit_cr = "\r";
+            os->theme = theme;
+            os->compiled_theme = NULL;
+        }
+        setup_theme(os, os->theme, dark_mode);
+    }
+
+    if (os->only_style)
+    {
+        printf("%s\n", os->theme->style.pre);
+        exit(0);
+    }
+
+}
+
+void setup_theme(XMQOutputSettings *os, XMQTheme *theme, bool dark_mode)
+{
     installTheme(theme, os->render_theme_spec);
 
     os->indentation_space = theme->indentation_space; // " ";
@@ -223,13 +265,111 @@ void xmqSetupDefaultColors(XMQOutputSettings *os)
     {
         setup_tex_coloring(os, theme, dark_mode, os->use_color, os->render_raw);
     }
+}
 
-    if (os->only_style)
+// Compiled themes are never freed, the cache is bounded by XMQ_MAX_COMPILED_THEMES.
+static XMQCompiledTheme *compiled_themes_ = NULL;
+static size_t num_compiled_themes_ = 0;
+static pthread_mutex_t compiled_themes_lock_ = PTHREAD_MUTEX_INITIALIZER;
+
+XMQCompiledTheme *find_or_compile_theme(XMQOutputSettings *os, bool dark_mode)
+{
+    pthread_mutex_lock(&compiled_themes_lock_);
+
+    XMQCompiledTheme *ct = compiled_themes_;
+    while (ct && !compiled_theme_matches(ct, os, dark_mode)) ct = ct->next;
+
+    if (!ct && num_compiled_themes_ < XMQ_MAX_COMPILED_THEMES)
     {
-        printf("%s\n", theme->style.pre);
-        exit(0);
+        ct = compile_theme(os, dark_mode);
+        ct->next = compiled_themes_;
+        compiled_themes_ = ct;
+        num_compiled_themes_++;
     }
 
+    pthread_mutex_unlock(&compiled_themes_lock_);
+    return ct;
+}
+
+bool same_or_both_null(const char *a, const char *b);
+bool same_or_both_null(const char *a, const char *b)
+{
+    if (a == NULL || b == NULL) return a == b;
+    return !strcmp(a, b);
+}
+
+bool compiled_theme_matches(XMQCompiledTheme *ct, XMQOutputSettings *os, bool dark_mode)
+{
+    if (ct->render_to != os->render_to) return false;
+    if (ct->dark_mode != dark_mode) return false;
+    if (ct->use_color != os->use_color) return false;
+    if (ct->truecolor != os->truecolor) return false;
+    if (ct->render_raw != os->render_raw) return false;
+    if (strcmp(ct->theme_spec, os->render_theme_spec)) return false;
+    if (!same_or_both_null(ct->use_id, os->use_id)) return false;
+    if (!same_or_both_null(ct->use_class, os->use_class)) return false;
+    return true;
+}
+
+XMQCompiledTheme *compile_theme(XMQOutputSettings *os, bool dark_mode)
+{
+    XMQCompiledTheme *ct = (XMQCompiledTheme*)malloc(sizeof(XMQCompiledTheme));
+    memset(ct, 0, sizeof(XMQCompiledTheme));
+
+    ct->theme_spec = strdup(os->render_theme_spec);
+    ct->render_to = os->render_to;
+    ct->dark_mode = dark_mode;
+    ct->use_color = os->use_color;
+    ct->truecolor = os->truecolor;
+    ct->render_raw = os->render_raw;
+    if (os->use_id) ct->use_id = strdup(os->use_id);
+    if (os->use_class) ct->use_class = strdup(os->use_class);
+
+    XMQTheme *theme = (XMQTheme*)malloc(sizeof(XMQTheme));
+    memset(theme, 0, sizeof(XMQTheme));
+    theme->indentation_space = " ";
+    theme->explicit_space = " ";
+    theme->explicit_nl = "\n";
+    theme->explicit_tab = "\t";
+    theme->explicit_cr = "\r";
+    ct->theme = theme;
+
+    // Run the setup against scratch settings that only carry the parameters of the key,
+    // then keep the resulting whitespace strings and buffers in the compiled theme.
+    XMQOutputSettings scratch;
+    memset(&scratch, 0, sizeof(scratch));
+    scratch.render_theme_spec = ct->theme_spec;
+    scratch.render_to = ct->render_to;
+    scratch.use_color = ct->use_color;
+    scratch.truecolor = ct->truecolor;
+    scratch.render_raw = ct->render_raw;
+    scratch.use_id = ct->use_id;
+    scratch.use_class = ct->use_class;
+
+    setup_theme(&scratch, theme, dark_mode);
+
+    ct->indentation_space = scratch.indentation_space;
+    ct->explicit_space = scratch.explicit_space;
+    ct->explicit_tab = scratch.explicit_tab;
+    ct->explicit_cr = scratch.explicit_cr;
+    ct->explicit_nl = scratch.explicit_nl;
+    ct->free_me = scratch.free_me;
+    ct->free_and_me = scratch.free_and_me;
+
+    return ct;
+}
+
+void use_compiled_theme(XMQOutputSettings *os, XMQCompiledTheme *ct)
+{
+    if (!os->compiled_theme) free(os->theme);
+    os->theme = ct->theme;
+    os->compiled_theme = ct;
+
+    os->indentation_space = ct->indentation_space;
+    os->explicit_space = ct->explicit_space;
+    os->explicit_tab = ct->explicit_tab;
+    os->explicit_cr = ct->explicit_cr;
+    os->explicit_nl = ct->explicit_nl;
 }
 
 const char *add_color(XMQColorDef *colors, XMQColorName n, char **pp, bool truecolor);
@@ -591,6 +731,7 @@ void setup_tex_coloring(XMQOutputSettings *os, XMQTheme *theme, bool dark_mode,
         *p = 0;
 
         theme->style.pre = style_pre;
+        os->free_me = style_pre;
 
         theme->body.pre = "\n\\begin{document}\n";
         theme->body.post = "\n\\end{document}\n";
@@ -757,7 +898,7 @@ XMQOutputSettings *xmqNewOutputSettings()
 
 void xmqFreeOutputSettings(XMQOutputSettings *os)
 {
-    if (os->theme)
+    if (os->theme && !os->compiled_theme)
     {
         free(os->theme);
         os->theme = NULL;
@@ -772,6 +913,12 @@ void xmqFreeOutputSettings(XMQOutputSettings *os)
         free(os->free_and_me);
         os->free_and_me = NULL;
     }
+    if (os->output_buffer)
+    {
+        // Setup to print to memory, but nothing was printed.
+        free_membuffer_and_free_content(os->output_buffer);
+        os->output_buffer = NULL;
+    }
     free(os);
 }
 
@@ -810,6 +957,11 @@ void xmqSetEscapeNewlines(XMQOutputSettings *os, bool escape_newlines)
     os->escape_newlines = escape_newlines;
 }
 
+void xmqSetJsonLines(XMQOutputSettings *os, bool json_lines)
+{
+    os->json_lines = json_lines;
+}
+
 void xmqSetEscapeNon7bit(XMQOutputSettings *os, bool escape_non_7bit)
 {
     os->escape_non_7bit = escape_non_7bit;
@@ -820,6 +972,11 @@ void xmqSetEscapeTabs(XMQOutputSettings *os, bool escape_tabs)
     os->escape_tabs = escape_tabs;
 }
 
+void xmqSetPrintThreads(XMQOutputSettings *os, int num_threads)
+{
+    os->print_threads = num_threads;
+}
+
 void xmqSetOutputFormat(XMQOutputSettings *os, XMQContentType output_format)
 {
     os->output_format = output_format;
@@ -1054,6 +1211,7 @@ bool xmqTokenizeBuffer(XMQParseState *state, const char *start, const char *stop
     {
         size_t size = membuffer_used(output_settings->output_buffer);
         char *buffer = free_membuffer_but_return_trimmed_content(output_settings->output_buffer);
+        output_settings->output_buffer = NULL;
         *output_settings->output_buffer_start = buffer;
         *output_settings->output_buffer_stop = buffer+size;
     }
@@ -1895,6 +2053,8 @@ void *xmqGetImplementationDoc(XMQDoc *doq)
 void xmqSetImplementationDoc(XMQDoc *doq, void *doc)
 {
     doq->docptr_.xml = (xmlDocPtr)doc;
+    // Only a doc built by the json parser has inline json literals.
+    doq->json_literals_ = false;
 }
 
 void xmqSetDocSourceName(XMQDoc *doq, const char *source_name)
@@ -1955,6 +2115,10 @@ void xmqFreeParseState(XMQParseState *state)
     // Settings are not freed here.
     state->output_settings = NULL;
 
+    free(state->json_index);
+    state->json_index = NULL;
+    free_json_key_cache(&state->json_keys);
+
     if (state->yaep_tmp_rhs_) free(state->yaep_tmp_rhs_);
     state->yaep_tmp_rhs_ = NULL;
     if (state->yaep_tmp_transl_) free(state->yaep_tmp_transl_);
@@ -1977,10 +2141,10 @@ void xmqFreeParseState(XMQParseState *state)
     if (state->ixml_rule_stack) stack_free(state->ixml_rule_stack);
     state->ixml_rule_stack = NULL;
 
-    if (state->used_unicodes)
+    for (int i = 0; i < XMQ_NUM_UNICODE_PAGES; ++i)
     {
-        free(state->used_unicodes);
-        state->used_unicodes = NULL;
+        if (state->used_unicode_pages[i]) free(state->used_unicode_pages[i]);
+        state->used_unicode_pages[i] = NULL;
     }
     free(state);
 }
@@ -1999,6 +2163,7 @@ void xmqClearDoc(XMQDoc *doq)
         debug("xmq=", "freeing xml doc");
         xmlFreeDoc(doq->docptr_.xml);
         doq->docptr_.xml = xmlNewDoc((const xmlChar*)"1.0");
+        doq->json_literals_ = false;
     }
     if (doq->yaep_grammar_)
     {
@@ -2438,6 +2603,19 @@ XMQStatus do_element_value_text(XMQParseState *state,
         state->parsing_doctype = false;
         state->doctype_found = true;
     }
+    else if (state->json_literal && (size_t)(stop-start) < JSON_INLINE_LITERAL_MAX)
+    {
+        // The short text of a json number, boolean or null is stored inside the text node,
+        // in the properties and nsDef pointers that a text node does not use, like libxml
+        // does for short text. Any change to the text moves it to a malloced copy,
+        // thus printing json knows that inline text is still the parsed literal.
+        xmlNodePtr n = xmlNewDocText(state->doq->docptr_.xml, NULL);
+        n->content = (xmlChar*)&n->properties;
+        memcpy(n->content, start, stop-start);
+        n->content[stop-start] = 0;
+        state->doq->json_literals_ = true;
+        xmlAddChild((xmlNode*)state->element_last, n);
+    }
     else
     {
         xmlNodePtr n = xmlNewDocTextLen(state->doq->docptr_.xml, (const xmlChar *)start, stop-start);
@@ -3074,36 +3252,50 @@ void copy_quote_settings_from_output_settings(XMQQuoteSettings *qs, XMQOutputSet
     qs->allow_json_quotes = os->allow_json_quotes;
 }
 
+/**
+    write_xml_output:
+    @context: The output settings.
+    @buffer: The bytes flushed by the libxml2 output buffer.
+    @len: Number of bytes.
+
+    Hand over the xml/html serialized by libxml2 to the content writer,
+    one output buffer chunk at a time.
+*/
+int write_xml_output(void *context, const char *buffer, int len)
+{
+    XMQOutputSettings *os = (XMQOutputSettings*)context;
+    if (len > 0) os->content.write(os->content.writer_state, buffer, buffer+len);
+    return len;
+}
+
 void xmq_print_xml(XMQDoc *doq, XMQOutputSettings *output_settings)
 {
     xmq_fixup_html_before_writeout(doq);
 
-    xmlChar *buffer;
-    int size;
-    xmlDocDumpMemoryEnc(doq->docptr_.xml,
-                        &buffer,
-                        &size,
-                        "utf-8");
+    // The same as xmlDocDumpMemoryEnc, i.e. always xml (even for a html doc) and not formatted.
+    int options = XML_SAVE_AS_XML;
+    // Skip <?xml version="1.0" encoding="utf-8"?>\n
+    if (output_settings->omit_decl) options |= XML_SAVE_NO_DECL;
 
-    membuffer_reuse(output_settings->output_buffer,
-                    (char*)buffer,
-                    size);
+    xmlSaveCtxtPtr ctxt = xmlSaveToIO(write_xml_output, NULL, output_settings, "utf-8", options);
+    if (ctxt)
+    {
+        xmlSaveDoc(ctxt, doq->docptr_.xml);
+        xmlSaveClose(ctxt);
+    }
 
-    debug("xmq=", "xmq_print_xml wrote %zu bytes", size);
+    debug("xmq=", "xmq_print_xml done");
 }
 
 void xmq_print_html(XMQDoc *doq, XMQOutputSettings *output_settings)
 {
     xmq_fixup_html_before_writeout(doq);
-    xmlOutputBufferPtr out = xmlAllocOutputBuffer(NULL);
+    xmlOutputBufferPtr out = xmlOutputBufferCreateIO(write_xml_output, NULL, output_settings, NULL);
     if (out)
     {
         htmlDocContentDumpOutput(out, doq->docptr_.html, "utf8");
-        const xmlChar *buffer = xmlBufferContent((xmlBuffer *)out->buffer);
-        MemBuffer *membuf = output_settings->output_buffer;
-        membuffer_append(membuf, (char*)buffer);
-        debug("xmq=", "xmq_print_html wrote %zu bytes", membuf->used_);
         xmlOutputBufferClose(out);
+        debug("xmq=", "xmq_print_html done");
     }
     /*
     xmlNodePtr child = doq->docptr_.xml->children;
@@ -3135,6 +3327,7 @@ void xmq_print_json(XMQDoc *doq, XMQOutputSettings *os)
     XMQWrite write = os->content.write;
     void *writer_state = os->content.writer_state;
     ps.doq = doq;
+    if (os->json_lines) os->compact = true;
     if (os->compact) os->escape_newlines = true;
     ps.output_settings = os;
     assert(os->content.write);
@@ -3142,11 +3335,19 @@ void xmq_print_json(XMQDoc *doq, XMQOutputSettings *os)
     // Find any leading (doctype/comments) and ending (comments) nodes and store in pre_nodes and post_nodes inside ps.
     // Adjust the first and last pointer.
     collect_leading_ending_comments_doctype(&ps, (xmlNode**)&first, (xmlNode**)&last);
-    json_print_object_nodes(&ps, NULL, (xmlNode*)first, (xmlNode*)last);
-    write(writer_state, "\n", NULL);
+    if (os->json_lines)
+    {
+        json_print_lines(&ps, (xmlNode*)first, (xmlNode*)last);
+    }
+    else
+    {
+        json_print_object_nodes(&ps, NULL, (xmlNode*)first, (xmlNode*)last);
+        write(writer_state, "\n", NULL);
+    }
 
     stack_free(ps.pre_nodes);
     stack_free(ps.post_nodes);
+    free(ps.json_keys.slots);
 }
 
 void text_print_node(XMQPrintState *ps, xmlNode *node)
@@ -3340,7 +3541,14 @@ void xmq_print_xmq(XMQDoc *doq, XMQOutputSettings *os)
     if (theme->body.pre) write(writer_state, theme->body.pre, NULL);
 
     if (theme->content.pre) write(writer_state, theme->content.pre, NULL);
-    print_nodes(&ps, (xmlNode*)first, (xmlNode*)last, 0);
+    if (use_compact_printer(os))
+    {
+        compact_print_nodes(&ps, (xmlNode*)first);
+    }
+    else
+    {
+        print_nodes(&ps, (xmlNode*)first, (xmlNode*)last, 0);
+    }
     if (theme->content.post) write(writer_state, theme->content.post, NULL);
 
     if (theme->body.post) write(writer_state, theme->body.post, NULL);
@@ -3376,25 +3584,404 @@ void xmqPrint(XMQDoc *doq, XMQOutputSettings *output_settings)
         xmq_print_xmq(doq, output_settings);
     }
 
-    if (output_settings->output_buffer &&
-        output_settings->output_buffer_start &&
-        output_settings->output_buffer_stop)
+    finish_print_memory(output_settings);
+}
+
+/**
+    finish_print_memory:
+    @os: The output settings.
+
+    When printing to memory, hand over the printed buffer to the pointers
+    supplied to xmqSetupPrintMemory.
+*/
+void finish_print_memory(XMQOutputSettings *os)
+{
+    if (os->output_buffer &&
+        os->output_buffer_start &&
+        os->output_buffer_stop)
     {
-        membuffer_append_null(output_settings->output_buffer);
-        size_t size = membuffer_used(output_settings->output_buffer);
-        char *buffer = free_membuffer_but_return_trimmed_content(output_settings->output_buffer);
-        *output_settings->output_buffer_start = buffer;
-        *output_settings->output_buffer_stop = buffer+size;
-        if (output_settings->output_skip)
+        membuffer_append_null(os->output_buffer);
+        size_t size = membuffer_used(os->output_buffer);
+        char *buffer = free_membuffer_but_return_trimmed_content(os->output_buffer);
+        os->output_buffer = NULL;
+        *os->output_buffer_start = buffer;
+        *os->output_buffer_stop = buffer+size;
+        // Nothing to skip, the xml declaration is never written when it should be omitted.
+        if (os->output_skip) *os->output_skip = 0;
+    }
+}
+
+void stream_xml_error(void *arg, const char *msg, xmlParserSeverities severity, xmlTextReaderLocatorPtr locator)
+{
+    // Any error or warning is reported by the dom path instead.
+    *(bool*)arg = true;
+}
+
+void stream_xml_append(xmlNode *parent, xmlNode *node)
+{
+    // Not xmlAddChild since that merges adjacent text nodes, they must stay separate
+    // exactly as in the dom, where a trimmed away comment can leave two text nodes next to each other.
+    node->parent = parent;
+    node->prev = parent->last;
+    if (parent->last) parent->last->next = node;
+    else parent->children = node;
+    parent->last = node;
+}
+
+/**
+    stream_xml_copy_element:
+    @node: The element being read by the xml reader.
+    @parent: The copy of the parent element.
+
+    Copy the element, its namespace definitions and attributes, but not its children.
+    The copy is added to the parent copy before the namespaces are looked up, since
+    the parent copies contain all namespace definitions in scope.
+    Returns NULL if the namespace of the element could not be found.
+*/
+xmlNode *stream_xml_copy_element(xmlNode *node, xmlNode *parent)
+{
+    xmlNode *copy = xmlNewDocNode(node->doc, NULL, node->name, NULL);
+    stream_xml_append(parent, copy);
+
+    if (node->nsDef) copy->nsDef = xmlCopyNamespaceList(node->nsDef);
+    if (node->ns)
+    {
+        copy->ns = xmlSearchNs(node->doc, copy, node->ns->prefix);
+        if (!copy->ns) return NULL;
+    }
+    if (node->properties) copy->properties = xmlCopyPropList(copy, node->properties);
+
+    return copy;
+}
+
+/**
+    stream_xml_open:
+    @ps: The print state.
+    @opened: The stack of opened element copies.
+    @element: The element copy that got a child that is not text.
+
+    The element can no longer be printed as a leaf or as key=value, print its
+    preceding siblings and then its name, attributes and opening brace.
+    The element is always the innermost element or its parent and all elements
+    above it are already opened, thus it is opened if it is on top of the stack.
+*/
+void stream_xml_open(XMQPrintState *ps, Stack *opened, xmlNode *element, bool compact)
+{
+    if (opened->top->data == element) return;
+
+    stream_xml_flush(ps, element->parent, element, compact);
+
+    if (compact) compact_print_element_open(ps, element);
+    else print_element_open(ps, element);
+
+    stack_push(opened, element);
+}
+
+/**
+    stream_xml_flush:
+    @ps: The print state.
+    @parent: An opened element copy, or the document container.
+    @stop: Print the children up to this child, NULL prints all children.
+
+    Print and free the children not yet printed. These are text children of an element
+    that was just opened or a run of key=value siblings that are aligned by print_node_run.
+*/
+void stream_xml_flush(XMQPrintState *ps, xmlNode *parent, xmlNode *stop, bool compact)
+{
+    xmlNode *from = parent->children;
+    if (from == stop) return;
+
+    if (compact)
+    {
+        for (xmlNode *i = from; i != stop; i = i->next) compact_print_node(ps, i);
+    }
+    else
+    {
+        print_node_run(ps, NULL, from, stop, 0, 0, from);
+    }
+
+    while (parent->children != stop)
+    {
+        xmlNode *i = parent->children;
+        xmlUnlinkNode(i);
+        xmlFreeNode(i);
+    }
+}
+
+/**
+    stream_xml_child:
+    @ps: The print state.
+    @opened: The stack of opened element copies.
+    @walk: The fixup traversal.
+    @parent: The copy of the parent element.
+    @node: A text, entity, comment or pi node being read by the xml reader.
+    @fixups: The fixups after reading, exactly as for the dom.
+    @compact: Use the compact printer.
+
+    Copy, fixup and trim the node. Text and entities are kept until the parent is
+    known to be a key=value node or not. Anything else opens the parent and is printed.
+*/
+void stream_xml_child(XMQPrintState *ps, Stack *opened, XMQFixupWalk *walk, xmlNode *parent, xmlNode *node, int fixups, bool compact)
+{
+    xmlNode *prev = parent->last;
+    stream_xml_append(parent, xmlDocCopyNode(node, node->doc, 1));
+
+    // The comment is replaced with a new node if it needs unescaping.
+    fixup_walk_node(walk, parent->last, fixups);
+
+    xmlNode *copy = parent->last;
+    // Trimmed away.
+    if (copy == prev) return;
+
+    if (is_content_node(copy) || is_entity_node(copy))
+    {
+        if (opened->top->data != parent) return;
+    }
+    else
+    {
+        stream_xml_open(ps, opened, parent, compact);
+    }
+    stream_xml_flush(ps, parent, NULL, compact);
+}
+
+/**
+    stream_xml_end_element:
+    @ps: The print state.
+    @opened: The stack of opened element copies.
+    @element: The element copy that ended.
+    @compact: Use the compact printer.
+
+    Close an opened element. An element that was never opened is now complete
+    and is printed as a leaf or as key=value, unless it is part of a run of key=value
+    siblings where the equal signs are aligned, then it is printed with the run.
+    Returns the copy of the parent element.
+*/
+xmlNode *stream_xml_end_element(XMQPrintState *ps, Stack *opened, xmlNode *element, bool compact)
+{
+    xmlNode *parent = element->parent;
+
+    if (opened->top->data == element)
+    {
+        stack_pop(opened);
+        stream_xml_flush(ps, element, NULL, compact);
+
+        if (compact) compact_print_element_close(ps);
+        else print_element_close(ps);
+
+        xmlUnlinkNode(element);
+        xmlFreeNode(element);
+        return parent;
+    }
+
+    if (!ps->output_settings->compact && is_key_value_node(element) && !xml_first_attribute(element))
+    {
+        return parent;
+    }
+
+    stream_xml_flush(ps, parent, NULL, compact);
+    return parent;
+}
+
+/**
+    xmq_transcode_xml_to_xmq:
+    @ps: The print state.
+    @start: Start of the xml.
+    @stop: Points to byte after the last byte of the xml.
+    @flags: The parse flags, these decide the whitespace trimming.
+
+    Read the xml with the xml reader and print each node as soon as it is known how
+    it should be printed. Only the open elements and the children that are not yet
+    printed are copied, the reader frees its nodes when it moves on. The leaf children
+    of an element are held until a sibling with children of its own arrives or the element
+    is closed, since a run of key=value siblings is aligned on the longest key. Thus the
+    memory used is bounded by the nesting depth plus the longest run of leaf siblings,
+    which for a flat document, like a root with only key=value children, is the whole
+    document. Returns false if the reader found an error or a warning.
+*/
+bool xmq_transcode_xml_to_xmq(XMQPrintState *ps, const char *start, const char *stop, int flags)
+{
+    int parse_options = XML_PARSE_NOCDATA | XML_PARSE_NONET;
+    bool should_trim = false;
+    if ((flags & XMQ_FLAG_TRIM_HEURISTIC) ||
+        (flags & XMQ_FLAG_TRIM_EXACT)) should_trim = true;
+
+    // Same as xmq_parse_buffer_xml.
+    if (should_trim && !(flags & XMQ_FLAG_TRIM_NONE)) parse_options |= XML_PARSE_NOBLANKS;
+    // Same as xmqParseBufferWithType, xml is trimmed by default.
+    if (!(flags & XMQ_FLAG_TRIM_NONE)) should_trim = true;
+
+    xmlTextReaderPtr reader = xmlReaderForMemory(start, stop-start, NULL, NULL, parse_options);
+    if (!reader) return false;
+
+    bool failed = false;
+    xmlTextReaderSetErrorHandler(reader, stream_xml_error, &failed);
+
+    XMQDoc doq = {};
+    ps->doq = &doq;
+    bool compact = use_compact_printer(ps->output_settings);
+
+    XMQFixupWalk walk = {};
+    walk.doq = &doq;
+    walk.flags = flags;
+    int fixups = XMQ_FIXUP_COMMENTS;
+    if (should_trim) fixups |= XMQ_FIXUP_TRIM;
+
+    // The document level nodes are added to this container, it is never printed.
+    xmlNode *top = NULL;
+    xmlNode *parent = NULL;
+    // The opened element copies, the container is always at the bottom.
+    Stack *opened = stack_create();
+
+    int rc = 0;
+    while (!failed && (rc = xmlTextReaderRead(reader)) == 1)
+    {
+        xmlNode *node = xmlTextReaderCurrentNode(reader);
+        if (!top)
         {
-            *output_settings->output_skip = 0;
-            if (output_settings->output_format == XMQ_CONTENT_XML && output_settings->omit_decl)
+            doq.docptr_.xml = node->doc;
+            top = xmlNewDocNode(node->doc, NULL, (const xmlChar*)"top", NULL);
+            stack_push(opened, top);
+            parent = top;
+        }
+
+        if (xmlTextReaderNodeType(reader) == XML_READER_TYPE_END_ELEMENT)
+        {
+            parent = stream_xml_end_element(ps, opened, parent, compact);
+            continue;
+        }
+
+        switch (node->type)
+        {
+        case XML_ELEMENT_NODE:
+            parent = stream_xml_copy_element(node, parent);
+            if (!parent)
             {
-                // Skip <?xml version="1.0" encoding="utf-8"?>\n
-                *output_settings->output_skip = 39;
+                failed = true;
+                break;
             }
+            stream_xml_open(ps, opened, parent->parent, compact);
+            if (xmlTextReaderIsEmptyElement(reader)) parent = stream_xml_end_element(ps, opened, parent, compact);
+            break;
+        case XML_TEXT_NODE:
+        case XML_CDATA_SECTION_NODE:
+        case XML_ENTITY_REF_NODE:
+        case XML_COMMENT_NODE:
+        case XML_PI_NODE:
+            stream_xml_child(ps, opened, &walk, parent, node, fixups, compact);
+            break;
+        case XML_DTD_NODE:
+            fixup_walk_node(&walk, node, fixups);
+            stream_xml_flush(ps, top, NULL, compact);
+            print_node(ps, node, 0);
+            break;
+        default:
+            verbose("xmq=", "transcode xml cannot stream %s", xml_element_type_to_string(node->type));
+            failed = true;
         }
     }
+
+    if (rc != 0 || parent != top) failed = true;
+    if (!failed) stream_xml_flush(ps, top, NULL, compact);
+
+    if (top) xmlFreeNode(top);
+    stack_free(opened);
+    xmlFreeTextReader(reader);
+    ps->doq = NULL;
+
+    return !failed;
+}
+
+bool xmqTranscodeBuffer(const char *start, const char *stop, XMQContentType ct, int flags, XMQOutputSettings *os)
+{
+    if (!stop) stop = start+strlen(start);
+    start = skip_any_potential_bom(start, stop);
+    if (!start) return false;
+
+    if (ct == XMQ_CONTENT_DETECT) ct = xmqDetectContentType(start, stop);
+
+    // Not json output, since it needs the number of siblings with the same name before the first one is printed.
+    if (os->output_format != XMQ_CONTENT_XMQ && os->output_format != XMQ_CONTENT_HTMQ) return false;
+    if (os->compact) os->escape_newlines = true;
+    if (!os->theme) return false;
+
+    if (ct == XMQ_CONTENT_JSON)
+    {
+        // Json to compact uncoloured xmq only. Json is only trimmed when explicitly requested.
+        if (!use_compact_printer(os)) return false;
+        if (flags & (XMQ_FLAG_TRIM_HEURISTIC | XMQ_FLAG_TRIM_EXACT)) return false;
+    }
+    else if (ct != XMQ_CONTENT_XML)
+    {
+        return false;
+    }
+
+    // Whether the dom is needed is only known when the input has been read, thus anything
+    // written is thrown away if the dom path has to be used. When printing to memory the
+    // output is printed straight into the output buffer, which is rewound on failure.
+    // Any other writer cannot take back what it has been given, so the output is staged
+    // in memory and handed over to the writer only when the conversion has succeeded.
+    XMQWrite user_write = os->content.write;
+    void *user_writer_state = os->content.writer_state;
+    MemBuffer *staging = NULL;
+    if (!os->output_buffer)
+    {
+        staging = new_membuffer();
+        os->content.write = write_print_memory;
+        os->content.writer_state = staging;
+    }
+
+    XMQPrintState ps = {};
+    ps.output_settings = os;
+
+    XMQParseCallbacks *parse = xmqNewParseCallbacks();
+    parse->magic_cookie = MAGIC_COOKIE;
+    XMQParseState *state = xmqNewParseState(parse, os);
+
+    XMQWrite write = os->content.write;
+    void *writer_state = os->content.writer_state;
+    XMQTheme *theme = os->theme;
+    if (theme->document.pre) write(writer_state, theme->document.pre, NULL);
+    if (theme->header.pre) write(writer_state, theme->header.pre, NULL);
+    if (theme->style.pre) write(writer_state, theme->style.pre, NULL);
+    if (theme->header.post) write(writer_state, theme->header.post, NULL);
+    if (theme->body.pre) write(writer_state, theme->body.pre, NULL);
+    if (theme->content.pre) write(writer_state, theme->content.pre, NULL);
+
+    bool ok;
+    if (ct == XMQ_CONTENT_JSON) ok = xmq_transcode_json_to_xmq(state, &ps, start, stop);
+    else ok = xmq_transcode_xml_to_xmq(&ps, start, stop, flags);
+
+    if (ok)
+    {
+        if (theme->content.post) write(writer_state, theme->content.post, NULL);
+        if (theme->body.post) write(writer_state, theme->body.post, NULL);
+        if (theme->document.post) write(writer_state, theme->document.post, NULL);
+        write(writer_state, "\n", NULL);
+
+        if (staging)
+        {
+            user_write(user_writer_state, staging->buffer_, staging->buffer_+staging->used_);
+        }
+        finish_print_memory(os);
+    }
+    else
+    {
+        verbose("xmq=", "transcode %s needs dom", ct == XMQ_CONTENT_JSON ? "json" : "xml");
+        // Drop what has been printed, nothing has reached the writer.
+        if (os->output_buffer) os->output_buffer->used_ = 0;
+    }
+
+    if (staging)
+    {
+        os->content.write = user_write;
+        os->content.writer_state = user_writer_state;
+        free_membuffer_and_free_content(staging);
+    }
+
+    xmqFreeParseState(state);
+    xmqFreeParseCallbacks(parse);
+
+    return ok;
 }
 
 void xmqAnnotateOffsets(XMQDoc *doq, const char *attribute_name, const char *ns)
@@ -3407,7 +3994,7 @@ void xmqAnnotateOffsets(XMQDoc *doq, const char *attribute_name, const char *ns)
 // Use an internal bit for signaling treating tabs as part of incidental indentation.
 #define TRIM_TABS    65536*2
 
-void trim_text_node(xmlNode *node, int flags)
+bool trim_text_node(xmlNode *node, int flags)
 {
     // If node has whitespace preserve set, then do not trim.
     //if (xmlNodeGetSpacePreserve (node)) return;
@@ -3424,7 +4011,7 @@ void trim_text_node(xmlNode *node, int flags)
     {
         xmlUnlinkNode(node);
         xmlFreeNode(node);
-        return;
+        return false;
     }
     // This is not entirely whitespace, now use the xmq_un_quote function to remove any incidental indentation.
     // Use indent==0 and space==0 to indicate to the unquote function to assume the the first line indent
@@ -3447,51 +4034,45 @@ void trim_text_node(xmlNode *node, int flags)
         xmlUnlinkNode(node);
         xmlFreeNode(node);
         free(trimmed);
-        return;
+        return false;
     }
     xmlNodeSetContent(node, (xmlChar*)trimmed);
     free(trimmed);
+    return true;
 }
 
-void trim_node(xmlNode *node, int flags)
+/**
+    fixup_trim_visit:
+    @walk: The fixup traversal.
+    @node: The visited node, set to NULL if it was trimmed away.
+
+    Trim text and comment nodes. Nodes that only contain whitespace are removed.
+*/
+bool fixup_trim_visit(XMQFixupWalk *walk, xmlNode **node)
 {
-    debug("xmq=", "trim %s", xml_element_type_to_string(node->type));
+    debug("xmq=", "trim %s", xml_element_type_to_string((*node)->type));
 
-    if (is_content_node(node))
+    if (is_content_node(*node))
     {
-        trim_text_node(node, flags);
-        return;
+        if (!trim_text_node(*node, walk->flags)) *node = NULL;
+        return false;
     }
 
-    if (is_comment_node(node))
+    if (is_comment_node(*node))
     {
-        trim_text_node(node, flags | TRIM_COMMENT);
-        return;
+        if (!trim_text_node(*node, walk->flags | TRIM_COMMENT)) *node = NULL;
+        return false;
     }
 
     // Do not recurse into these
-    if (node->type == XML_ENTITY_DECL) return;
+    if ((*node)->type == XML_ENTITY_DECL) return false;
 
-    xmlNodePtr i = xml_first_child(node);
-    while (i)
-    {
-        xmlNode *next = xml_next_sibling(i); // i might be freed in trim.
-        trim_node(i, flags);
-        i = next;
-    }
+    return true;
 }
 
 void xmqTrimWhitespace(XMQDoc *doq, int flags)
 {
-    xmlNodePtr i = doq->docptr_.xml->children;
-    if (!doq || !i) return;
-
-    while (i)
-    {
-        xmlNode *next = xml_next_sibling(i); // i might be freed in trim.
-        trim_node(i, flags);
-        i = next;
-    }
+    xmq_fixup_doc(doq, XMQ_FIXUP_TRIM, flags);
 }
 
 /*
@@ -3649,8 +4230,30 @@ char *unescape_xml_comment(const char *comment)
     return tmp;
 }
 
-void fixup_html(XMQDoc *doq, xmlNode *node, bool inside_cdata_declared)
+/**
+    fixup_html_visit:
+    @walk: The fixup traversal.
+    @node: The visited node, updated if it was replaced.
+
+    Prepare the dom for writing xml/html, escape comments, turn cdata into text
+    and decode entities inside style and script elements.
+*/
+bool fixup_html_visit(XMQFixupWalk *walk, xmlNode **node_ptr)
 {
+    xmlNode *node = *node_ptr;
+
+    if (walk->depth > 0 &&
+        node->name &&
+        (!strcasecmp((const char*)node->name, "style") ||
+         !strcasecmp((const char*)node->name, "script")))
+    {
+        // The html style and script nodes are declared as cdata nodes.
+        // The &#10; will not be decoded, instead remain as is a ruin the style.
+        // Since htmq does not care about this distinction, we have to remove any
+        // quoting specified in the htmq before entering the cdata declared node.
+        walk->inside_cdata_declared = true;
+    }
+
     if (node->type == XML_COMMENT_NODE)
     {
         // When writing an xml comment we must replace --- with -␐-␐-.
@@ -3664,8 +4267,9 @@ void fixup_html(XMQDoc *doq, xmlNode *node, bool inside_cdata_declared)
             xmlReplaceNode(node, new_node);
             xmlFreeNode(node);
             free(new_content);
+            *node_ptr = new_node;
         }
-        return;
+        return false;
     }
     else if (node->type == XML_CDATA_SECTION_NODE)
     {
@@ -3677,7 +4281,7 @@ void fixup_html(XMQDoc *doq, xmlNode *node, bool inside_cdata_declared)
         // Workaround until I understand the proper fix, just make it a text node.
         node->type = XML_TEXT_NODE;
     }
-    else if (is_entity_node(node) && inside_cdata_declared)
+    else if (is_entity_node(node) && walk->inside_cdata_declared)
     {
         const char *new_content = (const char*)node->content;
         char buf[2];
@@ -3691,46 +4295,19 @@ void fixup_html(XMQDoc *doq, xmlNode *node, bool inside_cdata_declared)
                 new_content = buf;
             }
         }
-        xmlNodePtr new_node = xmlNewDocText(doq->docptr_.xml, (const xmlChar*)new_content);
+        xmlNodePtr new_node = xmlNewDocText(walk->doq->docptr_.xml, (const xmlChar*)new_content);
         xmlReplaceNode(node, new_node);
         xmlFreeNode(node);
-        return;
+        *node_ptr = new_node;
+        return false;
     }
 
-    xmlNode *i = xml_first_child(node);
-    while (i)
-    {
-        xmlNode *next = xml_next_sibling(i); // i might be freed in trim.
-
-        bool r = inside_cdata_declared;
-
-        if (i->name &&
-            (!strcasecmp((const char*)i->name, "style") ||
-             !strcasecmp((const char*)i->name, "script")))
-        {
-            // The html style and script nodes are declared as cdata nodes.
-            // The &#10; will not be decoded, instead remain as is a ruin the style.
-            // Since htmq does not care about this distinction, we have to remove any
-            // quoting specified in the htmq before entering the cdata declared node.
-            r = true;
-        }
-
-        fixup_html(doq, i, r);
-        i = next;
-    }
+    return true;
 }
 
 void xmq_fixup_html_before_writeout(XMQDoc *doq)
 {
-    xmlNodePtr i = doq->docptr_.xml->children;
-    if (!doq || !i) return;
-
-    while (i)
-    {
-        xmlNode *next = xml_next_sibling(i); // i might be freed in fixup_html.
-        fixup_html(doq, i, false);
-        i = next;
-    }
+    xmq_fixup_doc(doq, XMQ_FIXUP_HTML, 0);
 }
 
 char *depths_[64] = {};
@@ -3790,9 +4367,18 @@ const char *xml_element_type_to_string(xmlElementType type)
     return "?";
 }
 
-void fixup_comments(XMQDoc *doq, xmlNode *node, int depth)
+/**
+    fixup_comments_visit:
+    @walk: The fixup traversal.
+    @node: The visited node, updated if it was replaced.
+
+    Unescape the comments read from xml/html.
+*/
+bool fixup_comments_visit(XMQFixupWalk *walk, xmlNode **node_ptr)
 {
-    debug("xmq=", "fixup comments %s|%s %s", indent_depth(depth), node->name, xml_element_type_to_string(node->type));
+    xmlNode *node = *node_ptr;
+
+    debug("xmq=", "fixup comments %s|%s %s", indent_depth(walk->depth), node->name, xml_element_type_to_string(node->type));
     if (node->type == XML_COMMENT_NODE)
     {
         // An xml comment containing dle escapes for example: -␐-␐- is replaceed with ---.
@@ -3815,33 +4401,78 @@ void fixup_comments(XMQDoc *doq, xmlNode *node, int depth)
             xmlReplaceNode(node, new_node);
             xmlFreeNode(node);
             free(content_needed_escaping);
+            *node_ptr = new_node;
         }
-        return;
+        return false;
     }
 
     // Do not recurse into these
-    if (node->type == XML_ENTITY_DECL) return;
+    if (node->type == XML_ENTITY_DECL) return false;
 
-    xmlNode *i = xml_first_child(node);
-    while (i)
+    return true;
+}
+
+// The fixup visitors in the same order as the XMQFixup bits.
+XMQFixupVisit fixup_visits_[] = { fixup_comments_visit, fixup_trim_visit, fixup_html_visit, fixup_json_visit };
+
+/**
+    fixup_walk_node:
+    @walk: The fixup traversal.
+    @node: The node to fix up, together with its children.
+    @fixups: The fixups (XMQFixup bits) to apply to the node.
+
+    Apply the fixups to the node, then visit the children with the fixups that asked for it.
+    The result is the same as running each fixup as a separate pass over the dom,
+    since every fixup only depends on the node itself and its ancestors.
+*/
+void fixup_walk_node(XMQFixupWalk *walk, xmlNode *node, int fixups)
+{
+    bool inside_cdata_declared = walk->inside_cdata_declared;
+    int children_fixups = 0;
+
+    for (int f = 0; node && f < (int)(sizeof(fixup_visits_)/sizeof(fixup_visits_[0])); ++f)
     {
-        xmlNode *next = xml_next_sibling(i); // i might be freed in trim.
-        fixup_comments(doq, i, depth+1);
-        i = next;
+        int fixup = 1 << f;
+        if ((fixups & fixup) && fixup_visits_[f](walk, &node)) children_fixups |= fixup;
     }
+
+    if (node && children_fixups)
+    {
+        walk->depth++;
+        xmlNode *i = xml_first_child(node);
+        while (i)
+        {
+            xmlNode *next = xml_next_sibling(i); // i might be freed by a fixup.
+            fixup_walk_node(walk, i, children_fixups);
+            i = next;
+        }
+        walk->depth--;
+    }
+
+    walk->inside_cdata_declared = inside_cdata_declared;
 }
 
-void xmq_fixup_comments_after_readin(XMQDoc *doq)
+/**
+    xmq_fixup_doc:
+    @doq: The document to fix up.
+    @fixups: The fixups (XMQFixup bits) to apply.
+    @flags: The trim flags used by XMQ_FIXUP_TRIM.
+
+    Apply all the fixups in a single traversal of the document.
+*/
+void xmq_fixup_doc(XMQDoc *doq, int fixups, int flags)
 {
-    xmlNodePtr i = doq->docptr_.xml->children;
-    if (!doq || !i) return;
+    if (!doq || !doq->docptr_.xml || !fixups) return;
 
-    debug("xmq=", "fixup comments after readin");
+    XMQFixupWalk walk = {};
+    walk.doq = doq;
+    walk.flags = flags;
 
+    xmlNode *i = doq->docptr_.xml->children;
     while (i)
     {
-        xmlNode *next = xml_next_sibling(i); // i might be freed in fixup_comments.
-        fixup_comments(doq, i, 0);
+        xmlNode *next = xml_next_sibling(i); // i might be freed by a fixup.
+        fixup_walk_node(&walk, i, fixups);
         i = next;
     }
 }
@@ -4399,8 +5030,6 @@ bool xmq_parse_buffer_xml(XMQDoc *doq, const char *start, const char *stop, int
 
     doq->docptr_.xml = doc;
 
-    xmq_fixup_comments_after_readin(doq);
-
     return true;
 }
 
@@ -4447,8 +5076,6 @@ bool xmq_parse_buffer_html(XMQDoc *doq, const char *start, const char *stop, int
     }
     doq->docptr_.html = doc;
 
-    xmq_fixup_comments_after_readin(doq);
-
     return true;
 }
 
@@ -4556,7 +5183,7 @@ bool xmqParseBufferWithType(XMQDoc *doq,
     case XMQ_CONTENT_HTMQ: ok = xmqParseBuffer(doq, start, stop, implicit_root, flags); break;
     case XMQ_CONTENT_XML: ok = xmq_parse_buffer_xml(doq, start, stop, flags); break;
     case XMQ_CONTENT_HTML: ok = xmq_parse_buffer_html(doq, start, stop, flags); break;
-    case XMQ_CONTENT_JSON: ok = xmq_parse_buffer_json(doq, start, stop, implicit_root); break;
+    case XMQ_CONTENT_JSON: ok = xmq_parse_buffer_json(doq, start, stop, implicit_root, flags); break;
     case XMQ_CONTENT_IXML: ok = xmq_parse_buffer_ixml(doq, start, stop, flags); break;
     case XMQ_CONTENT_TEXT: ok = xmq_parse_buffer_text(doq, start, stop, implicit_root); break;
     case XMQ_CONTENT_CLINES: ok = xmq_parse_buffer_clines(doq, start, stop); break;
@@ -4579,7 +5206,13 @@ exit:
             should_trim = true;
         }
 
-        if (should_trim) xmqTrimWhitespace(doq, flags);
+        int fixups = 0;
+        // Comments read from xml/html are unescaped.
+        if (ct == XMQ_CONTENT_XML || ct == XMQ_CONTENT_HTML) fixups |= XMQ_FIXUP_COMMENTS;
+        if (should_trim) fixups |= XMQ_FIXUP_TRIM;
+
+        // All fixups after reading are done in a single traversal.
+        xmq_fixup_doc(doq, fixups, flags);
     }
 
     return ok;
@@ -4646,7 +5279,8 @@ xmlDtdPtr parse_doctype_raw(XMQDoc *doq, const char *start, const char *stop)
 bool xmq_parse_buffer_json(XMQDoc *doq,
                            const char *start,
                            const char *stop,
-                           const char *implicit_root)
+                           const char *implicit_root,
+                           int flags)
 {
     bool rc = true;
     XMQOutputSettings *os = xmqNewOutputSettings();
@@ -4656,6 +5290,7 @@ bool xmq_parse_buffer_json(XMQDoc *doq,
 
     XMQParseState *state = xmqNewParseState(parse, os);
     state->no_trim_quotes = true;
+    state->json_use_index = (flags & XMQ_FLAG_JSON_INDEX) != 0;
     state->doq = doq;
     xmqSetStateSourceName(state, doq->source_name_);
 
@@ -4685,6 +5320,112 @@ bool xmq_parse_buffer_json(XMQDoc *doq,
     return rc;
 }
 
+XMQJsonLines *xmqNewJsonLines(const char *start, const char *stop, const char *implicit_root)
+{
+    if (!stop) stop = start+strlen(start);
+
+    XMQJsonLines *jl = (XMQJsonLines*)malloc(sizeof(XMQJsonLines));
+    memset(jl, 0, sizeof(XMQJsonLines));
+
+    start = skip_any_potential_bom(start, stop);
+    jl->i = start ? start : stop;
+    jl->stop = stop;
+    jl->line = 1;
+    if (implicit_root != NULL && implicit_root[0] == 0) implicit_root = NULL;
+    jl->implicit_root = implicit_root;
+
+    jl->output_settings = xmqNewOutputSettings();
+    jl->callbacks = xmqNewParseCallbacks();
+    xmq_setup_parse_callbacks(jl->callbacks);
+    jl->state = xmqNewParseState(jl->callbacks, jl->output_settings);
+
+    return jl;
+}
+
+/**
+    reset_json_lines_state:
+    @jl: The json lines reader.
+    @doq: The document to which the next record is added.
+
+    Clear the parse state left behind by the previous record, but keep
+    the allocated element stack and the source name.
+*/
+void reset_json_lines_state(XMQJsonLines *jl, XMQDoc *doq)
+{
+    XMQParseState *state = jl->state;
+
+    free(state->generated_error_msg);
+    if (state->generating_error_msg) free_membuffer_and_free_content(state->generating_error_msg);
+
+    Stack *element_stack = state->element_stack;
+    while (element_stack->size > 0) stack_pop(element_stack);
+    char *source_name = state->source_name;
+    XMQJsonKeyCache json_keys = state->json_keys;
+
+    memset(state, 0, sizeof(XMQParseState));
+    state->parse = jl->callbacks;
+    state->output_settings = jl->output_settings;
+    state->magic_cookie = MAGIC_COOKIE;
+    state->element_stack = element_stack;
+    state->source_name = source_name;
+    state->json_keys = json_keys;
+    state->no_trim_quotes = true;
+    state->implicit_root = jl->implicit_root;
+    state->doq = doq;
+
+    if (!state->source_name) xmqSetStateSourceName(state, doq->source_name_);
+    stack_push(state->element_stack, doq->docptr_.xml);
+}
+
+bool xmqNextJsonLine(XMQJsonLines *jl, XMQDoc *doq)
+{
+    while (jl->i < jl->stop)
+    {
+        const char *start = jl->i;
+        const char *eol = (const char*)memchr(start, '\n', jl->stop-start);
+        if (!eol) eol = jl->stop;
+        size_t line = jl->line;
+
+        jl->i = eol < jl->stop ? eol+1 : eol;
+        jl->line++;
+
+        const char *j = start;
+        while (j < eol && is_xml_whitespace(*j)) j++;
+        if (j == eol) continue; // Skip empty lines.
+
+        if (!json_record_is_complete(start, eol))
+        {
+            doq->errno_ = XMQ_ERROR_BODY_NOT_CLOSED;
+            doq->error_ = build_error_message("xmq: incomplete JSON record on line %zu\n", line);
+            return false;
+        }
+
+        reset_json_lines_state(jl, doq);
+        doq->original_content_type_ = XMQ_CONTENT_JSON;
+        doq->original_size_ = eol-start;
+
+        if (!xmq_tokenize_json_record(jl->state, start, eol, line))
+        {
+            doq->errno_ = xmqStateErrno(jl->state);
+            doq->error_ = build_error_message("%s\n", xmqStateErrorMsg(jl->state));
+            return false;
+        }
+        return true;
+    }
+
+    return false;
+}
+
+void xmqFreeJsonLines(XMQJsonLines *jl)
+{
+    if (!jl) return;
+
+    xmqFreeParseState(jl->state);
+    xmqFreeParseCallbacks(jl->callbacks);
+    xmqFreeOutputSettings(jl->output_settings);
+    free(jl);
+}
+
 bool xmq_parse_buffer_ixml(XMQDoc *ixml_grammar,
                            const char *start,
                            const char *stop,
@@ -4713,15 +5454,27 @@ bool xmq_parse_buffer_ixml(XMQDoc *ixml_grammar,
     if (xmqDebugging()) run->debug = run->verbose = true;
     if (xmqTracing()) run->trace = run->debug = run->verbose = true;
 
-    // Lets parse the ixml source to construct a yaep grammar.
-    // This yaep grammar is cached in ixml_grammar->yaep_grammar_.
-    ixml_build_yaep_grammar((YaepParseRun*)ixml_grammar->yaep_parse_run_,
-                            (YaepGrammar*)ixml_grammar->yaep_grammar_,
-                            state,
-                            start,
-                            stop,
-                            NULL,
-                            NULL);
+    if (is_ixml_compiled_grammar(start, stop))
+    {
+        // A compiled grammar skips the parsing of the ixml source.
+        ixml_read_compiled_grammar((YaepParseRun*)ixml_grammar->yaep_parse_run_,
+                                   (YaepGrammar*)ixml_grammar->yaep_grammar_,
+                                   state,
+                                   start,
+                                   stop);
+    }
+    else
+    {
+        // Lets parse the ixml source to construct a yaep grammar.
+        // This yaep grammar is cached in ixml_grammar->yaep_grammar_.
+        ixml_build_yaep_grammar((YaepParseRun*)ixml_grammar->yaep_parse_run_,
+                                (YaepGrammar*)ixml_grammar->yaep_grammar_,
+                                state,
+                                start,
+                                stop,
+                                NULL,
+                                NULL);
+    }
 
     if (xmqStateErrno(state))
     {
@@ -4738,6 +5491,20 @@ bool xmq_parse_buffer_ixml(XMQDoc *ixml_grammar,
     return rc;
 }
 
+bool xmqSerializeIXMLGrammar(XMQDoc *ixml_grammar, char **out_start, char **out_stop)
+{
+    XMQParseState *state = xmq_get_xmq_parse_state(ixml_grammar);
+    if (!state || !state->ixml_rules || xmqStateErrno(state)) return false;
+
+    MemBuffer *mb = new_membuffer();
+    ixml_write_compiled_grammar(state, mb);
+    size_t len = mb->used_;
+    *out_start = free_membuffer_but_return_trimmed_content(mb);
+    *out_stop = *out_start+len;
+
+    return true;
+}
+
 void xmq_set_yaep_grammar(XMQDoc *doc, YaepGrammar *g)
 {
     doc->yaep_grammar_ = g;
@@ -4843,9 +5610,166 @@ const char *node_yaep_type_to_string(YaepTreeNodeType t)
     return "?";
 }
 
-void collect_text(YaepTreeNode *n, MemBuffer *mb);
+/**
+    YaepDomFrame:
+    @kind: Generate the DOM for @n, collect the text of @n or set the collected attribute.
+    @n: The yaep tree node to visit.
+    @parent: The yaep tree node containing @n.
+    @node: The xml node receiving the generated content, or the element receiving the attribute.
+    @name: The name of the attribute to set.
+    @depth: The depth of @n in the yaep tree.
+
+    The pending work when building a DOM from a yaep tree. The frames live on an explicit stack
+    so that deep parse trees do not overflow the C stack.
+*/
+enum YaepDomFrameKind
+{
+    YAEP_DOM_GENERATE,
+    YAEP_DOM_COLLECT,
+    YAEP_DOM_SET_ATTRIBUTE
+};
+typedef enum YaepDomFrameKind YaepDomFrameKind;
+
+struct YaepDomFrame
+{
+    YaepDomFrameKind kind;
+    YaepTreeNode *n;
+    YaepTreeNode *parent;
+    xmlNodePtr node;
+    const char *name;
+    int depth;
+};
+typedef struct YaepDomFrame YaepDomFrame;
+
+/**
+    YaepDomBuild:
+    @doc: The document being generated.
+    @frames: Stack of pending frames.
+    @num_frames: Number of pending frames.
+    @max_frames: Allocated size of frames.
+    @text: Text run not yet added to @text_parent.
+    @text_parent: The xml node that will receive the text run.
+    @attr: The text collected for the attribute being built.
+
+    Adjacent terminals are coalesced into a single text node instead of adding one text node
+    per character, which libxml2 would then concatenate one character at a time.
+*/
+struct YaepDomBuild
+{
+    xmlDocPtr doc;
+    YaepDomFrame *frames;
+    size_t num_frames;
+    size_t max_frames;
+    MemBuffer *text;
+    xmlNodePtr text_parent;
+    MemBuffer *attr;
+};
+typedef struct YaepDomBuild YaepDomBuild;
+
+YaepDomFrame *push_yaep_dom_frames(YaepDomBuild *b, size_t num);
+void push_yaep_dom_children(YaepDomBuild *b, YaepDomFrameKind kind, YaepTreeNode *n, xmlNodePtr node, int depth);
+void push_yaep_dom_alts(YaepDomBuild *b, YaepTreeNode *n, xmlNodePtr node, int depth);
+void add_yaep_dom_node(YaepDomBuild *b, xmlNodePtr node, xmlNodePtr new_node);
+void add_yaep_dom_text(YaepDomBuild *b, xmlNodePtr node, const char *text);
+void flush_yaep_dom_text(YaepDomBuild *b);
+void collect_yaep_dom_text(YaepDomBuild *b, YaepTreeNode *n, int depth);
+void generate_yaep_dom_frame(YaepDomBuild *b, YaepDomFrame *f);
+
+YaepDomFrame *push_yaep_dom_frames(YaepDomBuild *b, size_t num)
+{
+    if (b->num_frames + num > b->max_frames)
+    {
+        while (b->num_frames + num > b->max_frames)
+        {
+            b->max_frames = b->max_frames ? b->max_frames*2 : 64;
+        }
+        b->frames = (YaepDomFrame*)realloc(b->frames, b->max_frames*sizeof(YaepDomFrame));
+    }
+    YaepDomFrame *frames = b->frames + b->num_frames;
+    b->num_frames += num;
+    return frames;
+}
+
+void push_yaep_dom_children(YaepDomBuild *b, YaepDomFrameKind kind, YaepTreeNode *n, xmlNodePtr node, int depth)
+{
+    YaepTreeNode **children = n->val.anode.children;
+    size_t num = 0;
+    while (children[num] != NULL) num++;
+
+    // Push the children in reverse, the first child is popped first.
+    YaepDomFrame *frames = push_yaep_dom_frames(b, num);
+    for (size_t i = 0; i < num; ++i)
+    {
+        YaepDomFrame *f = &frames[num-1-i];
+        f->kind = kind;
+        f->n = children[i];
+        f->parent = n;
+        f->node = node;
+        f->name = NULL;
+        f->depth = depth+1;
+    }
+}
+
+void push_yaep_dom_alts(YaepDomBuild *b, YaepTreeNode *n, xmlNodePtr node, int depth)
+{
+    size_t num = 1;
+    for (YaepTreeNode *alt = n->val.alt.next; alt && alt->type == YAEP_ALT; alt = alt->val.alt.next) num++;
+
+    YaepDomFrame *frames = push_yaep_dom_frames(b, num);
+    YaepTreeNode *alt = n;
+    for (size_t i = 0; i < num; ++i)
+    {
+        YaepDomFrame *f = &frames[num-1-i];
+        f->kind = YAEP_DOM_GENERATE;
+        f->n = alt->val.alt.node;
+        f->parent = n;
+        f->node = node;
+        f->name = NULL;
+        f->depth = depth+1;
+        alt = alt->val.alt.next;
+    }
+}
+
+void flush_yaep_dom_text(YaepDomBuild *b)
+{
+    if (b->text->used_ == 0) return;
+
+    xmlNodePtr new_node = xmlNewDocTextLen(b->doc, (xmlChar*)b->text->buffer_, b->text->used_);
+    xmlAddChild(b->text_parent, new_node);
+    b->text->used_ = 0;
+}
+
+void add_yaep_dom_node(YaepDomBuild *b, xmlNodePtr node, xmlNodePtr new_node)
+{
+    // Pending text comes before the new node.
+    flush_yaep_dom_text(b);
+
+    if (node == NULL)
+    {
+        xmlDocSetRootElement(b->doc, new_node);
+    }
+    else
+    {
+        xmlAddChild(node, new_node);
+    }
+}
+
+void add_yaep_dom_text(YaepDomBuild *b, xmlNodePtr node, const char *text)
+{
+    if (node == NULL)
+    {
+        add_yaep_dom_node(b, node, xmlNewDocText(b->doc, (xmlChar*)text));
+        return;
+    }
+    if (node != b->text_parent)
+    {
+        flush_yaep_dom_text(b);
+        b->text_parent = node;
+    }
+    membuffer_append(b->text, text);
+}
 
-void collect_text(YaepTreeNode *n, MemBuffer *mb)
+void collect_yaep_dom_text(YaepDomBuild *b, YaepTreeNode *n, int depth)
 {
     if (n == NULL) return;
     if (n->type == YAEP_ANODE)
@@ -4859,23 +5783,18 @@ void collect_text(YaepTreeNode *n, MemBuffer *mb)
             {
                 int value = (int)strtol(an->name+3, NULL, 16);
                 UTF8Char utf8;
-                size_t len = encode_utf8(value, &utf8);
-                utf8.bytes[len] = 0;
-                membuffer_append(mb, utf8.bytes);
+                encode_utf8(value, &utf8);
+                membuffer_append(b->attr, utf8.bytes);
             }
             else
             {
-                membuffer_append(mb, an->name+2);
+                membuffer_append(b->attr, an->name+2);
             }
         }
         else
         {
-            // Normal node, recurse into it.
-            for (int i=0; an->children[i] != NULL; ++i)
-            {
-                YaepTreeNode *nn = an->children[i];
-                collect_text(nn, mb);
-            }
+            // Normal node, collect the text of its children.
+            push_yaep_dom_children(b, YAEP_DOM_COLLECT, n, NULL, depth);
         }
     }
     else
@@ -4885,9 +5804,8 @@ void collect_text(YaepTreeNode *n, MemBuffer *mb)
         if (at->mark != '-')
         {
             UTF8Char utf8;
-            size_t len = encode_utf8(at->code, &utf8);
-            utf8.bytes[len] = 0;
-            membuffer_append(mb, utf8.bytes);
+            encode_utf8(at->code, &utf8);
+            membuffer_append(b->attr, utf8.bytes);
         }
     }
     else
@@ -4896,8 +5814,12 @@ void collect_text(YaepTreeNode *n, MemBuffer *mb)
     }
 }
 
-void generate_dom_from_yaep_node(xmlDocPtr doc, xmlNodePtr node, YaepTreeNode *n, YaepTreeNode *parent, int depth, int index)
+void generate_yaep_dom_frame(YaepDomBuild *b, YaepDomFrame *f)
 {
+    YaepTreeNode *n = f->n;
+    xmlNodePtr node = f->node;
+    int depth = f->depth;
+
     if (n == NULL) return;
     if (n->type == YAEP_TERM && n->val.terminal.code == -1) return;
     if (n->type == YAEP_ANODE)
@@ -4914,72 +5836,45 @@ void generate_dom_from_yaep_node(xmlDocPtr doc, xmlNodePtr node, YaepTreeNode *n
             {
                 // The content to be inserted has been encoded in the rule name.
                 // A hack yes. Does it work? Yes!
-                xmlNodePtr new_node = NULL;
-
-                if(an->name[2] == '/' && an->name[3] == '/')
-                {
-                    new_node = xmlNewDocComment(doc, (xmlChar*)an->name+4);
-                }
                 if(an->name[2] == '#')
                 {
                     int value = (int)strtol(an->name+3, NULL, 16);
                     UTF8Char c;
                     encode_utf8(value, &c);
-                    new_node = xmlNewDocText(doc, (xmlChar*)c.bytes);
-                }
-                else
-                {
-                    new_node = xmlNewDocText(doc, (xmlChar*)an->name+2);
-                }
-                if (node == NULL)
-                {
-                    xmlDocSetRootElement(doc, new_node);
+                    add_yaep_dom_text(b, node, c.bytes);
                 }
                 else
                 {
-                    xmlAddChild(node, new_node);
+                    add_yaep_dom_text(b, node, an->name+2);
                 }
             }
             else if (an->mark != '-')
             {
                 if (an->mark == '@')
                 {
-                    // This should become an attribute.
-                    MemBuffer *mb = new_membuffer();
-                    collect_text(n, mb);
-                    membuffer_append_null(mb);
-                    xmlNewProp(node, (xmlChar*)an->name, (xmlChar*)mb->buffer_);
-                    free_membuffer_and_free_content(mb);
+                    // This should become an attribute. Collect the text of the children
+                    // then set the attribute.
+                    YaepDomFrame *set = push_yaep_dom_frames(b, 1);
+                    set->kind = YAEP_DOM_SET_ATTRIBUTE;
+                    set->n = n;
+                    set->parent = f->parent;
+                    set->node = node;
+                    set->name = an->name;
+                    set->depth = depth;
+                    push_yaep_dom_children(b, YAEP_DOM_COLLECT, n, NULL, depth);
                 }
                 else
                 {
                     // Normal node that should be generated.
-                    xmlNodePtr new_node = xmlNewDocNode(doc, NULL, (xmlChar*)an->name, NULL);
-
-                    if (node == NULL)
-                    {
-                        xmlDocSetRootElement(doc, new_node);
-                    }
-                    else
-                    {
-                        xmlAddChild(node, new_node);
-                    }
-
-                    for (int i=0; an->children[i] != NULL; ++i)
-                    {
-                        YaepTreeNode *nn = an->children[i];
-                        generate_dom_from_yaep_node(doc, new_node, nn, n, depth+1, i);
-                    }
+                    xmlNodePtr new_node = xmlNewDocNode(b->doc, NULL, (xmlChar*)an->name, NULL);
+                    add_yaep_dom_node(b, node, new_node);
+                    push_yaep_dom_children(b, YAEP_DOM_GENERATE, n, new_node, depth);
                 }
             }
             else
             {
                 // Skip anonymous node whose name starts with / and deleted nodes with mark=-
-                for (int i=0; an->children[i] != NULL; ++i)
-                {
-                    YaepTreeNode *nn = an->children[i];
-                    generate_dom_from_yaep_node(doc, node, nn, n, depth+1, i);
-                }
+                push_yaep_dom_children(b, YAEP_DOM_GENERATE, n, node, depth);
             }
         }
     }
@@ -4988,20 +5883,20 @@ void generate_dom_from_yaep_node(xmlDocPtr doc, xmlNodePtr node, YaepTreeNode *n
         xmlNodePtr new_node = NULL;
         if (node == NULL)
         {
-            new_node = xmlNewDocNode(doc, NULL, (xmlChar*)"AMBIGUOUS", NULL);
-            assert(xmlDocGetRootElement(doc) == NULL);
-            xmlDocSetRootElement(doc, new_node);
+            new_node = xmlNewDocNode(b->doc, NULL, (xmlChar*)"AMBIGUOUS", NULL);
+            assert(xmlDocGetRootElement(b->doc) == NULL);
+            add_yaep_dom_node(b, node, new_node);
         }
         else
         {
             YaepAbstractNode *an = NULL;
 
-            if (parent) an = &parent->val.anode;
+            if (f->parent) an = &f->parent->val.anode;
 
             if (!an || an->mark != '*')
             {
-                new_node = xmlNewDocNode(doc, NULL, (xmlChar*)"AMBIGUOUS", NULL);
-                xmlAddChild(node, new_node);
+                new_node = xmlNewDocNode(b->doc, NULL, (xmlChar*)"AMBIGUOUS", NULL);
+                add_yaep_dom_node(b, node, new_node);
             }
             else
             {
@@ -5009,17 +5904,7 @@ void generate_dom_from_yaep_node(xmlDocPtr doc, xmlNodePtr node, YaepTreeNode *n
             }
         }
 
-        YaepTreeNode *alt = n;
-
-        generate_dom_from_yaep_node(doc, new_node, alt->val.alt.node, n, depth+1, 0);
-
-        alt = alt->val.alt.next;
-
-        while (alt && alt->type == YAEP_ALT)
-        {
-            generate_dom_from_yaep_node(doc, new_node, alt->val.alt.node, n, depth+1, 0);
-            alt = alt->val.alt.next;
-        }
+        push_yaep_dom_alts(b, n, new_node, depth);
     }
     else
     if (n->type == YAEP_TERM)
@@ -5028,29 +5913,60 @@ void generate_dom_from_yaep_node(xmlDocPtr doc, xmlNodePtr node, YaepTreeNode *n
         if (at->mark != '-')
         {
             UTF8Char utf8;
-            size_t len = encode_utf8(at->code, &utf8);
-            utf8.bytes[len] = 0;
-
-            xmlNodePtr new_node = xmlNewDocText(doc, (xmlChar*)utf8.bytes);
-
-            if (node == NULL)
-            {
-                xmlDocSetRootElement(doc, new_node);
-            }
-            else
-            {
-                xmlAddChild(node, new_node);
-            }
+            encode_utf8(at->code, &utf8);
+            add_yaep_dom_text(b, node, utf8.bytes);
         }
     }
     else
     {
         for (int i=0; i<depth; ++i) printf("    ");
-        printf("[%d] ", index);
         printf("WOOT %s\n", node_yaep_type_to_string(n->type));
     }
 }
 
+void generate_dom_from_yaep_node(xmlDocPtr doc, xmlNodePtr node, YaepTreeNode *n)
+{
+    YaepDomBuild b = {};
+    b.doc = doc;
+    b.text = new_membuffer();
+    b.attr = new_membuffer();
+
+    YaepDomFrame *root = push_yaep_dom_frames(&b, 1);
+    root->kind = YAEP_DOM_GENERATE;
+    root->n = n;
+    root->parent = NULL;
+    root->node = node;
+    root->name = NULL;
+    root->depth = 0;
+
+    while (b.num_frames > 0)
+    {
+        // Copy the frame, handling it may push new frames and move the stack.
+        YaepDomFrame f = b.frames[--b.num_frames];
+
+        switch (f.kind)
+        {
+        case YAEP_DOM_GENERATE:
+            generate_yaep_dom_frame(&b, &f);
+            break;
+        case YAEP_DOM_COLLECT:
+            collect_yaep_dom_text(&b, f.n, f.depth);
+            break;
+        case YAEP_DOM_SET_ATTRIBUTE:
+            membuffer_append_null(b.attr);
+            xmlNewProp(f.node, (xmlChar*)f.name, (xmlChar*)b.attr->buffer_);
+            b.attr->used_ = 0;
+            break;
+        }
+    }
+
+    flush_yaep_dom_text(&b);
+
+    free(b.frames);
+    free_membuffer_and_free_content(b.text);
+    free_membuffer_and_free_content(b.attr);
+}
+
 bool xmqParseBufferWithIXML(XMQDoc *doc, const char *start, const char *stop, XMQDoc *ixml_grammar, int flags)
 {
     bool ok = false;
@@ -5061,26 +5977,46 @@ bool xmqParseBufferWithIXML(XMQDoc *doc, const char *start, const char *stop, XM
     XMQParseState *state = xmq_get_xmq_parse_state(ixml_grammar);
 
     // Now add all character terminals in the content (not yet added) to the grammar.
-    // And rewrite charsets into rules with multiple choice shrunk to the actual usage of characters in the input.
+    // The charsets are class terminals in the yaep grammar that match these terminals.
     scan_content_fixup_charsets(state, start, stop);
 
     ixml_print_grammar(state);
 
-    state->yaep_i_ = hashmap_iterate(state->ixml_terminals_map);
-    state->yaep_j_ = 0;
-    int rc = yaep_read_grammar(xmq_get_yaep_parse_run(ixml_grammar),
-                               xmq_get_yaep_grammar(ixml_grammar),
-                               0,
-                               ixml_to_yaep_read_terminal,
-                               ixml_to_yaep_read_rule);
-    hashmap_free_iterator(state->yaep_i_);
+    // The yaep grammar only changes when the content introduced new terminals.
+    // E.g. with --lines most lines use characters already seen, then skip the expensive
+    // recompilation (first/follow sets, empty/access derivations, dotted rules).
+    size_t num_terminals = hashmap_size(state->ixml_terminals_map);
+    size_t num_rules = state->ixml_rules->size;
+
+    if (!state->yaep_grammar_compiled_ ||
+        num_terminals != state->yaep_compiled_terminals_ ||
+        num_rules != state->yaep_compiled_rules_)
+    {
+        state->yaep_i_ = hashmap_iterate(state->ixml_terminals_map);
+        state->yaep_j_ = 0;
+        state->yaep_k_ = 0;
+        int rc = yaep_read_grammar(xmq_get_yaep_parse_run(ixml_grammar),
+                                   xmq_get_yaep_grammar(ixml_grammar),
+                                   0,
+                                   ixml_to_yaep_read_terminal,
+                                   ixml_to_yaep_read_class,
+                                   ixml_to_yaep_read_rule);
+        hashmap_free_iterator(state->yaep_i_);
+
+        if (rc != 0)
+        {
+            state->yaep_grammar_compiled_ = false;
+            // The ixml grammar has already been parsed, there is no error handler to jump to.
+            doc->errno_ = XMQ_ERROR_IXML_SYNTAX_ERROR;
+            doc->error_ = build_error_message("xmq: internal error generating yaep grammar from ixml grammar %s\n",
+                                              yaep_error_message(xmq_get_yaep_grammar(ixml_grammar)));
+            return false;
+        }
 
-    if (rc != 0)
-    {
-        state->error_nr = XMQ_ERROR_IXML_SYNTAX_ERROR;
-        state->error_info = "internal error, yaep did not accept generated yaep grammar";
-        printf("xmq: internal error generating yaep grammar from ixml grammar %s\n", yaep_error_message(xmq_get_yaep_grammar(ixml_grammar)));
-        longjmp(state->error_handler, 1);
+        state->yaep_grammar_compiled_ = true;
+        state->yaep_compiled_terminals_ = num_terminals;
+        state->yaep_compiled_rules_ = num_rules;
+        verbose("xmq=", "compiled yaep grammar with %zu terminals and %zu rules", num_terminals, num_rules);
     }
 
     yaep_set_one_parse_flag(xmq_get_yaep_grammar(ixml_grammar),
@@ -5120,7 +6056,7 @@ bool xmqParseBufferWithIXML(XMQDoc *doc, const char *start, const char *stop, XM
     run->syntax_error = handle_yaep_syntax_error;
 
     // Parse source content using the yaep grammar, previously generated from the ixml source.
-    rc = yaepParse(run, grammar);
+    int rc = yaepParse(run, grammar);
 
     if (rc)
     {
@@ -5147,7 +6083,7 @@ bool xmqParseBufferWithIXML(XMQDoc *doc, const char *start, const char *stop, XM
     else
     {
         // IXML parse was fine, generate a DOM from the yaep tree.
-        generate_dom_from_yaep_node(doc->docptr_.xml, NULL, run->root, NULL, 0, 0);
+        generate_dom_from_yaep_node(doc->docptr_.xml, NULL, run->root);
         ok = true;
     }
 
@@ -5167,15 +6103,41 @@ bool xmqParseBufferWithIXML(XMQDoc *doc, const char *start, const char *stop, XM
         xmlSetProp(element, (xmlChar*)"state", (xmlChar*)"ambiguous");
     }
 
-    if (run->root)
-    {
-        yaepFreeTree(run->root, NULL, NULL);
-        run->root = NULL;
-    }
+    yaepFreeParseTree(run);
 
     return ok;
 }
 
+bool xmqGetIXMLParseStats(XMQDoc *ixml_grammar, XMQIXMLParseStats *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+
+    YaepParseRun *run = ixml_grammar ? xmq_get_yaep_parse_run(ixml_grammar) : NULL;
+    if (!run || run->stats.input_len == 0) return false;
+
+    YaepParseStats *ys = &run->stats;
+    stats->input_len = ys->input_len;
+    stats->num_state_sets = ys->num_state_sets;
+    stats->num_set_cores = ys->num_set_cores;
+    stats->num_dotted_rules = ys->num_dotted_rules;
+    stats->num_unique_dotted_rules = ys->num_unique_dotted_rules;
+    stats->num_set_lookups = ys->num_set_lookups;
+    stats->num_set_hits = ys->num_set_hits;
+    stats->num_goto_lookups = ys->num_goto_lookups;
+    stats->num_goto_hits = ys->num_goto_hits;
+    stats->num_leo_steps = ys->num_leo_steps;
+    stats->table_searches = ys->table_searches;
+    stats->table_collisions = ys->table_collisions;
+    stats->memusage = ys->memusage;
+    stats->num_term_nodes = ys->num_term_nodes;
+    stats->num_abstract_nodes = ys->num_abstract_nodes;
+    stats->num_alt_nodes = ys->num_alt_nodes;
+    stats->parse_seconds = ys->parse_seconds;
+    stats->tree_seconds = ys->tree_seconds;
+
+    return true;
+}
+
 bool xmqParseFileWithIXML(XMQDoc *doc, const char *file_name, XMQDoc *ixml_grammar, int flags)
 {
     const char *buffer;
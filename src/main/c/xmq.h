@@ -138,6 +138,7 @@ typedef enum
     @XMQ_FLAG_IXML_ALL_PARSES: When ixml parse is ambiguous generate all parses.
     @XMQ_FLAG_IXML_TRY_TO_RECOVER: When ixml parse fails, try to recover.
     @XMQ_FLAG_IXML_FAIL_SILENT: If the ixml parse fails generate an empty document and no errors.
+    @XMQ_FLAG_JSON_INDEX: Index the json structure before parsing, the parser then jumps over whitespace and plain strings.
 
     If a 0 is provided as the flags to the parse functions, then it will parse using the these default settings:
     When loading xml/html:
@@ -163,6 +164,7 @@ typedef enum
     XMQ_FLAG_IXML_ALL_PARSES = 16,
     XMQ_FLAG_IXML_TRY_TO_RECOVER = 32,
     XMQ_FLAG_IXML_FAIL_SILENT = 64,
+    XMQ_FLAG_JSON_INDEX = 128,
 } XMQFlagBits;
 
 /**
@@ -719,6 +721,8 @@ void xmqSetPreferDoubleQuotes(XMQOutputSettings *os, bool prefer_double_quotes);
 void xmqSetEscapeNewlines(XMQOutputSettings *os, bool escape_newlines);
 void xmqSetEscapeNon7bit(XMQOutputSettings *os, bool escape_non_7bit);
 void xmqSetEscapeTabs(XMQOutputSettings *os, bool escape_tabs);
+void xmqSetJsonLines(XMQOutputSettings *os, bool json_lines);
+void xmqSetPrintThreads(XMQOutputSettings *os, int num_threads);
 void xmqSetOutputFormat(XMQOutputSettings *os, XMQContentType output_format);
 void xmqSetOmitDecl(XMQOutputSettings *os, bool omit_decl);
 void xmqSetRenderFormat(XMQOutputSettings *os, XMQRenderFormat render_to);
@@ -746,6 +750,28 @@ void xmqSetupPrintSkip(XMQOutputSettings *ps, size_t *skip);
 /** Pretty print the document according to the settings. */
 void xmqPrint(XMQDoc *doc, XMQOutputSettings *settings);
 
+/**
+    xmqTranscodeBuffer:
+    @start: start of buffer to convert
+    @stop: points to byte after last byte in buffer, if NULL then start is null terminated
+    @ct: the content type of the buffer, or XMQ_CONTENT_DETECT
+    @flags: the parse flags, the same as for xmqParseBufferWithType
+    @settings: the output settings, the same as for xmqPrint
+
+    Convert the buffer directly into the output format without building a document.
+    The output is identical to parsing the buffer and printing it with xmqPrint.
+    Currently json can be converted into compact uncoloured xmq and xml can be
+    converted into xmq, while only keeping the currently open elements in memory.
+    Xml leaf siblings, like a run of key=value, are held until the run ends, thus
+    a flat xml document with only leaves below the root is held entirely in memory.
+    Returns false if the conversion needs a document, then nothing has been written
+    and the buffer should be parsed and printed as usual. When printing to memory
+    (xmqSetupPrintMemory) the output is printed straight into the memory buffer.
+    For any other writer the whole output is first collected in memory and given
+    to the writer when the conversion has succeeded, thus the output is not bounded.
+*/
+bool xmqTranscodeBuffer(const char *start, const char *stop, XMQContentType ct, int flags, XMQOutputSettings *settings);
+
 /** Recurse through the document and add offsets.
     I.e. <root>ABC<a>DEF</a>GHIJ<b>xyz</b></root> wille become
          <root o="0">ABC<a o="3">DEF</a>GHIJ<b o="10">xyz</b></root>
@@ -985,6 +1011,37 @@ bool xmqParseFileWithType(XMQDoc *doc,
                           XMQContentType ct,
                           int flags);
 
+/**
+    XMQJsonLines:
+
+    Reads json lines (ndjson) one record at a time.
+*/
+typedef struct XMQJsonLines XMQJsonLines;
+
+/**
+    xmqNewJsonLines:
+    @start: start of buffer with one json value per line
+    @stop: points to byte after last byte in buffer, if NULL then start is null terminated
+    @implicit_root: the implicit root
+
+    The buffer must be kept alive until the json lines reader is freed.
+*/
+XMQJsonLines *xmqNewJsonLines(const char *start, const char *stop, const char *implicit_root);
+
+/**
+    xmqNextJsonLine:
+    @jl: the json lines reader
+    @doc: a new empty doc to store the next record in
+
+    Parse the next non-empty line into doc. The parse state is reused between records.
+    Returns false when there are no more records, or if the record failed to parse
+    in which case xmqDocErrno(doc) is set.
+*/
+bool xmqNextJsonLine(XMQJsonLines *jl, XMQDoc *doc);
+
+/** Free the json lines reader. */
+void xmqFreeJsonLines(XMQJsonLines *jl);
+
 /**
     xmqParseBufferWithIXML:
 
@@ -996,6 +1053,18 @@ bool xmqParseBufferWithIXML(XMQDoc *doc,
                             XMQDoc *ixml_grammar,
                             int flags);
 
+/**
+    xmqSerializeIXMLGrammar:
+    @ixml_grammar: A doc with an ixml grammar parsed using XMQ_CONTENT_IXML.
+    @out_start: Set to the start of the malloced compiled grammar.
+    @out_stop: Set to the byte after the compiled grammar.
+
+    Store the parsed ixml grammar with its marks, aliases and costs in a compact binary format.
+    The compiled grammar can be parsed with XMQ_CONTENT_IXML instead of the ixml source,
+    which skips parsing the source. Returns false if the doc has no parsed ixml grammar.
+*/
+bool xmqSerializeIXMLGrammar(XMQDoc *ixml_grammar, char **out_start, char **out_stop);
+
 /**
     xmqParseFileWithIXML:
 
@@ -1006,6 +1075,61 @@ bool xmqParseFileWithIXML(XMQDoc *doc,
                           XMQDoc *ixml_grammar,
                           int flags);
 
+/**
+    XMQIXMLParseStats:
+    @input_len: number of tokens parsed, the code points and the end of input.
+    @num_state_sets: number of unique earley state sets built.
+    @num_set_cores: number of unique state set cores built.
+    @num_dotted_rules: number of dotted rules in all unique state sets.
+    @num_unique_dotted_rules: number of unique dotted rules.
+    @num_set_lookups: number of state sets looked up in the set cache.
+    @num_set_hits: number of set lookups that found an existing set.
+    @num_goto_lookups: number of goto lookups (set, terminal, lookahead).
+    @num_goto_hits: number of goto lookups that found a cached set.
+    @num_leo_steps: number of completions taken through Leo chains.
+    @table_searches: number of searches in the hash tables of the parse.
+    @table_collisions: number of collisions in the hash tables of the parse.
+    @memusage: bytes used by the grammar and the parse state at the end of the parse.
+    @num_term_nodes: number of terminal nodes in the parse tree.
+    @num_abstract_nodes: number of abstract nodes in the parse tree.
+    @num_alt_nodes: number of alternative nodes in the parse tree.
+    @parse_seconds: wall clock seconds spent parsing the input.
+    @tree_seconds: wall clock seconds spent building the parse tree.
+
+    The work done by the last parse with an ixml grammar.
+*/
+struct XMQIXMLParseStats
+{
+    int input_len;
+    int num_state_sets;
+    int num_set_cores;
+    int num_dotted_rules;
+    int num_unique_dotted_rules;
+    int num_set_lookups;
+    int num_set_hits;
+    int num_goto_lookups;
+    int num_goto_hits;
+    int num_leo_steps;
+    size_t table_searches;
+    size_t table_collisions;
+    size_t memusage;
+    int num_term_nodes;
+    int num_abstract_nodes;
+    int num_alt_nodes;
+    double parse_seconds;
+    double tree_seconds;
+};
+typedef struct XMQIXMLParseStats XMQIXMLParseStats;
+
+/**
+    xmqGetIXMLParseStats:
+    @ixml_grammar: the ixml grammar passed to xmqParseBufferWithIXML or xmqParseFileWithIXML.
+    @stats: filled in with the statistics of the last parse using this grammar.
+
+    Returns false, and clears stats, if the grammar has not been used for parsing.
+*/
+bool xmqGetIXMLParseStats(XMQDoc *ixml_grammar, XMQIXMLParseStats *stats);
+
 /**
    xmqSetupDefaultColors:
 
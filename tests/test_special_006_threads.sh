@@ -0,0 +1,55 @@
+#!/bin/sh
+# libxmq - Copyright 2026 Fredrik Öhrström (spdx: MIT)
+
+PROG=$1
+OUTPUT=$2
+TEST_NAME=$(basename $1 2> /dev/null)
+TEST_NAME=${TEST_NAME%.*}
+
+if [ -z "$OUTPUT" ] || [ -z "$PROG" ]
+then
+    echo "Usage: tests/test_special....sh [XMQ_BINARY] [OUTPUT_DIR]"
+    exit 1
+fi
+
+mkdir -p $OUTPUT
+
+# Enough siblings to be split into chunks rendered by separate threads,
+# with alignment groups, comments, attributes and repeated keys crossing the chunk borders.
+awk 'BEGIN {
+    print "<root>";
+    for (i = 0; i < 2000; i++) {
+        if (i % 97 == 0) print "<!-- comment " i " -->";
+        if (i % 13 == 0) print "<item id=\"" i "\"><name>n" i "</name><value>it'\''s " i "</value></item>";
+        else if (i % 7 == 0) print "<longer_key_name_" (i % 5) ">" i "</longer_key_name_" (i % 5) ">";
+        else if (i % 11 == 0) print "<text>line one\nline two " i "</text>";
+        else print "<k" (i % 3) ">" i "</k" (i % 3) ">";
+    }
+    print "</root>";
+}' > $OUTPUT/threads.xml
+
+for CMD in "to-xmq" "to-json" "render-html" "render-tex"
+do
+    $PROG $OUTPUT/threads.xml $CMD > $OUTPUT/threads_serial.out
+    $PROG $OUTPUT/threads.xml $CMD --threads=4 > $OUTPUT/threads_parallel.out
+
+    if diff $OUTPUT/threads_serial.out $OUTPUT/threads_parallel.out > /dev/null
+    then
+        echo "OK: test special 006 threads $CMD"
+    else
+        echo "ERROR: test special 006 threads $CMD"
+        echo "Output differ:"
+        diff $OUTPUT/threads_serial.out $OUTPUT/threads_parallel.out | head -20
+        exit 1
+    fi
+done
+
+for THREADS in "" "abc" "0" "3x" "-2"
+do
+    if $PROG $OUTPUT/threads.xml to-xmq --threads=$THREADS > $OUTPUT/threads_bad.out 2> $OUTPUT/threads_bad.err || [ -s $OUTPUT/threads_bad.out ]
+    then
+        echo "ERROR: test special 006 threads should reject --threads=$THREADS"
+        exit 1
+    fi
+done
+echo "OK: test special 006 threads bad values"
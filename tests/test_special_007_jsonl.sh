@@ -0,0 +1,73 @@
+#!/bin/sh
+# libxmq - Copyright 2026 Fredrik Öhrström (spdx: MIT)
+
+PROG=$1
+OUTPUT=$2
+TEST_NAME=$(basename $1 2> /dev/null)
+TEST_NAME=${TEST_NAME%.*}
+
+if [ -z "$OUTPUT" ] || [ -z "$PROG" ]
+then
+    echo "Usage: tests/test_special....sh [XMQ_BINARY] [OUTPUT_DIR]"
+    exit 1
+fi
+
+mkdir -p $OUTPUT
+
+cat <<'EOF' > $OUTPUT/input.json
+[
+  {"name":"Gilbert","score":24,"text":"a\nb"},
+  {"name":"Alexa","score":29},
+  [1,2],
+  "May",
+  null
+]
+EOF
+
+# A json array is split into one record per line, and each record
+# is printed unchanged when the json lines are read back.
+$PROG $OUTPUT/input.json to-jsonl > $OUTPUT/output.jsonl
+$PROG --jsonl $OUTPUT/output.jsonl to-jsonl > $OUTPUT/output.txt
+$PROG --jsonl $OUTPUT/output.jsonl select /_/name to-text >> $OUTPUT/output.txt
+echo >> $OUTPUT/output.txt
+
+cat <<'EOF' > $OUTPUT/expected.txt
+{"name":"Gilbert","score":24,"text":"a\nb"}
+{"name":"Alexa","score":29}
+[1,2]
+"May"
+null
+GilbertAlexa
+EOF
+
+if diff $OUTPUT/output.txt $OUTPUT/expected.txt
+then
+    echo "OK: test special 007 jsonl"
+else
+    echo "ERROR: test special 007 jsonl"
+    echo "Formatting differ:"
+    if [ -n "$USE_MELD" ]
+    then
+        meld $OUTPUT/expected.txt $OUTPUT/output.txt
+    else
+        diff $OUTPUT/expected.txt $OUTPUT/output.txt
+    fi
+    exit 1
+fi
+
+# A record that continues on the next line is incomplete, it must be
+# reported instead of being parsed past the end of the line.
+printf '{"a":1}\n{\n"a":1}\n' > $OUTPUT/incomplete.jsonl
+if $PROG --jsonl $OUTPUT/incomplete.jsonl to-jsonl > $OUTPUT/incomplete.out 2> $OUTPUT/incomplete.err
+then
+    echo "ERROR: test special 007 jsonl incomplete record was accepted"
+    exit 1
+fi
+if grep -q "incomplete JSON record on line 2" $OUTPUT/incomplete.err
+then
+    echo "OK: test special 007 jsonl incomplete record"
+else
+    echo "ERROR: test special 007 jsonl incomplete record"
+    cat $OUTPUT/incomplete.err
+    exit 1
+fi
@@ -0,0 +1,50 @@
+#!/bin/sh
+# libxmq - Copyright 2026 Fredrik Öhrström (spdx: MIT)
+
+PROG=$1
+OUTPUT=$2
+TEST_NAME=$(basename $1 2> /dev/null)
+TEST_NAME=${TEST_NAME%.*}
+
+if [ -z "$OUTPUT" ] || [ -z "$PROG" ]
+then
+    echo "Usage: tests/test_special....sh [XMQ_BINARY] [OUTPUT_DIR]"
+    exit 1
+fi
+
+mkdir -p $OUTPUT
+
+cat <<'EOF' > $OUTPUT/input.xml
+<?xml version="1.0" encoding="utf-8" standalone="yes"?>
+<a><b>x</b></a>
+EOF
+
+cat <<'EOF' > $OUTPUT/input.html
+<html><body><p>x<br>y</p></body></html>
+EOF
+
+# The xml declaration is left out, whatever it would have looked like.
+$PROG $OUTPUT/input.xml to-xml --omit-decl > $OUTPUT/output.txt
+$PROG $OUTPUT/input.html select /html/body to-xml --omit-decl >> $OUTPUT/output.txt
+$PROG $OUTPUT/input.html select /html/body to-html >> $OUTPUT/output.txt
+
+cat <<'EOF' > $OUTPUT/expected.txt
+<a><b>x</b></a>
+<body><p>x<br/>y</p></body>
+<body><p>x<br>y</p></body>
+EOF
+
+if diff $OUTPUT/output.txt $OUTPUT/expected.txt
+then
+    echo "OK: test special 008 omit decl"
+else
+    echo "ERROR: test special 008 omit decl"
+    echo "Formatting differ:"
+    if [ -n "$USE_MELD" ]
+    then
+        meld $OUTPUT/expected.txt $OUTPUT/output.txt
+    else
+        diff $OUTPUT/expected.txt $OUTPUT/output.txt
+    fi
+    exit 1
+fi
@@ -0,0 +1,103 @@
+#!/bin/sh
+# libxmq - Copyright 2026 Fredrik Öhrström (spdx: MIT)
+
+PROG=$1
+OUTPUT=$2
+TEST_NAME=$(basename $1 2> /dev/null)
+TEST_NAME=${TEST_NAME%.*}
+
+if [ -z "$OUTPUT" ] || [ -z "$PROG" ]
+then
+    echo "Usage: tests/test_special....sh [XMQ_BINARY] [OUTPUT_DIR]"
+    exit 1
+fi
+
+mkdir -p $OUTPUT/compiled_ixml
+
+# Parsing with a compiled grammar must give the same result as parsing with the ixml source.
+for GRAMMAR in tests/ixml/correct/*.ixml
+do
+    NAME=$(basename $GRAMMAR .ixml)
+    INPUT=tests/ixml/correct/$NAME.inp
+    if [ ! -f $INPUT ]; then continue; fi
+
+    if ! $PROG --ixml=$GRAMMAR --compile-ixml=$OUTPUT/compiled_ixml/$NAME.ixmlc
+    then
+        echo "ERROR: test special 009 compiled ixml"
+        echo "Could not compile $GRAMMAR"
+        exit 1
+    fi
+
+    $PROG --ixml=$GRAMMAR $INPUT to-xml > $OUTPUT/compiled_ixml/$NAME.expected 2>&1
+    $PROG --ixml=$OUTPUT/compiled_ixml/$NAME.ixmlc $INPUT to-xml > $OUTPUT/compiled_ixml/$NAME.output 2>&1
+
+    if ! diff $OUTPUT/compiled_ixml/$NAME.expected $OUTPUT/compiled_ixml/$NAME.output
+    then
+        echo "ERROR: test special 009 compiled ixml"
+        echo "Parse using compiled $GRAMMAR differ"
+        exit 1
+    fi
+done
+
+# New characters in later lines add charset rules to the compiled grammar as well.
+printf 'BESETTER\nBBBBBBBB\nBEVESSELED\n' > $OUTPUT/compiled_ixml/input.txt
+
+cat <<EOF > $OUTPUT/compiled_ixml/lines.ixml
+-ok = rule_H.
+-consonant = ["BCDGHLMNPRSTVWXY"].
+rule_H: "E"?, (consonant; "N", ["CS"]; ["ST"],["ST"])++"E", "E"?.
+EOF
+
+$PROG --ixml=$OUTPUT/compiled_ixml/lines.ixml --compile-ixml=$OUTPUT/compiled_ixml/lines.ixmlc
+$PROG --lines --ixml-fail-silent $OUTPUT/compiled_ixml/lines.ixml $OUTPUT/compiled_ixml/input.txt > $OUTPUT/compiled_ixml/lines.expected
+$PROG --lines --ixml-fail-silent $OUTPUT/compiled_ixml/lines.ixmlc $OUTPUT/compiled_ixml/input.txt > $OUTPUT/compiled_ixml/lines.output
+
+if ! diff $OUTPUT/compiled_ixml/lines.expected $OUTPUT/compiled_ixml/lines.output
+then
+    echo "ERROR: test special 009 compiled ixml"
+    echo "Parse lines using compiled grammar differ"
+    exit 1
+fi
+
+# A truncated compiled grammar is rejected.
+head -c 64 $OUTPUT/compiled_ixml/lines.ixmlc > $OUTPUT/compiled_ixml/broken.ixmlc
+if $PROG --ixml=$OUTPUT/compiled_ixml/broken.ixmlc $OUTPUT/compiled_ixml/input.txt > /dev/null 2>&1
+then
+    echo "ERROR: test special 009 compiled ixml"
+    echo "Expected failure when using a broken compiled grammar"
+    exit 1
+fi
+
+# A corrupted compiled grammar is rejected. The first terminal code is stored
+# at offset 18 after the magic, the version, the two flags and the number of terminals.
+corrupt()
+{
+    cp $OUTPUT/compiled_ixml/lines.ixmlc $OUTPUT/compiled_ixml/corrupt.ixmlc
+    printf "$2" | dd of=$OUTPUT/compiled_ixml/corrupt.ixmlc bs=1 seek=$1 conv=notrunc 2> /dev/null
+    $PROG --ixml=$OUTPUT/compiled_ixml/corrupt.ixmlc $OUTPUT/compiled_ixml/input.txt > /dev/null 2>&1
+    RC=$?
+    if [ "$RC" != "1" ]
+    then
+        echo "ERROR: test special 009 compiled ixml"
+        echo "Expected exit code 1 when using a compiled grammar corrupted with $3 but got $RC"
+        exit 1
+    fi
+}
+
+corrupt 21 '\377' "a negative terminal code"
+corrupt 20 '\377' "a terminal code beyond 0x10ffff"
+corrupt 18 "$(dd if=$OUTPUT/compiled_ixml/lines.ixmlc bs=1 skip=22 count=1 2> /dev/null)" "a duplicate terminal"
+
+# A grammar that yaep rejects is reported as an error and does not crash.
+printf 'a: a.\n' > $OUTPUT/compiled_ixml/loop.ixml
+$PROG --ixml=$OUTPUT/compiled_ixml/loop.ixml --compile-ixml=$OUTPUT/compiled_ixml/loop.ixmlc
+$PROG --ixml=$OUTPUT/compiled_ixml/loop.ixmlc $OUTPUT/compiled_ixml/input.txt > /dev/null 2>&1
+RC=$?
+if [ "$RC" != "1" ]
+then
+    echo "ERROR: test special 009 compiled ixml"
+    echo "Expected exit code 1 when using a compiled grammar with loops but got $RC"
+    exit 1
+fi
+
+echo "OK: test special 009 compiled ixml"
@@ -0,0 +1,41 @@
+#!/bin/sh
+# libxmq - Copyright 2026 Fredrik Öhrström (spdx: MIT)
+
+PROG=$1
+OUTPUT=$2
+TEST_NAME=$(basename $1 2> /dev/null)
+TEST_NAME=${TEST_NAME%.*}
+
+if [ -z "$OUTPUT" ] || [ -z "$PROG" ]
+then
+    echo "Usage: tests/test_special....sh [XMQ_BINARY] [OUTPUT_DIR]"
+    exit 1
+fi
+
+mkdir -p $OUTPUT/ixml_broken_utf8
+
+cat <<EOF > $OUTPUT/ixml_broken_utf8/word.ixml
+word = ["a"-"z"]*.
+EOF
+
+# The f7 lead byte decodes to a code point beyond 0x10ffff and must be rejected as broken utf8.
+printf 'ab\367\277\277\277c' > $OUTPUT/ixml_broken_utf8/input.txt
+
+$PROG --ixml=$OUTPUT/ixml_broken_utf8/word.ixml $OUTPUT/ixml_broken_utf8/input.txt > $OUTPUT/ixml_broken_utf8/output.txt 2>&1
+RC=$?
+
+if [ "$RC" = "0" ] || [ "$RC" -gt "128" ]
+then
+    echo "ERROR: test special 010 ixml broken utf8"
+    echo "Expected failure with exit code 1 but got $RC"
+    exit 1
+fi
+
+if ! grep -q "broken utf8" $OUTPUT/ixml_broken_utf8/output.txt
+then
+    echo "ERROR: test special 010 ixml broken utf8"
+    echo "Expected broken utf8 error"
+    exit 1
+fi
+
+echo "OK: test special 010 ixml broken utf8"
@@ -0,0 +1,59 @@
+#!/bin/sh
+# libxmq - Copyright 2026 Fredrik Öhrström (spdx: MIT)
+
+PROG=$1
+OUTPUT=$2
+TEST_NAME=$(basename $1 2> /dev/null)
+TEST_NAME=${TEST_NAME%.*}
+
+if [ -z "$OUTPUT" ] || [ -z "$PROG" ]
+then
+    echo "Usage: tests/test_special....sh [XMQ_BINARY] [OUTPUT_DIR]"
+    exit 1
+fi
+
+DIR=$OUTPUT/json_index
+mkdir -p $DIR
+
+# Strings with escapes, raw control characters, utf8 and long runs of plain
+# content, where the index records more than the string start and end.
+printf '{\n\t"k\\"ey": "a\\\\b\\u00e5",\n    "raw": "x\ty",\n    "utf8": "åäö €",\n    "long": "%s",\n    "list": [ 1 , -2.5e3 , true , false , null , "" , {} , [] ]\n}\n' \
+       "$(printf '0123456789abcdef%.0s' 1 2 3 4 5 6 7 8)" > $DIR/strings.json
+
+# A broken document must report the same error position.
+printf '{\n    "a": "b",\n    "c": [1, 2\n' > $DIR/broken.json
+
+for i in tests/parse_json_???_*.test
+do
+    NAME=$(basename $i .test)
+    sed -n '/^INPUT.*$/,/^XMQ$/p' $i | tail -n +2 | sed '$d' > $DIR/$NAME.json
+done
+cp tests/resources/*.json $DIR
+
+# The document parsed with the json index must be the same as without it.
+for i in $DIR/*.json
+do
+    for CMD in to-xml to-json
+    do
+        $PROG --json $i $CMD > $DIR/expected.txt 2>&1
+        RC_EXPECTED=$?
+        $PROG --json --json-index $i $CMD > $DIR/output.txt 2>&1
+        RC=$?
+        if [ "$RC" != "$RC_EXPECTED" ] || ! diff $DIR/expected.txt $DIR/output.txt > /dev/null
+        then
+            echo "ERROR: test special 011 json index $(basename $i) $CMD"
+            diff $DIR/expected.txt $DIR/output.txt
+            exit 1
+        fi
+    done
+done
+
+$PROG --json --json-index $DIR/broken.json to-xml > $DIR/output.txt 2>&1
+if ! grep -q ":3:10: error: body is not closed" $DIR/output.txt
+then
+    echo "ERROR: test special 011 json index broken json"
+    cat $DIR/output.txt
+    exit 1
+fi
+
+echo "OK: test special 011 json index"